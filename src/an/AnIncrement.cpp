@@ -24,6 +24,7 @@
 #include "CliText.h"
 #include "CliTextParm.h"
 #include <sstream>
+#include <string>
 #include "BcSessions.h"
 #include "CliIntParm.h"
 #include "CliThread.h"
@@ -36,6 +37,7 @@
 #include "SysTypes.h"
 
 using namespace CallBase;
+using std::string;
 
 //------------------------------------------------------------------------------
 
@@ -48,6 +50,11 @@ class TrafficRateText : public CliText
 public: TrafficRateText();
 };
 
+class TrafficRampText : public CliText
+{
+public: TrafficRampText();
+};
+
 class TrafficAction : public CliTextParm
 {
 public: TrafficAction();
@@ -79,9 +86,30 @@ TrafficRateText::TrafficRateText() :
 fixed_string TrafficQueryTextStr = "query";
 fixed_string TrafficQueryTextExpl = "displays traffic statistics";
 
+fixed_string RampFirstExpl = "first rate (calls per minute)";
+fixed_string RampLastExpl = "last rate (calls per minute)";
+fixed_string RampStepExpl = "rate increment (calls per minute)";
+fixed_string RampSecsExpl = "seconds to run each rate";
+
+fixed_string TrafficRampTextStr = "ramp";
+fixed_string TrafficRampTextExpl = "reports latencies as call rate increases";
+
+TrafficRampText::TrafficRampText() :
+   CliText(TrafficRampTextExpl, TrafficRampTextStr)
+{
+   BindParm(*new CliIntParm
+      (RampFirstExpl, 1, PotsTrafficThread::MaxCallsPerMin));
+   BindParm(*new CliIntParm
+      (RampLastExpl, 1, PotsTrafficThread::MaxCallsPerMin));
+   BindParm(*new CliIntParm
+      (RampStepExpl, 1, PotsTrafficThread::MaxCallsPerMin));
+   BindParm(*new CliIntParm(RampSecsExpl, 1, 3600));
+}
+
 constexpr id_t TrafficStatesIndex = 1;
 constexpr id_t TrafficRateIndex = 2;
 constexpr id_t TrafficQueryIndex = 3;
+constexpr id_t TrafficRampIndex = 4;
 
 fixed_string TrafficActionExpl = "subcommand...";
 
@@ -92,6 +120,7 @@ TrafficAction::TrafficAction() : CliTextParm(TrafficActionExpl)
    BindText(*new TrafficRateText, TrafficRateIndex);
    BindText(*new CliText
       (TrafficQueryTextExpl, TrafficQueryTextStr), TrafficQueryIndex);
+   BindText(*new TrafficRampText, TrafficRampIndex);
 }
 
 fixed_string TrafficStr = "traffic";
@@ -109,7 +138,7 @@ word TrafficCommand::ProcessCommand(CliThread& cli) const
    Debug::ft(TrafficCommand_ProcessCommand);
 
    id_t index;
-   word rate;
+   word rate, last, step, secs;
 
    if(!GetTextIndex(index, cli)) return -1;
 
@@ -136,6 +165,16 @@ word TrafficCommand::ProcessCommand(CliThread& cli) const
       Singleton<PotsTrafficThread>::Instance()->Query(*cli.obuf);
       break;
 
+   case TrafficRampIndex:
+      if(!GetIntParm(rate, cli)) return -1;
+      if(!GetIntParm(last, cli)) return -1;
+      if(!GetIntParm(step, cli)) return -1;
+      if(!GetIntParm(secs, cli)) return -1;
+      if(!cli.EndOfInput()) return -1;
+      Singleton<PotsTrafficThread>::Instance()->Ramp
+         (*cli.obuf, rate, last, step, secs);
+      break;
+
    default:
       Debug::SwLog(TrafficCommand_ProcessCommand, UnexpectedIndex, index);
       return cli.Report(index, SystemErrorExpl);
@@ -39,7 +39,7 @@ AnModule::AnModule() : Module("an")
 
    //  Create the modules required by AccessNode.
    //
-   Singleton<PbModule>::Instance();
+   Requires(*Singleton<PbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
@@ -22,6 +22,8 @@
 #include "PotsTrafficThread.h"
 #include "Dynamic.h"
 #include <chrono>
+#include <cmath>
+#include <cstdint>
 #include <iomanip>
 #include <ratio>
 #include <sstream>
@@ -32,6 +34,7 @@
 #include "Log.h"
 #include "Memory.h"
 #include "PotsCircuit.h"
+#include "PotsDnIndex.h"
 #include "PotsLogs.h"
 #include "PotsProfile.h"
 #include "PotsProfileRegistry.h"
@@ -42,6 +45,7 @@
 #include "SbPools.h"
 #include "Singleton.h"
 #include "SteadyTime.h"
+#include "ThisThread.h"
 #include "Tones.h"
 
 using namespace MediaBase;
@@ -204,6 +208,16 @@ private:
    SteadyTime::Point termStart_;
    SteadyTime::Point termEnd_;
 
+   //  The time at which the originator finished dialing the DN, until the
+   //  post-dial delay is recorded.
+   //
+   SteadyTime::Point dialed_;
+
+   //  The time at which the terminator answered, until the answer delay
+   //  is recorded.
+   //
+   SteadyTime::Point answered_;
+
    //  The call's state.
    //
    State state_;
@@ -283,6 +297,11 @@ TrafficCallPool::~TrafficCallPool()
 
 //==============================================================================
 
+//> How long an originator can receive silence after dialing a DN before
+//  the call is released and counted as a post-dial delay timeout.
+//
+constexpr uint32_t PddTimeoutMsecs = 30000;
+
 const uint32_t TrafficCall::DelayMsecs_[] = { 2000, 3500, 5000, 7500 };
 int TrafficCall::StateCount_[] = { 0 };
 size_t TrafficCall::CallId_ = 1;
@@ -299,6 +318,8 @@ TrafficCall::TrafficCall(PotsCircuit& orig) :
    term_(nullptr),
    termStart_(SteadyTime::GetInvalid()),
    termEnd_(SteadyTime::GetInvalid()),
+   dialed_(SteadyTime::GetInvalid()),
+   answered_(SteadyTime::GetInvalid()),
    state_(Originating)
 {
    Debug::ft("TrafficCall.ctor");
@@ -524,6 +545,23 @@ uint32_t TrafficCall::ProcessConnected()
 
    if(!CheckTerm()) return 0;
 
+   //  If the terminator answered, record how long it took to connect the
+   //  originator to it.
+   //
+   if(SteadyTime::IsValid(answered_) && (orig_ != nullptr) &&
+      (orig_->RxFrom() == term_->TsPort()))
+   {
+      auto conn = orig_->ConnTime();
+
+      if(conn >= answered_)
+      {
+         auto thr = Singleton<PotsTrafficThread>::Instance();
+         thr->RecordAnswerDelay(conn - answered_);
+      }
+
+      answered_ = SteadyTime::GetInvalid();
+   }
+
    // o Release and decide what to do after 1 second (50%).
    // o Suspend and decide what to do after 1 to 7 seconds (40%).
    // o Release simultaneously (10%).
@@ -592,6 +630,7 @@ uint32_t TrafficCall::ProcessDialing()
 
    msg->AddDigits(ds);
    if(!orig_->SendMsg(*msg)) return 0;
+   dialed_ = SteadyTime::Now();
    SetState(Terminating);
    return 2000;
 }
@@ -724,6 +763,7 @@ uint32_t TrafficCall::ProcessOriginating()
          DigitString ds(dest_);
          msg->AddDigits(ds);
          if(!orig_->SendMsg(*msg)) return 0;
+         dialed_ = SteadyTime::Now();
          SetState(Terminating);
          return 2000;
       }
@@ -784,6 +824,7 @@ uint32_t TrafficCall::ProcessRinging()
    }
 
    if(!term_->SendMsg(PotsSignal::Offhook)) return 0;
+   answered_ = SteadyTime::Now();
    SetState(Connected);
    return rand(1000, 20000);
 }
@@ -857,6 +898,21 @@ uint32_t TrafficCall::ProcessTerminating()
 
    if((port == Tone::Ringback) || (port > Tone::MaxId))
    {
+      //  Record the post-dial delay, which ended when the originator was
+      //  connected to ringback or to the terminator.  This is done before
+      //  checking the terminator's state, because the terminator may have
+      //  answered or released by the time that this check occurs.
+      //
+      auto conn = orig_->ConnTime();
+
+      if(SteadyTime::IsValid(dialed_) && (conn >= dialed_))
+      {
+         auto thr = Singleton<PotsTrafficThread>::Instance();
+         thr->RecordPostDialDelay(conn - dialed_);
+      }
+
+      dialed_ = SteadyTime::GetInvalid();
+
       //  Add the terminator to our call record after verifying that it is,
       //  indeed, a terminator.
       //
@@ -912,13 +968,28 @@ uint32_t TrafficCall::ProcessTerminating()
    {
       //  We're receiving a treatment.  Decide what to do after 2 seconds.
       //
+      dialed_ = SteadyTime::GetInvalid();
       SetState(SingleEnded);
       return 2000;
    }
 
    //  We're still receiving silence, so there must be some post-dial delay.
-   //  Look for ringback again in 2 seconds.
+   //  If it has lasted too long, count a timeout and release the call.
+   //  Otherwise, look for ringback again in 2 seconds.
    //
+   if(SteadyTime::IsValid(dialed_))
+   {
+      auto waited = SteadyTime::Now() - dialed_;
+
+      if(waited >= msecs_t(PddTimeoutMsecs))
+      {
+         Singleton<PotsTrafficThread>::Instance()->RecordPddTimeout();
+         dialed_ = SteadyTime::GetInvalid();
+         ReleaseOrig();
+         return 0;
+      }
+   }
+
    return 2000;
 }
 
@@ -1034,7 +1105,6 @@ const uint32_t PotsTrafficThread::MaxCallsPerMin =
 PotsTrafficThread::PotsTrafficThread() : Thread(LoadTestFaction),
    timeout_(TIMEOUT_NEVER),
    callsPerMin_(0),
-   maxCallsPerTick_(0),
    milCallsPerTick_(0),
    firstDN_(Address::NilDN),
    lastDN_(Address::NilDN),
@@ -1045,6 +1115,7 @@ PotsTrafficThread::PotsTrafficThread() : Thread(LoadTestFaction),
    totalReports_(0),
    overflows_(0),
    aborts_(0),
+   pddTimeouts_(0),
    timewheel_(nullptr)
 {
    Debug::ft("PotsTrafficThread.ctor");
@@ -1058,6 +1129,11 @@ PotsTrafficThread::PotsTrafficThread() : Thread(LoadTestFaction),
       timewheel_[i].Init(TrafficCall::LinkDiff());
    }
 
+   postDialDelays_.reset
+      (new Histogram("traffic post-dial delays in msecs", NS_TO_MS));
+   answerDelays_.reset
+      (new Histogram("traffic answer delays in msecs", NS_TO_MS));
+
    SetInitialized();
 }
 
@@ -1097,6 +1173,40 @@ c_string PotsTrafficThread::AbbrName() const
 
 //------------------------------------------------------------------------------
 
+uint32_t PotsTrafficThread::Arrivals() const
+{
+   Debug::ft("PotsTrafficThread.Arrivals");
+
+   //  Multiply uniform variates until their product falls below exp(-mean).
+   //  The number of variates that did not do so has a Poisson distribution.
+   //  A large mean is split into smaller ones, which keeps exp(-mean) from
+   //  underflowing.
+   //
+   uint32_t count = 0;
+   double remaining = milCallsPerTick_ / 1000.0;
+
+   while(remaining > 0.0)
+   {
+      auto mean = remaining;
+      if(mean > 100.0) mean = 100.0;
+      remaining -= mean;
+
+      auto limit = std::exp(-mean);
+      double product = 1.0;
+
+      while(true)
+      {
+         product *= (rand(1, 1000000) / 1000001.0);
+         if(product < limit) break;
+         ++count;
+      }
+   }
+
+   return count;
+}
+
+//------------------------------------------------------------------------------
+
 void PotsTrafficThread::Destroy()
 {
    Debug::ft("PotsTrafficThread.Destroy");
@@ -1117,7 +1227,6 @@ void PotsTrafficThread::Display(ostream& stream,
    stream << prefix << "MaxCallsPerMin  : " << MaxCallsPerMin << CRLF;
    stream << prefix << "timeout         : " << to_string(timeout_) << CRLF;
    stream << prefix << "callsPerMin     : " << callsPerMin_ << CRLF;
-   stream << prefix << "maxCallsPerTick : " << maxCallsPerTick_ << CRLF;
    stream << prefix << "milCallsPerTick : " << milCallsPerTick_ << CRLF;
    stream << prefix << "firstDN         : " << firstDN_ << CRLF;
    stream << prefix << "lastDN          : " << lastDN_ << CRLF;
@@ -1128,6 +1237,11 @@ void PotsTrafficThread::Display(ostream& stream,
    stream << prefix << "totalReports    : " << totalReports_ << CRLF;
    stream << prefix << "overflows       : " << overflows_ << CRLF;
    stream << prefix << "aborts          : " << aborts_ << CRLF;
+   stream << prefix << "pddTimeouts     : " << pddTimeouts_ << CRLF;
+   stream << prefix << "postDialDelays  : " << CRLF;
+   postDialDelays_->Display(stream, prefix + spaces(2), options);
+   stream << prefix << "answerDelays    : " << CRLF;
+   answerDelays_->Display(stream, prefix + spaces(2), options);
 }
 
 //------------------------------------------------------------------------------
@@ -1231,8 +1345,7 @@ Address::DN PotsTrafficThread::FindDn(DnStatus status) const
 {
    Debug::ft(PotsTrafficThread_FindDn);
 
-   Address::DN dn;
-   auto reg = Singleton<PotsProfileRegistry>::Instance();
+   auto index = Singleton<PotsDnIndex>::Extant();
 
    switch(status)
    {
@@ -1243,27 +1356,11 @@ Address::DN PotsTrafficThread::FindDn(DnStatus status) const
       return rand(firstDN_, lastDN_);
 
    case Idle:
-      dn = rand(firstDN_, lastDN_);
-
-      for(auto n = lastDN_ - firstDN_ + 1; n > 0; --n)
-      {
-         auto prof = reg->Profile(dn);
-         auto cct = prof->GetCircuit();
-         if(cct->GetState() == PotsCircuit::Idle) return dn;
-         dn = (dn == lastDN_ ? firstDN_ : dn + 1);
-      }
+      if(index != nullptr) return index->RandomIdle();
       break;
 
    case Busy:
-      dn = rand(firstDN_, lastDN_);
-
-      for(auto n = lastDN_ - firstDN_ + 1; n > 0; --n)
-      {
-         auto prof = reg->Profile(dn);
-         auto cct = prof->GetCircuit();
-         if(cct->GetState() != PotsCircuit::Idle) return dn;
-         dn = (dn == lastDN_ ? firstDN_ : dn + 1);
-      }
+      if(index != nullptr) return index->RandomBusy();
       break;
 
    default:
@@ -1299,7 +1396,6 @@ void PotsTrafficThread::Query(ostream& stream) const
 
    stream << "Maximum calls per minute     " << MaxCallsPerMin << CRLF;
    stream << "Traffic rate (calls/min)     " << callsPerMin_ << CRLF;
-   stream << "Maximum calls per tick       " << maxCallsPerTick_ << CRLF;
    stream << "Millicalls per tick          " << milCallsPerTick_ << CRLF;
    stream << "First DN added for traffic   " << firstDN_ << CRLF;
    stream << "Last DN added for traffic    " << lastDN_ << CRLF;
@@ -1308,8 +1404,13 @@ void PotsTrafficThread::Query(ostream& stream) const
    stream << "Number of active calls       " << activeCalls_ << CRLF;
    stream << "Number of DN overflows       " << overflows_ << CRLF;
    stream << "Number of calls aborted      " << aborts_ << CRLF;
+   stream << "Number of PDD timeouts       " << pddTimeouts_ << CRLF;
    stream << "Total holding time reports   " << totalReports_ << CRLF;
 
+   auto index = Singleton<PotsDnIndex>::Extant();
+   if(index != nullptr)
+      stream << "Idle DNs for traffic         " << index->IdleCount() << CRLF;
+
    if((totalReports_ > 0) && (totalCalls_ > 0))
    {
       auto htsecs = (totalTimes_ / std::nano::den) / totalReports_;
@@ -1348,6 +1449,85 @@ void PotsTrafficThread::Query(ostream& stream) const
 
 //------------------------------------------------------------------------------
 
+//  Replaces each count in END with the number of values that were recorded
+//  since the corresponding count in START.  If the histogram's counts were
+//  reset in the meantime, the count in END is retained.
+//
+static void Subtract(uint64_t end[], const uint64_t start[])
+{
+   for(size_t i = 0; i < Histogram::NumBuckets; ++i)
+   {
+      if(end[i] >= start[i]) end[i] -= start[i];
+   }
+}
+
+//  Displays the value that PERMILLE/1000 of the values in COUNTS, which
+//  were recorded in HIST, did not exceed.
+//
+static void DisplayPercentile(ostream& stream,
+   const Histogram& hist, const uint64_t counts[], size_t permille)
+{
+   auto value = hist.Scaled(counts, permille);
+
+   if(value != SIZE_MAX)
+      stream << setw(8) << value;
+   else
+      stream << setw(8) << '-';
+}
+
+void PotsTrafficThread::Ramp(ostream& stream,
+   uint32_t first, uint32_t last, uint32_t step, uint32_t secs)
+{
+   Debug::ft("PotsTrafficThread.Ramp");
+
+   uint64_t pddStart[Histogram::NumBuckets];
+   uint64_t pddEnd[Histogram::NumBuckets];
+   uint64_t ansStart[Histogram::NumBuckets];
+   uint64_t ansEnd[Histogram::NumBuckets];
+
+   stream << "    rate created overflows aborts tmouts";
+   stream << "   pdd50   pdd95   pdd99   ans50   ans99" << CRLF;
+
+   for(auto rate = first; rate <= last; rate += step)
+   {
+      SetRate(rate);
+
+      auto calls = totalCalls_;
+      auto overflows = overflows_;
+      auto aborts = aborts_;
+      auto timeouts = pddTimeouts_;
+      postDialDelays_->GetCounts(pddStart);
+      answerDelays_->GetCounts(ansStart);
+
+      auto rc = ThisThread::Pause(msecs_t(secs * ONE_SEC));
+
+      postDialDelays_->GetCounts(pddEnd);
+      answerDelays_->GetCounts(ansEnd);
+      Subtract(pddEnd, pddStart);
+      Subtract(ansEnd, ansStart);
+
+      stream << setw(8) << rate;
+      stream << setw(8) << totalCalls_ - calls;
+      stream << setw(10) << overflows_ - overflows;
+      stream << setw(7) << aborts_ - aborts;
+      stream << setw(7) << pddTimeouts_ - timeouts;
+      DisplayPercentile(stream, *postDialDelays_, pddEnd, 500);
+      DisplayPercentile(stream, *postDialDelays_, pddEnd, 950);
+      DisplayPercentile(stream, *postDialDelays_, pddEnd, 990);
+      DisplayPercentile(stream, *answerDelays_, ansEnd, 500);
+      DisplayPercentile(stream, *answerDelays_, ansEnd, 990);
+      stream << CRLF;
+
+      if(rc != DelayCompleted) break;
+   }
+
+   stream << "  (rate in calls/min, delays in msecs, tmouts = post-dial delay";
+   stream << " timeouts)" << CRLF;
+   SetRate(0);
+}
+
+//------------------------------------------------------------------------------
+
 void PotsTrafficThread::RecordHoldingTime(const nsecs_t& time)
 {
    totalTimes_ += time;
@@ -1369,8 +1549,7 @@ void PotsTrafficThread::SendMessages()
    if(!stop)
    {
       auto reg = Singleton<PotsProfileRegistry>::Instance();
-      auto n = rand(0, maxCallsPerTick_);
-      if(rand(0, 999) < milCallsPerTick_) ++n;
+      auto n = Arrivals();
 
       for(size_t i = 0; i < n; ++i)
       {
@@ -1438,13 +1617,16 @@ void PotsTrafficThread::SetRate(uint32_t rate)
 
       FunctionGuard guard(Guard_MemUnprotect);
       auto reg = Singleton<PotsProfileRegistry>::Instance();
+      auto index = Singleton<PotsDnIndex>::Instance();
 
       for(auto i = 0; i < n; ++i)
       {
-         if(reg->Profile(dn) == nullptr)
-         {
-            new PotsProfile(dn);
-         }
+         auto prof = reg->Profile(dn);
+         if(prof == nullptr) prof = new PotsProfile(dn);
+
+         auto cct = prof->GetCircuit();
+         if(cct != nullptr)
+            index->Add(dn, (cct->GetState() == PotsCircuit::Idle));
 
          lastDN_ = dn;
 
@@ -1462,10 +1644,7 @@ void PotsTrafficThread::SetRate(uint32_t rate)
    if(callsPerMin_ > 0)
    {
       uint32_t ticksPerMin = 60000 / MsecsToSleep;
-      uint32_t CallsPerTick1000 = (1000 * rate) / ticksPerMin;
-
-      milCallsPerTick_ = CallsPerTick1000 % 1000;
-      maxCallsPerTick_ = (CallsPerTick1000 / 1000) << 1;
+      milCallsPerTick_ = (1000 * rate) / ticksPerMin;
 
       if(wakeup) Interrupt(WorkAvailable);
    }
@@ -1499,6 +1678,11 @@ void PotsTrafficThread::Takedown()
       if(curr == prev) --count;
    }
 
+   //  Delete the DN index first, so that deregistering each DN does not
+   //  have to update it.
+   //
+   Singleton<PotsDnIndex>::Destroy();
+
    FunctionGuard guard(Guard_MemUnprotect);
 
    auto reg = Singleton<PotsProfileRegistry>::Instance();
@@ -30,6 +30,7 @@
 #include "BcAddress.h"
 #include "Duration.h"
 #include "NbTypes.h"
+#include "Statistics.h"
 #include "SysTypes.h"
 
 using namespace NodeBase;
@@ -79,10 +80,19 @@ public:
    //
    void Query(std::ostream& stream) const;
 
-   //  Returns a DN with the specified STATUS.
+   //  Returns a DN with the specified STATUS.  Idle and busy DNs are
+   //  chosen at random from PotsDnIndex.
    //
    Address::DN FindDn(DnStatus status) const;
 
+   //  Runs traffic at FIRST calls per minute, and then increases the rate
+   //  by STEP until it exceeds LAST, running each rate for SECS.  Displays
+   //  the calls and latencies at each rate in STREAM, and then stops the
+   //  traffic.
+   //
+   void Ramp(std::ostream& stream,
+      uint32_t first, uint32_t last, uint32_t step, uint32_t secs);
+
    //  Displays the number of traffic calls in each state.
    //
    static void DisplayStateCounts
@@ -96,6 +106,23 @@ public:
    //
    void RecordAbort() { ++aborts_; }
 
+   //  Records a call whose originator was still receiving silence when
+   //  the post-dial delay timed out.
+   //
+   void RecordPddTimeout() { ++pddTimeouts_; }
+
+   //  Records the TIME from when a DN was dialed until the originator
+   //  received ringback or was connected to the terminator.
+   //
+   void RecordPostDialDelay(const nsecs_t& time)
+      { postDialDelays_->Record(time.count()); }
+
+   //  Records the TIME from when the terminator answered until the
+   //  originator was connected to it.
+   //
+   void RecordAnswerDelay(const nsecs_t& time)
+      { answerDelays_->Record(time.count()); }
+
    //  Overridden to display member variables.
    //
    void Display(std::ostream& stream,
@@ -113,6 +140,12 @@ private:
    //
    void SendMessages();
 
+   //  Returns the number of calls to originate during the current tick.
+   //  The number follows a Poisson distribution, so that calls arrive
+   //  independently of each other and of the calls already in progress.
+   //
+   uint32_t Arrivals() const;
+
    //  Invoked when a call has progressed to its next state and wants
    //  to delay for MSECS.  If DELAY is 0, the call is deleted, else
    //  it is queued on the timeslot that will be reached in MSECS.
@@ -153,13 +186,8 @@ private:
    //
    uint32_t callsPerMin_;
 
-   //  The maximum number of calls to generate during each tick.  It
-   //  is set to twice the target rate.
-   //
-   uint32_t maxCallsPerTick_;
-
-   //  The fractional number of calls (in thousandths) to generate
-   //  during each tick.
+   //  The average number of calls (in thousandths) to generate during
+   //  each tick.
    //
    uint32_t milCallsPerTick_;
 
@@ -202,10 +230,23 @@ private:
    //
    word aborts_;
 
+   //  The number of calls released because the originator received
+   //  neither ringback nor answer before the post-dial delay timed out.
+   //
+   word pddTimeouts_;
+
    //  Each active call is queued against the timeslot in which it will
    //  decide what to do next (typically, to send a message).
    //
    Q1Way<TrafficCall>* timewheel_;
+
+   //  The distribution of post-dial delays.
+   //
+   HistogramPtr postDialDelays_;
+
+   //  The distribution of delays between answer and connection.
+   //
+   HistogramPtr answerDelays_;
 };
 }
 #endif
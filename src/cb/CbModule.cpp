@@ -49,8 +49,8 @@ CbModule::CbModule() : Module()
 
    //  Create the modules required by CallBase.
    //
-   Singleton<StModule>::Instance();
-   Singleton<MbModule>::Instance();
+   Requires(*Singleton<StModule>::Instance());
+   Requires(*Singleton<MbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
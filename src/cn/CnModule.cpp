@@ -37,7 +37,7 @@ CnModule::CnModule() : Module("cn")
 
    //  Create the modules required by ControlNode.
    //
-   Singleton<SbModule>::Instance();
+   Requires(*Singleton<SbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
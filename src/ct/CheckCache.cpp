@@ -0,0 +1,323 @@
+//==============================================================================
+//
+//  CheckCache.cpp
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "CheckCache.h"
+#include <cctype>
+#include <cstdio>
+#include <ios>
+#include <istream>
+#include <set>
+#include "CodeFile.h"
+#include "Debug.h"
+#include "Element.h"
+#include "FileSystem.h"
+#include "Formatters.h"
+#include "FunctionGuard.h"
+
+using namespace NodeBase;
+using std::string;
+
+//------------------------------------------------------------------------------
+
+namespace CodeTools
+{
+//  Sets N to the value of HASH, a hexadecimal string.  Returns false if HASH
+//  is empty, contains a non-hexadecimal character, or does not fit in N.
+//
+static bool GetHash(const string& hash, uint32_t& n)
+{
+   Debug::ft("CodeTools.GetHash");
+
+   if(hash.empty() || (hash.size() > 2 * sizeof(uint32_t))) return false;
+
+   uint32_t value = 0;
+
+   for(size_t i = 0; i < hash.size(); ++i)
+   {
+      auto c = hash[i];
+      uint32_t digit;
+
+      if(isdigit(c))
+         digit = c - '0';
+      else if((c >= 'a') && (c <= 'f'))
+         digit = c - 'a' + 10;
+      else if((c >= 'A') && (c <= 'F'))
+         digit = c - 'A' + 10;
+      else
+         return false;
+
+      value = (value << 4) + digit;
+   }
+
+   n = value;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//  Removes the next integer from INPUT and assigns it to N.  Returns false
+//  if INPUT did not begin with an integer.
+//
+static bool GetInt(string& input, int64_t& n)
+{
+   Debug::ft("CodeTools.GetInt");
+
+   auto token = strGet(input);
+   if(token.empty()) return false;
+
+   //  Parse the digits here instead of using stoll, which throws if the
+   //  integer is malformed or too large.  A corrupt cache is discarded.
+   //
+   size_t i = 0;
+   auto neg = (token.front() == '-');
+   if(neg) ++i;
+   if(i >= token.size()) return false;
+
+   int64_t value = 0;
+
+   for(NO_OP; i < token.size(); ++i)
+   {
+      if(!isdigit(token[i])) return false;
+      auto digit = token[i] - '0';
+      if(value > (INT64_MAX - digit) / 10) return false;
+      value = (value * 10) + digit;
+   }
+
+   n = (neg ? -value : value);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//  Parses INPUT, which has the form
+//    <Warning> <"i" if informational, else "-"> <Line> <Offset> <Text>
+//  and updates RECORD.  Returns false if INPUT was not in this form.
+//
+static bool GetRecord(string& input, WarningRecord& record)
+{
+   Debug::ft("CodeTools.GetRecord");
+
+   int64_t warning, line, offset;
+
+   if(!GetInt(input, warning)) return false;
+   if((warning < 0) || (warning >= Warning_N)) return false;
+   auto info = strGet(input);
+   if((info != "i") && (info != "-")) return false;
+   if(!GetInt(input, line) || (line < 0)) return false;
+   if(!GetInt(input, offset)) return false;
+   if(!input.empty()) input.erase(0, 1);
+
+   record.warning = Warning(warning);
+   record.informational = (info == "i");
+   record.line = line;
+   record.offset = offset;
+   record.text = input;
+   return true;
+}
+
+//==============================================================================
+
+CheckCache::CheckCache() : loaded_(false)
+{
+   Debug::ft("CheckCache.ctor");
+}
+
+//------------------------------------------------------------------------------
+
+CheckCache::~CheckCache()
+{
+   Debug::ftnt("CheckCache.dtor");
+}
+
+//------------------------------------------------------------------------------
+
+bool CheckCache::Commit() const
+{
+   Debug::ft("CheckCache.Commit");
+
+   FunctionGuard guard(Guard_MakePreemptable);
+
+   auto path = Path();
+   auto stream = FileSystem::CreateOstream(path.c_str(), true);
+   if(stream == nullptr) return false;
+
+   for(auto f = files_.cbegin(); f != files_.cend(); ++f)
+   {
+      *stream << f->first << SPACE;
+      *stream << std::hex << f->second.hash << std::dec << CRLF;
+
+      const auto& warnings = f->second.warnings;
+
+      for(auto w = warnings.cbegin(); w != warnings.cend(); ++w)
+      {
+         auto text = w->text;
+
+         for(size_t i = 0; i < text.size(); ++i)
+         {
+            if(text[i] == CRLF) text[i] = SPACE;
+         }
+
+         *stream << int(w->warning) << SPACE;
+         *stream << (w->informational ? 'i' : '-') << SPACE;
+         *stream << w->line << SPACE << w->offset << SPACE << text << CRLF;
+      }
+
+      *stream << DELIMITER << CRLF;
+   }
+
+   *stream << DELIMITER << CRLF;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+bool CheckCache::Find(CodeFile* file, WarningRecords& records)
+{
+   Debug::ft("CheckCache.Find");
+
+   Load();
+
+   auto entry = files_.find(file->Path(false));
+   if(entry == files_.cend()) return false;
+   if(entry->second.hash != file->CheckHash()) return false;
+
+   const auto& warnings = entry->second.warnings;
+
+   for(auto w = warnings.cbegin(); w != warnings.cend(); ++w)
+   {
+      records.push_back(*w);
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void CheckCache::Load()
+{
+   Debug::ft("CheckCache.Load");
+
+   if(loaded_) return;
+   loaded_ = true;
+
+   FunctionGuard guard(Guard_MakePreemptable);
+
+   auto path = Path();
+   auto stream = FileSystem::CreateIstream(path.c_str());
+   if(stream == nullptr) return;
+
+   //  Build the database in FILES, and only replace files_ with it if the
+   //  final delimiter is reached without finding an error.
+   //
+   Files files;
+   string file;
+   string input;
+
+   while(stream->peek() != EOF)
+   {
+      FileSystem::GetLine(*stream, input);
+      if(input.empty()) continue;
+
+      if(input.front() == DELIMITER)
+      {
+         if(file.empty())
+         {
+            files_ = files;
+            return;
+         }
+
+         file.clear();
+         continue;
+      }
+
+      if(file.empty())
+      {
+         //  Look for a <FilePath> <CheckHash> pair.
+         //
+         auto pos = input.rfind(SPACE);
+         if((pos == string::npos) || (pos == 0)) return;
+         uint32_t hash;
+         if(!GetHash(input.substr(pos + 1), hash)) return;
+
+         file = input.substr(0, pos);
+         files[file].hash = hash;
+         continue;
+      }
+
+      WarningRecord record;
+      if(!GetRecord(input, record)) return;
+      record.file = file;
+      files[file].warnings.push_back(record);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+string CheckCache::Path()
+{
+   Debug::ft("CheckCache.Path");
+
+   return Element::OutputPath() + PATH_SEPARATOR + "check.cache.txt";
+}
+
+//------------------------------------------------------------------------------
+
+void CheckCache::Shutdown(RestartLevel level)
+{
+   Debug::ft("CheckCache.Shutdown");
+
+   files_.clear();
+   loaded_ = false;
+}
+
+//------------------------------------------------------------------------------
+
+void CheckCache::Update(const LibItemSet& files, const WarningRecords& records)
+{
+   Debug::ft("CheckCache.Update");
+
+   Load();
+
+   //  Replace the entry for each file in FILES.
+   //
+   std::set<string> paths;
+
+   for(auto f = files.cbegin(); f != files.cend(); ++f)
+   {
+      auto file = static_cast<CodeFile*>(*f);
+      auto path = file->Path(false);
+      auto& info = files_[path];
+      info.hash = file->CheckHash();
+      info.warnings.clear();
+      paths.insert(path);
+   }
+
+   for(auto r = records.cbegin(); r != records.cend(); ++r)
+   {
+      if(paths.find(r->file) != paths.cend())
+      {
+         files_[r->file].warnings.push_back(*r);
+      }
+   }
+
+   Commit();
+}
+}
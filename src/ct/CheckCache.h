@@ -0,0 +1,117 @@
+//==============================================================================
+//
+//  CheckCache.h
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef CHECKCACHE_H_INCLUDED
+#define CHECKCACHE_H_INCLUDED
+
+#include "Temporary.h"
+#include <cstdint>
+#include <map>
+#include <string>
+#include "CodeWarning.h"
+#include "LibraryItem.h"
+#include "NbTypes.h"
+
+//------------------------------------------------------------------------------
+
+namespace CodeTools
+{
+//  Database of the warnings that >check found in each file.  A file's entry
+//  remains valid until it, or a file that it affects or that affects it, is
+//  modified, so >check can report its warnings without parsing it again.
+//  The database is kept in OutputPath/check.cache.txt, which has the form
+//    [<FilePath> <CheckHash> [<WarningRecord>]* "$"]* "$"
+//  where each <FilePath>, <WarningRecord>, and "$" is on a separate line.
+//
+class CheckCache : public NodeBase::Temporary
+{
+   friend class NodeBase::Singleton<CheckCache>;
+public:
+   //  Deleted to prohibit copying.
+   //
+   CheckCache(const CheckCache& that) = delete;
+
+   //  Deleted to prohibit copy assignment.
+   //
+   CheckCache& operator=(const CheckCache& that) = delete;
+
+   //  If the warnings for FILE are cached and still valid, adds them to
+   //  RECORDS and returns true.
+   //
+   bool Find(CodeFile* file, WarningRecords& records);
+
+   //  Replaces the cached warnings for each file in FILES with those in
+   //  RECORDS and commits the database.
+   //
+   void Update(const LibItemSet& files, const WarningRecords& records);
+
+   //  Overridden for restarts.
+   //
+   void Shutdown(NodeBase::RestartLevel level) override;
+private:
+   //  Private because this is a singleton.
+   //
+   CheckCache();
+
+   //  Private because this is a singleton.
+   //
+   ~CheckCache();
+
+   //  Loads the database if this has not already been done.  If the database
+   //  cannot be read or is corrupt, it is ignored, which causes all files to
+   //  be checked again.
+   //
+   void Load();
+
+   //  Writes the database.  Returns false if it could not be written.
+   //
+   bool Commit() const;
+
+   //  Returns the path to the database.
+   //
+   static std::string Path();
+
+   // '$' is used as an end-of-record delimiter in the database.
+   //
+   static const char DELIMITER = '$';
+
+   //  The warnings found in a file.
+   //
+   struct FileInfo
+   {
+      uint32_t hash;             // file's CheckHash when it was checked
+      WarningRecords warnings;   // warnings found in the file
+   };
+
+   //  A database of files, indexed by their paths.
+   //
+   typedef std::map<std::string, FileInfo> Files;
+
+   //  The files in the database.
+   //
+   Files files_;
+
+   //  Set if the database has been loaded.
+   //
+   bool loaded_;
+};
+}
+#endif
@@ -28,6 +28,7 @@
 #include <iterator>
 #include <sstream>
 #include <utility>
+#include "Algorithms.h"
 #include "CodeCoverage.h"
 #include "CodeDir.h"
 #include "CodeFileSet.h"
@@ -44,6 +45,7 @@
 #include "CxxToken.h"
 #include "CxxVector.h"
 #include "Debug.h"
+#include "FileBitset.h"
 #include "FileSystem.h"
 #include "Formatters.h"
 #include "Lexer.h"
@@ -440,6 +442,8 @@ CodeFile::CodeFile(const string& name, CodeDir* dir) :
    dir_(dir),
    isHeader_(false),
    isSubsFile_(false),
+   hash_(0),
+   index_(0),
    newest_(nullptr),
    parsed_(Unparsed),
    checked_(false)
@@ -448,7 +452,7 @@ CodeFile::CodeFile(const string& name, CodeDir* dir) :
 
    isHeader_ = (name.find(".c") == string::npos);
    isSubsFile_ = (dir != nullptr) && dir->IsSubsDir();
-   Singleton<Library>::Instance()->AddFile(*this);
+   index_ = Singleton<Library>::Instance()->AddFile(*this);
 }
 
 //------------------------------------------------------------------------------
@@ -524,11 +528,10 @@ const LibItemSet& CodeFile::Affecters()
 
    Debug::ft("CodeFile.Affecters");
 
-   auto fileSet = new CodeFileSet(LibrarySet::TemporaryName(), nullptr);
-   auto& context = fileSet->Items();
-   context.insert(this);
-   auto asSet = fileSet->Affecters();
-   affecterSet_ = asSet->Items();
+   FileBitset files;
+   files.Insert(this);
+   files.AddAffecters();
+   files.GetItems(affecterSet_);
    return affecterSet_;
 }
 
@@ -553,6 +556,18 @@ IncludeGroup CodeFile::CalcGroup(const Include& incl) const
 
 //------------------------------------------------------------------------------
 
+void CodeFile::CalcHash()
+{
+   Debug::ft("CodeFile.CalcHash");
+
+   //  Use the editor's version of the code, which includes any edits that
+   //  have been committed.
+   //
+   hash_ = string_hash(editor_.Source().c_str());
+}
+
+//------------------------------------------------------------------------------
+
 bool CodeFile::CanBeTrimmed() const
 {
    Debug::ft("CodeFile.CanBeTrimmed");
@@ -778,6 +793,41 @@ void CodeFile::CheckFunctionOrder() const
 
 //------------------------------------------------------------------------------
 
+uint32_t CodeFile::CheckHash()
+{
+   Debug::ft("CodeFile.CheckHash");
+
+   //  A file's warnings depend on the files that affect it.  Because some
+   //  warnings (e.g. unused items) depend on how the file's items are used,
+   //  they also depend on the files that transitively #include it.
+   //
+   FileBitset files(Affecters());
+   FileBitset users;
+   users.Insert(this);
+   users.AddAffected();
+   files.Union(users);
+
+   LibItemSet items;
+   files.GetItems(items);
+
+   //  Mix each file's hash value into the result.  A sum would allow edits
+   //  to two files to cancel out, and would not change if the hash values
+   //  of two files were exchanged.  LibItemSet is sorted, so the files are
+   //  always visited in the same order.
+   //
+   uint32_t result = 0;
+
+   for(auto f = items.cbegin(); f != items.cend(); ++f)
+   {
+      auto hash = static_cast<const CodeFile*>(*f)->hash_;
+      result ^= hash + 0x9e3779b9 + (result << 6) + (result >> 2);
+   }
+
+   return result;
+}
+
+//------------------------------------------------------------------------------
+
 void CodeFile::CheckIncludeGuard()
 {
    Debug::ft("CodeFile.CheckIncludeGuard");
@@ -2631,6 +2681,7 @@ void CodeFile::Scan()
    if(!code_.empty()) return;
    if(!ReadCode(code_)) return;
    editor_.Initialize(code_, this);
+   CalcHash();
    editor_.CalcLineTypes();
 
    //  Preprocess #include directives.
@@ -24,6 +24,7 @@
 
 #include "LibraryItem.h"
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <string>
 #include "CodeTypes.h"
@@ -126,6 +127,26 @@ public:
    //
    const LibItemSet& Affecters();
 
+   //  Returns a hash value for the file's code.
+   //
+   uint32_t Hash() const { return hash_; }
+
+   //  Returns the file's index in the library, which is unique among files
+   //  and less than Library::FileCount.
+   //
+   size_t Index() const { return index_; }
+
+   //  Recalculates the hash value for the file's code.  Invoked after the
+   //  code has been read or an edited version has been written.
+   //
+   void CalcHash();
+
+   //  Returns a value that changes when this file, a file that affects it,
+   //  or a file that it affects is modified.  The warnings that >check finds
+   //  in the file remain valid as long as this value is unchanged.
+   //
+   uint32_t CheckHash();
+
    //  Returns the file's code items.
    //
    const CxxTokenList& Items() const { return items_; }
@@ -563,6 +584,14 @@ private:
    //
    std::string code_;
 
+   //  The hash value for code_.
+   //
+   uint32_t hash_;
+
+   //  The file's index in the library.
+   //
+   size_t index_;
+
    //  The #included files.
    //
    LibItemSet inclSet_;
@@ -25,6 +25,7 @@
 #include <iosfwd>
 #include <iterator>
 #include <sstream>
+#include "CheckCache.h"
 #include "CliThread.h"
 #include "CodeDir.h"
 #include "CodeDirSet.h"
@@ -37,13 +38,16 @@
 #include "CxxFwd.h"
 #include "CxxNamed.h"
 #include "Debug.h"
+#include "Duration.h"
 #include "Editor.h"
+#include "FileBitset.h"
 #include "Formatters.h"
 #include "Library.h"
 #include "NbCliParms.h"
 #include "Parser.h"
 #include "SetOperations.h"
 #include "Singleton.h"
+#include "SteadyTime.h"
 #include "SysTypes.h"
 #include "ThisThread.h"
 
@@ -100,6 +104,17 @@ static bool IsSortedByFileLevel(const FileLevel& item1, const FileLevel& item2)
    return (&item1 < &item2);
 }
 
+//------------------------------------------------------------------------------
+//
+//  Returns the number of msecs from BEGIN to END.
+//
+static int64_t MsecsBetween
+   (const SteadyTime::Point& begin, const SteadyTime::Point& end)
+{
+   nsecs_t elapsed = end - begin;
+   return elapsed.count() / NS_TO_MS;
+}
+
 //==============================================================================
 
 CodeFileSet::CodeFileSet(const string& name, const LibItemSet* items) :
@@ -122,26 +137,13 @@ LibrarySet* CodeFileSet::AffectedBy() const
    Debug::ft("CodeFileSet.AffectedBy");
 
    //  What is affected by this set are those that include it, transitively.
-   //  Start with the initial set and add files that directly include any
-   //  member of the set.
-   //
-   LibrarySet* prev = nullptr;
-   auto curr = Users(true);
-   size_t prevSize = this->Items().size();
-   size_t currSize = curr->Items().size();
-
-   //  Keep adding files that #include the new members until the set stops
-   //  growing.
    //
-   while(prevSize < currSize)
-   {
-      prev = curr;
-      prevSize = currSize;
-      curr = prev->Users(true);
-      currSize = curr->Items().size();
-   }
+   FileBitset files(Items());
+   files.AddAffected();
 
-   return curr;
+   auto result = new CodeFileSet(TemporaryName(), nullptr);
+   files.GetItems(result->Items());
+   return result;
 }
 
 //------------------------------------------------------------------------------
@@ -150,26 +152,14 @@ LibrarySet* CodeFileSet::Affecters() const
 {
    Debug::ft("CodeFileSet.Affecters");
 
-   //  What affects this set are what it includes, transitively.  Start with
-   //  the initial set and add files that any member directly includes.
+   //  What affects this set are what it includes, transitively.
    //
-   LibrarySet* prev = nullptr;
-   auto curr = UsedBy(true);
-   size_t prevSize = this->Items().size();
-   size_t currSize = curr->Items().size();
-
-   //  Keep adding files that the new members #include until the set stops
-   //  growing.
-   //
-   while(prevSize < currSize)
-   {
-      prev = curr;
-      prevSize = currSize;
-      curr = prev->UsedBy(true);
-      currSize = curr->Items().size();
-   }
+   FileBitset files(Items());
+   files.AddAffecters();
 
-   return curr;
+   auto result = new CodeFileSet(TemporaryName(), nullptr);
+   files.GetItems(result->Items());
+   return result;
 }
 
 //------------------------------------------------------------------------------
@@ -188,10 +178,28 @@ word CodeFileSet::Check(CliThread& cli, ostream* stream, string& expl) const
       return rc;
    }
 
+   //  When generating a report, obtain the warnings for files whose results
+   //  are cached and still valid.  Only the other files need to be checked.
+   //
+   auto cache =
+      (stream != nullptr ? Singleton<CheckCache>::Instance() : nullptr);
+   WarningRecords records;
+   LibItemSet checkSet;
+
    for(auto f = fileSet.cbegin(); f != fileSet.cend(); ++f)
    {
       auto file = static_cast<CodeFile*>(*f);
 
+      if((cache == nullptr) || !cache->Find(file, records))
+      {
+         checkSet.insert(file);
+      }
+   }
+
+   for(auto f = checkSet.cbegin(); f != checkSet.cend(); ++f)
+   {
+      auto file = static_cast<CodeFile*>(*f);
+
       if(file->ParseStatus() != CodeFile::Passed)
       {
          expl = "Files to be checked must first be successfully parsed.";
@@ -199,37 +207,55 @@ word CodeFileSet::Check(CliThread& cli, ostream* stream, string& expl) const
       }
    }
 
-   //  To avoid generating spurious warnings, the following must be parsed:
-   //  (a) files affected by those to be checked;
-   //  (b) files that affect those in (a).
-   //
-   auto inclSet = new CodeFileSet(TemporaryName(), &fileSet);
-   auto abSet = this->AffectedBy();
-   SetUnion(inclSet->Items(), abSet->Items());
-   auto parseSet = GetParseSet(inclSet->Items());
-   auto& parseItems = parseSet->Items();
-   auto skip = true;
+   auto skipped = false;
 
-   if(parseItems.size() > 0)
+   if(!checkSet.empty())
    {
-      *cli.obuf << parseItems.size() << " files should be parsed to";
-      *cli.obuf << CRLF << " avoid spurious results. ";
-      skip = cli.BoolPrompt("Do you wish to skip this?");
-   }
+      //  To avoid generating spurious warnings, the following must be parsed:
+      //  (a) files affected by those to be checked;
+      //  (b) files that affect those in (a).
+      //
+      auto checkFiles = new CodeFileSet(TemporaryName(), &checkSet);
+      auto inclSet = new CodeFileSet(TemporaryName(), &checkSet);
+      auto abSet = checkFiles->AffectedBy();
+      SetUnion(inclSet->Items(), abSet->Items());
+      auto parseSet = GetParseSet(inclSet->Items());
+      auto& parseItems = parseSet->Items();
+      auto skip = true;
+
+      if(parseItems.size() > 0)
+      {
+         *cli.obuf << parseItems.size() << " files should be parsed to";
+         *cli.obuf << CRLF << " avoid spurious results. ";
+         skip = cli.BoolPrompt("Do you wish to skip this?");
+      }
 
-   if(!skip)
-   {
-      auto parseFiles = new CodeFileSet(TemporaryName(), &parseSet->Items());
-      rc = parseFiles->Parse(expl, "-");
-   }
+      if(!skip)
+      {
+         auto parseFiles =
+            new CodeFileSet(TemporaryName(), &parseSet->Items());
+         rc = parseFiles->Parse(expl, "-");
+      }
+      else
+      {
+         skipped = (parseItems.size() > 0);
+      }
 
-   if(rc != 0) return rc;
-   expl.clear();
+      if(rc != 0) return rc;
+      expl.clear();
+   }
 
-   CodeWarning::GenerateReport(stream, fileSet);
+   //  If files that should have been parsed were skipped, the warnings may
+   //  be spurious, so don't cache them.
+   //
+   CodeWarning::GenerateReport(stream, checkSet, records);
+   if((cache != nullptr) && !skipped) cache->Update(checkSet, records);
 
    std::ostringstream summary;
-   summary << fileSet.size() << " file(s) checked.";
+   summary << fileSet.size() << " file(s) checked";
+   if(checkSet.size() < fileSet.size())
+      summary << " (" << fileSet.size() - checkSet.size() << " cached)";
+   summary << '.';
    expl = summary.str();
    return rc;
 }
@@ -245,19 +271,21 @@ LibrarySet* CodeFileSet::CommonAffecters() const
    //
    const auto& fileSet = Items();
    auto result = new CodeFileSet(TemporaryName(), nullptr);
-   auto& caSet = result->Items();
+   FileBitset caSet;
 
    for(auto f = fileSet.cbegin(); f != fileSet.cend(); ++f)
    {
       auto file = static_cast<CodeFile*>(*f);
+      FileBitset affecters(file->Affecters());
 
       if(f == fileSet.cbegin())
-         SetUnion(caSet, file->Affecters());
+         caSet.Union(affecters);
       else
-         SetIntersection(caSet, file->Affecters());
-      if(caSet.empty()) break;
+         caSet.Intersection(affecters);
+      if(caSet.Empty()) break;
    }
 
+   caSet.GetItems(result->Items());
    return result;
 }
 
@@ -319,6 +347,22 @@ LibrarySet* CodeFileSet::DeclaredBy() const
 
 //------------------------------------------------------------------------------
 
+LibrarySet* CodeFileSet::Difference(const LibrarySet* that) const
+{
+   Debug::ft("CodeFileSet.Difference");
+
+   if(that->GetType() != FILE_SET) return CodeSet::Difference(that);
+
+   FileBitset files(Items());
+   files.Difference(FileBitset(that->Items()));
+
+   auto result = new CodeFileSet(TemporaryName(), nullptr);
+   files.GetItems(result->Items());
+   return result;
+}
+
+//------------------------------------------------------------------------------
+
 LibrarySet* CodeFileSet::Directories() const
 {
    Debug::ft("CodeFileSet.Directories");
@@ -564,6 +608,22 @@ LibrarySet* CodeFileSet::Implements() const
 
 //------------------------------------------------------------------------------
 
+LibrarySet* CodeFileSet::Intersection(const LibrarySet* that) const
+{
+   Debug::ft("CodeFileSet.Intersection");
+
+   if(that->GetType() != FILE_SET) return CodeSet::Intersection(that);
+
+   FileBitset files(Items());
+   files.Intersection(FileBitset(that->Items()));
+
+   auto result = new CodeFileSet(TemporaryName(), nullptr);
+   files.GetItems(result->Items());
+   return result;
+}
+
+//------------------------------------------------------------------------------
+
 word CodeFileSet::LineTypes(CliThread& cli, ostream* stream, string& expl) const
 {
    Debug::ft("CodeFileSet.LineTypes");
@@ -707,6 +767,7 @@ word CodeFileSet::Parse(string& expl, const string& opts) const
    ParserPtr parser(new Parser());
    size_t total = 0;
    size_t failed = 0;
+   auto time0 = SteadyTime::Now();
 
    for(auto f = order.cbegin(); f != order.cend(); ++f)
    {
@@ -718,6 +779,8 @@ word CodeFileSet::Parse(string& expl, const string& opts) const
       }
    }
 
+   auto time1 = SteadyTime::Now();
+
    for(auto f = order.cbegin(); f != order.cend(); ++f)
    {
       if(f->file->IsSubsFile()) continue;
@@ -730,6 +793,8 @@ word CodeFileSet::Parse(string& expl, const string& opts) const
       }
    }
 
+   auto time2 = SteadyTime::Now();
+
    for(auto f = order.cbegin(); f != order.cend(); ++f)
    {
       if(f->file->IsCpp() && !f->file->IsSubsFile())
@@ -741,6 +806,7 @@ word CodeFileSet::Parse(string& expl, const string& opts) const
    }
 
    parser.reset();
+   auto time3 = SteadyTime::Now();
 
    //  Update the cross-reference with symbols in the files just parsed.
    //
@@ -754,8 +820,14 @@ word CodeFileSet::Parse(string& expl, const string& opts) const
       }
    }
 
+   auto time4 = SteadyTime::Now();
+
    std::ostringstream summary;
-   summary << "Total=" << total << ", failed=" << failed;
+   summary << "Total=" << total << ", failed=" << failed << CRLF;
+   summary << spaces(2) << "msecs: substitutes=" << MsecsBetween(time0, time1);
+   summary << ", headers=" << MsecsBetween(time1, time2);
+   summary << ", implementations=" << MsecsBetween(time2, time3);
+   summary << ", xref=" << MsecsBetween(time3, time4);
    expl = summary.str();
    return 0;
 }
@@ -930,13 +1002,13 @@ BuildOrder CodeFileSet::SortInBuildOrder() const
    const auto& fileSet = Items();
    const auto& fullSet = Singleton<Library>::Instance()->Files().Items();
    auto size = fullSet.size();
-   std::vector<LibItemSet> incls;
+   std::vector<FileBitset> incls;
    std::vector<CodeFile*> files;
 
    for(auto f = fullSet.cbegin(); f != fullSet.cend(); ++f)
    {
       auto file = static_cast<CodeFile*>(*f);
-      incls.push_back(file->InclList());
+      incls.push_back(FileBitset(file->InclList()));
       files.push_back(file);
    }
 
@@ -945,12 +1017,12 @@ BuildOrder CodeFileSet::SortInBuildOrder() const
    //  build order for the files in the original set.
    //
    size_t found = 0;
-   LibItemSet build;
+   FileBitset build;
    BuildOrder order;
 
    for(size_t level = 0; true; ++level)
    {
-      build.clear();
+      build.Clear();
 
       //  Add a file to BUILD if everything that it #includes has already
       //  been included in the build.  Afterwards, remove it from the list
@@ -958,7 +1030,7 @@ BuildOrder CodeFileSet::SortInBuildOrder() const
       //
       for(size_t i = 0; i < size; ++i)
       {
-         if((files[i] != nullptr) && incls[i].empty())
+         if((files[i] != nullptr) && incls[i].Empty())
          {
             auto iter = fileSet.find(files[i]);
 
@@ -968,7 +1040,7 @@ BuildOrder CodeFileSet::SortInBuildOrder() const
                order.push_back(item);
             }
 
-            build.insert(files[i]);
+            build.Insert(files[i]);
             files[i] = nullptr;
             ++found;
          }
@@ -977,14 +1049,11 @@ BuildOrder CodeFileSet::SortInBuildOrder() const
       //  Remove, from every #includes list, all the files that were just
       //  added to the build.  Stop when no more files were added.
       //
-      if(!build.empty())
+      if(!build.Empty())
       {
          for(size_t i = 0; i < incls.size(); ++i)
          {
-            if(!incls[i].empty())
-            {
-               SetDifference(incls[i], build);
-            }
+            incls[i].Difference(build);
          }
       }
       else
@@ -1026,6 +1095,22 @@ void CodeFileSet::to_str(stringVector& strings, bool verbose) const
 
 //------------------------------------------------------------------------------
 
+LibrarySet* CodeFileSet::Union(const LibrarySet* that) const
+{
+   Debug::ft("CodeFileSet.Union");
+
+   if(that->GetType() != FILE_SET) return CodeSet::Union(that);
+
+   FileBitset files(Items());
+   files.Union(FileBitset(that->Items()));
+
+   auto result = new CodeFileSet(TemporaryName(), nullptr);
+   files.GetItems(result->Items());
+   return result;
+}
+
+//------------------------------------------------------------------------------
+
 LibrarySet* CodeFileSet::UsedBy(bool self) const
 {
    Debug::ft("CodeFileSet.UsedBy");
@@ -47,16 +47,19 @@ public:
    LibrarySet* Affecters() const override;
    LibrarySet* CommonAffecters() const override;
    LibrarySet* DeclaredBy() const override;
+   LibrarySet* Difference(const LibrarySet* that) const override;
    LibrarySet* Directories() const override;
    LibrarySet* FileName(const LibrarySet* that) const override;
    LibrarySet* Files() const override;
    LibrarySet* FileType(const LibrarySet* that) const override;
    LibrarySet* FoundIn(const LibrarySet* that) const override;
    LibrarySet* Implements() const override;
+   LibrarySet* Intersection(const LibrarySet* that) const override;
    LibrarySet* MatchString(const LibrarySet* that) const override;
    LibrarySet* NeededBy() const override;
    LibrarySet* Needers() const override;
    LibrarySet* ReferencedBy() const override;
+   LibrarySet* Union(const LibrarySet* that) const override;
    LibrarySet* UsedBy(bool self) const override;
    LibrarySet* Users(bool self) const override;
 
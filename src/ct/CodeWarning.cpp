@@ -154,7 +154,8 @@ const CodeWarning* CodeWarning::FindWarning(const CodeFile* file,
 
 //------------------------------------------------------------------------------
 
-void CodeWarning::GenerateReport(ostream* stream, const LibItemSet& files)
+void CodeWarning::GenerateReport(ostream* stream,
+   const LibItemSet& files, WarningRecords& records)
 {
    Debug::ft("CodeWarning.GenerateReport");
 
@@ -162,41 +163,41 @@ void CodeWarning::GenerateReport(ostream* stream, const LibItemSet& files)
    //
    for(auto w = 0; w < Warning_N; ++w) WarningCounts_[w] = 0;
 
-   //  Sort the files to be checked in build order.  This is important because
-   //  recommendations about adding and removing #include directives and using
-   //  statements, for example, are affected by earlier recommendations for
-   //  #included files.
-   //
-   auto check = new CodeFileSet(LibrarySet::TemporaryName(), &files);
-   auto order = check->SortInBuildOrder();
-
-   //  Run a check on each file in ORDER, as well as on each C++ item.
-   //
-   for(auto f = order.cbegin(); f != order.cend(); ++f)
+   if(!files.empty())
    {
-      auto file = f->file;
-      if(file->IsHeader()) file->Check(stream != nullptr);
-      ThisThread::Pause();
-   }
+      //  Sort the files to be checked in build order.  This is important
+      //  because recommendations about adding and removing #include
+      //  directives and using statements, for example, are affected by
+      //  earlier recommendations for #included files.
+      //
+      auto check = new CodeFileSet(LibrarySet::TemporaryName(), &files);
+      auto order = check->SortInBuildOrder();
 
-   for(auto f = order.cbegin(); f != order.cend(); ++f)
-   {
-      auto file = f->file;
-      if(file->IsCpp()) file->Check(stream != nullptr);
-      ThisThread::Pause();
-   }
+      //  Run a check on each file in ORDER, as well as on each C++ item.
+      //
+      for(auto f = order.cbegin(); f != order.cend(); ++f)
+      {
+         auto file = f->file;
+         if(file->IsHeader()) file->Check(stream != nullptr);
+         ThisThread::Pause();
+      }
 
-   Singleton<CxxRoot>::Instance()->Check(stream != nullptr);
+      for(auto f = order.cbegin(); f != order.cend(); ++f)
+      {
+         auto file = f->file;
+         if(file->IsCpp()) file->Check(stream != nullptr);
+         ThisThread::Pause();
+      }
+
+      Singleton<CxxRoot>::Instance()->Check(stream != nullptr);
+   }
 
    //  Return if a report is not required.
    //
    if(stream == nullptr) return;
 
-   std::vector<const CodeWarning*> warnings;
-
-   //  Count the total number of warnings of each type that appear in files
-   //  belonging to the original SET, extracting them into the local set of
-   //  warnings.  Don't count warnings that are informational.
+   //  Add the warnings that appear in files belonging to the original SET
+   //  to RECORDS.
    //
    for(auto f = files.cbegin(); f != files.cend(); ++f)
    {
@@ -214,11 +215,18 @@ void CodeWarning::GenerateReport(ostream* stream, const LibItemSet& files)
             continue;
          }
 
-         if(!log.IsInformational()) ++WarningCounts_[log.warning_];
-         warnings.push_back(&log);
+         records.push_back(log.GetRecord());
       }
    }
 
+   //  Count the total number of warnings of each type.  Don't count
+   //  warnings that are informational.
+   //
+   for(auto r = records.cbegin(); r != records.cend(); ++r)
+   {
+      if(!r->informational) ++WarningCounts_[r->warning];
+   }
+
    //  Display the total number of warnings of each type.
    //
    *stream << "WARNING COUNTS (* if supported by >fix)" << CRLF;
@@ -238,6 +246,7 @@ void CodeWarning::GenerateReport(ostream* stream, const LibItemSet& files)
 
    //  Sort and output the warnings by warning type/file/line.
    //
+   WarningRecords warnings(records);
    std::sort(warnings.begin(), warnings.end(), IsSortedByType);
 
    auto item = warnings.cbegin();
@@ -245,29 +254,19 @@ void CodeWarning::GenerateReport(ostream* stream, const LibItemSet& files)
 
    while(item != last)
    {
-      auto w = (*item)->warning_;
+      auto w = item->warning;
       *stream << WarningCode(w) << SPACE << w << CRLF;
 
       do
       {
-         auto f = (*item)->File();
-
-         *stream << ((*item)->IsInformational() ? 'i' : SPACE);
-         *stream << SPACE << f->Path(false);
-         *stream << '(' << (*item)->Line() + 1;
-         if((*item)->offset_ > 0) *stream << '/' << (*item)->offset_;
-         *stream << "): ";
-
-         if((*item)->HasCodeToDisplay())
-         {
-            *stream << f->GetLexer().GetCode((*item)->Pos(), false);
-         }
-
-         if((*item)->HasInfoToDisplay()) *stream << " // " << (*item)->info_;
-         *stream << CRLF;
+         *stream << (item->informational ? 'i' : SPACE);
+         *stream << SPACE << item->file;
+         *stream << '(' << item->line + 1;
+         if(item->offset > 0) *stream << '/' << item->offset;
+         *stream << "): " << item->text << CRLF;
          ++item;
       }
-      while((item != last) && ((*item)->warning_ == w));
+      while((item != last) && (item->warning == w));
    }
 
    *stream << string(132, '=') << CRLF;
@@ -282,36 +281,27 @@ void CodeWarning::GenerateReport(ostream* stream, const LibItemSet& files)
 
    while(item != last)
    {
-      auto f = (*item)->File();
-      *stream << f->Path(false) << CRLF;
+      const auto& f = item->file;
+      *stream << f << CRLF;
 
       do
       {
-         auto w = (*item)->warning_;
+         auto w = item->warning;
          *stream << (Attrs_.at(Warning(w)).fixable_ ? '*' : SPACE);
          *stream << SPACE << WarningCode(w) << SPACE << w << CRLF;
 
          do
          {
             *stream << spaces(2);
-            *stream << ((*item)->IsInformational() ? 'i' : SPACE);
-            *stream << SPACE << (*item)->Line() + 1;
-            if((*item)->offset_ > 0) *stream << '/' << (*item)->offset_;
-            *stream << ": ";
-
-            if((*item)->HasCodeToDisplay())
-            {
-               *stream << f->GetLexer().GetCode((*item)->Pos(), false);
-            }
-
-            if((*item)->HasInfoToDisplay()) *stream << " // " << (*item)->info_;
-            *stream << CRLF;
+            *stream << (item->informational ? 'i' : SPACE);
+            *stream << SPACE << item->line + 1;
+            if(item->offset > 0) *stream << '/' << item->offset;
+            *stream << ": " << item->text << CRLF;
             ++item;
          }
-         while((item != last) &&
-            ((*item)->warning_ == w) && ((*item)->File() == f));
+         while((item != last) && (item->warning == w) && (item->file == f));
       }
-      while((item != last) && ((*item)->File() == f));
+      while((item != last) && (item->file == f));
    }
 }
 
@@ -334,6 +324,25 @@ string CodeWarning::GetNewFuncName() const
 
 //------------------------------------------------------------------------------
 
+WarningRecord CodeWarning::GetRecord() const
+{
+   Debug::ft("CodeWarning.GetRecord");
+
+   WarningRecord record;
+
+   auto f = File();
+   record.file = f->Path(false);
+   record.warning = warning_;
+   record.informational = IsInformational();
+   record.line = Line();
+   record.offset = offset_;
+   if(HasCodeToDisplay()) record.text = f->GetLexer().GetCode(Pos(), false);
+   if(HasInfoToDisplay()) record.text += " // " + info_;
+   return record;
+}
+
+//------------------------------------------------------------------------------
+
 bool CodeWarning::HasCodeToDisplay() const
 {
    return ((Pos() != string::npos) || info_.empty());
@@ -826,39 +835,35 @@ bool CodeWarning::IsInformational() const
 //------------------------------------------------------------------------------
 
 bool CodeWarning::IsSortedByFile
-   (const CodeWarning* log1, const CodeWarning* log2)
+   (const WarningRecord& rec1, const WarningRecord& rec2)
 {
-   auto result = strCompare(log1->File()->Path(), log2->File()->Path());
+   auto result = strCompare(rec1.file, rec2.file);
    if(result == -1) return true;
    if(result == 1) return false;
-   if(log1->warning_ < log2->warning_) return true;
-   if(log1->warning_ > log2->warning_) return false;
-   if(log1->Pos() < log2->Pos()) return true;
-   if(log1->Pos() > log2->Pos()) return false;
-   if(log1->offset_ < log2->offset_) return true;
-   if(log1->offset_ > log2->offset_) return false;
-   if(log1->info_ < log2->info_) return true;
-   if(log1->info_ > log2->info_) return false;
-   return (log1 < log2);
+   if(rec1.warning < rec2.warning) return true;
+   if(rec1.warning > rec2.warning) return false;
+   if(rec1.line < rec2.line) return true;
+   if(rec1.line > rec2.line) return false;
+   if(rec1.offset < rec2.offset) return true;
+   if(rec1.offset > rec2.offset) return false;
+   return (rec1.text < rec2.text);
 }
 
 //------------------------------------------------------------------------------
 
 bool CodeWarning::IsSortedByType
-   (const CodeWarning* log1, const CodeWarning* log2)
+   (const WarningRecord& rec1, const WarningRecord& rec2)
 {
-   if(log1->warning_ < log2->warning_) return true;
-   if(log1->warning_ > log2->warning_) return false;
-   auto result = strCompare(log1->File()->Path(), log2->File()->Path());
+   if(rec1.warning < rec2.warning) return true;
+   if(rec1.warning > rec2.warning) return false;
+   auto result = strCompare(rec1.file, rec2.file);
    if(result == -1) return true;
    if(result == 1) return false;
-   if(log1->Pos() < log2->Pos()) return true;
-   if(log1->Pos() > log2->Pos()) return false;
-   if(log1->offset_ < log2->offset_) return true;
-   if(log1->offset_ > log2->offset_) return false;
-   if(log1->info_ < log2->info_) return true;
-   if(log1->info_ > log2->info_) return false;
-   return (log1 < log2);
+   if(rec1.line < rec2.line) return true;
+   if(rec1.line > rec2.line) return false;
+   if(rec1.offset < rec2.offset) return true;
+   if(rec1.offset > rec2.offset) return false;
+   return (rec1.text < rec2.text);
 }
 
 //------------------------------------------------------------------------------
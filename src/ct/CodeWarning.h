@@ -81,6 +81,24 @@ enum WarningStatus
    Fixed          // code changed and written to file
 };
 
+//------------------------------------------------------------------------------
+//
+//  A warning in the form that >check reports it.  Unlike a CodeWarning, it
+//  does not refer to parsed code, so it can be saved in the check cache and
+//  reported again without parsing the file (see CheckCache).
+//
+struct WarningRecord
+{
+   std::string file;       // path to the file in which the warning occurred
+   Warning warning;        // type of warning
+   bool informational;     // set if the warning is informational
+   size_t line;            // line on which the warning occurred
+   NodeBase::word offset;  // same as CodeWarning.offset_
+   std::string text;       // code and information to display
+};
+
+typedef std::vector<WarningRecord> WarningRecords;
+
 //------------------------------------------------------------------------------
 //
 //  Used to log a warning.
@@ -121,9 +139,12 @@ public:
    void Insert() const;
 
    //  Displays, in STREAM, the code warnings that were found in FILES during
-   //  parsing and compilation.
+   //  parsing and compilation.  RECORDS contains warnings, obtained from the
+   //  check cache, for files that were not checked again.  The warnings found
+   //  in FILES are added to RECORDS before the report is generated.
    //
-   static void GenerateReport(std::ostream* stream, const LibItemSet& files);
+   static void GenerateReport(std::ostream* stream,
+      const LibItemSet& files, WarningRecords& records);
 
    //  Returns the explanation for warning W.
    //
@@ -207,13 +228,19 @@ private:
    //
    std::string GetNewFuncName() const;
 
-   //  Returns true if LOG2 > LOG1 when sorting by file/warning/line.
+   //  Returns the warning in the form that >check reports it.
+   //
+   WarningRecord GetRecord() const;
+
+   //  Returns true if REC2 > REC1 when sorting by file/warning/line.
    //
-   static bool IsSortedByFile(const CodeWarning* log1, const CodeWarning* log2);
+   static bool IsSortedByFile
+      (const WarningRecord& rec1, const WarningRecord& rec2);
 
-   //  Returns true if LOG2 > LOG1 when sorting by warning/file/line.
+   //  Returns true if REC2 > REC1 when sorting by warning/file/line.
    //
-   static bool IsSortedByType(const CodeWarning* log1, const CodeWarning* log2);
+   static bool IsSortedByType
+      (const WarningRecord& rec1, const WarningRecord& rec2);
 
    //  For inserting elements into the attributes map.
    //
@@ -46,7 +46,7 @@ CtModule::CtModule() : Module("ct")
 
    //  Create the modules required by CodeTools.
    //
-   Singleton<NtModule>::Instance();
+   Requires(*Singleton<NtModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
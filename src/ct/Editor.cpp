@@ -6783,6 +6783,8 @@ word Editor::Write() const
       return Report(stream, EditAbort);
    }
 
+   file_->CalcHash();
+
    const auto& warnings = file_->GetWarnings();
 
    for(auto w = warnings.begin(); w != warnings.end(); ++w)
@@ -0,0 +1,271 @@
+//==============================================================================
+//
+//  FileBitset.cpp
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "FileBitset.h"
+#include <algorithm>
+#include "CodeFile.h"
+#include "CodeFileSet.h"
+#include "Debug.h"
+#include "Library.h"
+#include "Singleton.h"
+
+using namespace NodeBase;
+
+//------------------------------------------------------------------------------
+
+namespace CodeTools
+{
+//  The number of bits in each word of a FileBitset.
+//
+constexpr size_t BitsPerWord = 64;
+
+//------------------------------------------------------------------------------
+
+FileBitset::FileBitset()
+{
+   Debug::ft("FileBitset.ctor");
+
+   auto count = Singleton<Library>::Instance()->FileCount();
+   words_.resize((count + BitsPerWord - 1) / BitsPerWord, 0);
+}
+
+//------------------------------------------------------------------------------
+
+fn_name FileBitset_ctor2 = "FileBitset.ctor(files)";
+
+FileBitset::FileBitset(const LibItemSet& files)
+{
+   Debug::ft(FileBitset_ctor2);
+
+   auto count = Singleton<Library>::Instance()->FileCount();
+   words_.resize((count + BitsPerWord - 1) / BitsPerWord, 0);
+
+   for(auto f = files.cbegin(); f != files.cend(); ++f)
+   {
+      auto file = dynamic_cast<const CodeFile*>(*f);
+      if(file != nullptr) Insert(file);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+FileBitset::~FileBitset()
+{
+   Debug::ftnt("FileBitset.dtor");
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::AddAffected()
+{
+   Debug::ft("FileBitset.AddAffected");
+
+   AddClosure(true);
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::AddAffecters()
+{
+   Debug::ft("FileBitset.AddAffecters");
+
+   AddClosure(false);
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::AddClosure(bool users)
+{
+   Debug::ft("FileBitset.AddClosure");
+
+   //  A file enters FRONTIER when it is added to the set, so the files that
+   //  are adjacent to it are only examined once.
+   //
+   auto library = Singleton<Library>::Instance();
+   std::vector<CodeFile*> frontier;
+
+   for(size_t w = 0; w < words_.size(); ++w)
+   {
+      auto bits = words_[w];
+
+      for(size_t b = 0; bits != 0; ++b, bits >>= 1)
+      {
+         if(bits & 1)
+         {
+            frontier.push_back(library->FileAt((w * BitsPerWord) + b));
+         }
+      }
+   }
+
+   while(!frontier.empty())
+   {
+      auto file = frontier.back();
+      frontier.pop_back();
+
+      const auto& next = (users ? file->UserList() : file->InclList());
+
+      for(auto f = next.cbegin(); f != next.cend(); ++f)
+      {
+         auto adjacent = static_cast<CodeFile*>(*f);
+         if(Insert(adjacent)) frontier.push_back(adjacent);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::Clear()
+{
+   Debug::ft("FileBitset.Clear");
+
+   for(size_t w = 0; w < words_.size(); ++w)
+   {
+      words_[w] = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool FileBitset::Contains(const CodeFile* file) const
+{
+   auto index = file->Index();
+   auto w = index / BitsPerWord;
+   if(w >= words_.size()) return false;
+   return ((words_[w] >> (index % BitsPerWord)) & 1);
+}
+
+//------------------------------------------------------------------------------
+
+size_t FileBitset::Count() const
+{
+   Debug::ft("FileBitset.Count");
+
+   size_t count = 0;
+
+   for(size_t w = 0; w < words_.size(); ++w)
+   {
+      //  Clear the lowest set bit until none remain.
+      //
+      for(auto bits = words_[w]; bits != 0; bits &= (bits - 1)) ++count;
+   }
+
+   return count;
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::Difference(const FileBitset& that)
+{
+   Debug::ft("FileBitset.Difference");
+
+   auto size = std::min(words_.size(), that.words_.size());
+
+   for(size_t w = 0; w < size; ++w)
+   {
+      words_[w] &= ~that.words_[w];
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool FileBitset::Empty() const
+{
+   Debug::ft("FileBitset.Empty");
+
+   for(size_t w = 0; w < words_.size(); ++w)
+   {
+      if(words_[w] != 0) return false;
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::GetItems(LibItemSet& items) const
+{
+   Debug::ft("FileBitset.GetItems");
+
+   //  Iterate over all files, which are sorted in the same order as ITEMS,
+   //  so that each file in the set can be appended to ITEMS in constant time.
+   //
+   const auto& files = Singleton<Library>::Instance()->Files().Items();
+
+   for(auto f = files.cbegin(); f != files.cend(); ++f)
+   {
+      if(Contains(static_cast<const CodeFile*>(*f)))
+      {
+         items.insert(items.cend(), *f);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool FileBitset::Insert(const CodeFile* file)
+{
+   auto index = file->Index();
+   Reserve(index);
+
+   auto& word = words_[index / BitsPerWord];
+   uint64_t mask = uint64_t(1) << (index % BitsPerWord);
+   if(word & mask) return false;
+   word |= mask;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::Intersection(const FileBitset& that)
+{
+   Debug::ft("FileBitset.Intersection");
+
+   for(size_t w = 0; w < words_.size(); ++w)
+   {
+      if(w < that.words_.size())
+         words_[w] &= that.words_[w];
+      else
+         words_[w] = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::Reserve(size_t index)
+{
+   auto size = (index / BitsPerWord) + 1;
+   if(words_.size() < size) words_.resize(size, 0);
+}
+
+//------------------------------------------------------------------------------
+
+void FileBitset::Union(const FileBitset& that)
+{
+   Debug::ft("FileBitset.Union");
+
+   if(words_.size() < that.words_.size()) words_.resize(that.words_.size(), 0);
+
+   for(size_t w = 0; w < that.words_.size(); ++w)
+   {
+      words_[w] |= that.words_[w];
+   }
+}
+}
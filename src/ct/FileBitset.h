@@ -0,0 +1,123 @@
+//==============================================================================
+//
+//  FileBitset.h
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FILEBITSET_H_INCLUDED
+#define FILEBITSET_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "LibraryItem.h"
+#include "LibraryTypes.h"
+
+//------------------------------------------------------------------------------
+
+namespace CodeTools
+{
+//  A set of code files in which each file is represented by the bit at its
+//  CodeFile::Index.  The set operations process 64 files at a time, which is
+//  much faster than merging two LibItemSets, and computing the transitive
+//  closure of the #include graph only has to visit each file once.
+//
+class FileBitset
+{
+public:
+   //  Creates an empty set that can hold every file in the library.
+   //
+   FileBitset();
+
+   //  Creates a set that contains FILES.  Items that are not code files are
+   //  ignored.
+   //
+   explicit FileBitset(const LibItemSet& files);
+
+   //  Copy constructor.
+   //
+   FileBitset(const FileBitset& that) = default;
+
+   //  Copy operator.
+   //
+   FileBitset& operator=(const FileBitset& that) = default;
+
+   //  Not subclassed.
+   //
+   ~FileBitset();
+
+   //  Returns true if FILE is in the set.
+   //
+   bool Contains(const CodeFile* file) const;
+
+   //  Adds FILE to the set.  Returns false if it was already in the set.
+   //
+   bool Insert(const CodeFile* file);
+
+   //  Removes all files from the set.
+   //
+   void Clear();
+
+   //  Returns the number of files in the set.
+   //
+   size_t Count() const;
+
+   //  Returns true if the set is empty.
+   //
+   bool Empty() const;
+
+   //  Implements this = this | that.
+   //
+   void Union(const FileBitset& that);
+
+   //  Implements this = this & that.
+   //
+   void Intersection(const FileBitset& that);
+
+   //  Implements this = this - that.
+   //
+   void Difference(const FileBitset& that);
+
+   //  Adds the files that transitively #include those in the set.
+   //
+   void AddAffected();
+
+   //  Adds the files that those in the set transitively #include.
+   //
+   void AddAffecters();
+
+   //  Adds the files in the set to ITEMS.
+   //
+   void GetItems(LibItemSet& items) const;
+private:
+   //  Adds the files that are transitively reachable from those in the set.
+   //  If USERS is set, follows UserList (the files that #include a file),
+   //  else follows InclList (the files that a file #includes).
+   //
+   void AddClosure(bool users);
+
+   //  Ensures that the set can hold the file at INDEX.
+   //
+   void Reserve(size_t index);
+
+   //  The files in the set, 64 to a word.
+   //
+   std::vector<uint64_t> words_;
+};
+}
+#endif
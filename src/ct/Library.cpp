@@ -107,7 +107,7 @@ Library::~Library()
 
 //------------------------------------------------------------------------------
 
-void Library::AddFile(CodeFile& file)
+size_t Library::AddFile(CodeFile& file)
 {
    Debug::ft("Library.AddFile");
 
@@ -132,6 +132,9 @@ void Library::AddFile(CodeFile& file)
    }
 
    if(file.IsExtFile()) extSet_->Items().insert(&file);
+
+   fileIndex_.push_back(&file);
+   return fileIndex_.size() - 1;
 }
 
 //------------------------------------------------------------------------------
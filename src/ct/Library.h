@@ -27,6 +27,7 @@
 #include <iosfwd>
 #include <list>
 #include <string>
+#include <vector>
 #include "LibraryTypes.h"
 #include "NbTypes.h"
 #include "SysTypes.h"
@@ -79,14 +80,23 @@ public:
    //
    CodeFile* EnsureFile(const std::string& file, CodeDir* dir = nullptr);
 
-   //  Adds FILE to the code base.
+   //  Adds FILE to the code base and returns the index assigned to it.
+   //  Files are indexed in the order in which they were added.
    //
-   void AddFile(CodeFile& file);
+   size_t AddFile(CodeFile& file);
 
    //  Returns the file identified by NAME.
    //
    CodeFile* FindFile(const std::string& name) const;
 
+   //  Returns the number of files in the code base.
+   //
+   size_t FileCount() const { return fileIndex_.size(); }
+
+   //  Returns the file whose index is INDEX.
+   //
+   CodeFile* FileAt(size_t index) const { return fileIndex_.at(index); }
+
    //  Adds VAR to the list of variables.
    //
    void AddVar(LibrarySet& var);
@@ -203,6 +213,10 @@ private:
    //
    std::list< std::unique_ptr <CodeFile>> files_;
 
+   //  The files in the code base, indexed by CodeFile::Index.
+   //
+   std::vector<CodeFile*> fileIndex_;
+
    //  The currently defined variables.  Sorted by name, ignoring case.
    //
    std::list<LibrarySet*> vars_;
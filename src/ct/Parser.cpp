@@ -27,6 +27,7 @@
 #include <sstream>
 #include <utility>
 #include "CodeFile.h"
+#include "CoutThread.h"
 #include "CxxArea.h"
 #include "CxxCharLiteral.h"
 #include "CxxDirective.h"
@@ -43,6 +44,7 @@
 #include "Formatters.h"
 #include "Log.h"
 #include "Singleton.h"
+#include "ThisThread.h"
 
 using namespace NodeBase;
 using std::ostream;
@@ -135,6 +137,20 @@ static bool SetCompoundType
    return false;
 }
 
+//------------------------------------------------------------------------------
+//
+//  Writes S to the console while parsing.  This yields rather than invoking
+//  Debug::Progress, which sleeps for 10 msecs, because it is invoked for each
+//  file and template instance that is parsed.
+//
+static void ShowProgress(const string& s)
+{
+   Debug::ft("CodeTools.ShowProgress");
+
+   CoutThread::Spool(s.c_str());
+   ThisThread::Pause();
+}
+
 //------------------------------------------------------------------------------
 
 Parser::Parser() :
@@ -4293,7 +4309,7 @@ bool Parser::Parse(CodeFile& file)
    //  the console.
    //
    if(file.ParseStatus() != CodeFile::Unparsed) return true;
-   Debug::Progress(file.Name());
+   ShowProgress(file.Name());
 
    //  Initialize the parser and note the file being parsed.  Push the global
    //  namespace as the current scope and start parsing at file scope.
@@ -4312,7 +4328,7 @@ bool Parser::Parse(CodeFile& file)
    auto parsed = lexer_.Eof();
    Context::SetFile(nullptr);
    file.SetParsed(parsed);
-   Debug::Progress((parsed ? CRLF_STR : string(" **FAILED** ") + CRLF));
+   ShowProgress((parsed ? CRLF_STR : string(" **FAILED** ") + CRLF));
    if(!parsed) Failure(venue_);
    return parsed;
 }
@@ -4328,7 +4344,7 @@ bool Parser::ParseClassInst(ClassInst* inst, size_t pos)
       stopped = Context::StopTracing();
 
    auto name = inst->ScopedName(true);
-   Debug::Progress(CRLF + Indent() + name);
+   ShowProgress(CRLF + Indent() + name);
 
    //  Initialize the parser.  If an "object code" file is being produced,
    //  insert the instance name.
@@ -4368,7 +4384,7 @@ bool Parser::ParseClassInst(ClassInst* inst, size_t pos)
    //  is being produced, indicate that parsing of the template is complete.
    //
    auto parsed = lexer_.Eof();
-   Debug::Progress((parsed ? EMPTY_STR : " **FAILED** "));
+   ShowProgress((parsed ? EMPTY_STR : " **FAILED** "));
    if(!parsed) Failure(venue_);
    Context::Trace(CxxTrace::END_TEMPLATE);
 
@@ -4437,7 +4453,7 @@ Function* Parser::ParseFuncInst(const std::string& name, const Function* tmplt,
    if(!Context::OptionIsOn(TraceInstantiation))
       stopped = Context::StopTracing();
 
-   Debug::Progress(CRLF + Indent() + name);
+   ShowProgress(CRLF + Indent() + name);
 
    //  Initialize the parser.  If an "object code" file is being produced,
    //  insert the instance name.
@@ -4472,7 +4488,7 @@ Function* Parser::ParseFuncInst(const std::string& name, const Function* tmplt,
    //  is being produced, indicate that parsing of the template is complete.
    //
    parsed = lexer_.Eof();
-   Debug::Progress((parsed ? EMPTY_STR : " **FAILED** "));
+   ShowProgress((parsed ? EMPTY_STR : " **FAILED** "));
    if(!parsed) Failure(venue_);
    Context::Trace(CxxTrace::END_TEMPLATE);
 
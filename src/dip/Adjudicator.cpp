@@ -222,6 +222,59 @@ void MapAndUnits::adjudicate_retreats()
 
 //------------------------------------------------------------------------------
 
+void MapAndUnits::adjudicate_what_if(const GameSnapshot& snapshot,
+   const WhatIfOrders& orders, WhatIfResults& results)
+{
+   Debug::ft("MapAndUnits.adjudicate_what_if");
+
+   //  Replace the position with SNAPSHOT and enter ORDERS, which are set
+   //  the same way as by set_hold_order, set_move_order, and so on.
+   //
+   restore_snapshot(snapshot);
+
+   for(auto o = orders.cbegin(); o != orders.cend(); ++o)
+   {
+      if((o->order < HOLD_ORDER) || (o->order > MOVE_BY_CONVOY_ORDER))
+         continue;
+
+      auto u = units.find(o->unit);
+      if(u == units.end()) continue;
+
+      auto& unit = u->second;
+      unit.order = o->order;
+      unit.dest = o->dest;
+      unit.client_loc = o->client_loc;
+      unit.client_dest = o->client_dest;
+      unit.convoyers = o->convoyers;
+      if(o->order == MOVE_BY_CONVOY_ORDER) unit.dest.coast = TOKEN_UNIT_AMY;
+   }
+
+   adjudicate_moves();
+
+   //  Report the outcome for each unit.  Unlike apply_adjudication, this
+   //  does not move any units, so the position can be restored cheaply
+   //  for the next set of orders.
+   //
+   results.clear();
+
+   for(auto u = units.cbegin(); u != units.cend(); ++u)
+   {
+      const auto& unit = u->second;
+      WhatIfResult result;
+
+      result.unit = u->first;
+      result.loc = (unit.unit_moves ? unit.dest : unit.loc);
+      result.unit_moves = unit.unit_moves;
+      result.bounce = unit.bounce;
+      result.dislodged = unit.dislodged;
+      result.support_cut = unit.support_cut;
+      result.convoy_disrupted = unit.convoy_disrupted;
+      results.push_back(result);
+   }
+}
+
+//------------------------------------------------------------------------------
+
 void MapAndUnits::advance_attack_rings()
 {
    Debug::ft("MapAndUnits.advance_attack_rings");
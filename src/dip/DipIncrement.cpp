@@ -0,0 +1,357 @@
+//==============================================================================
+//
+//  DipIncrement.cpp
+//
+//  Diplomacy AI Client - Part of the DAIDE project (www.daide.org.uk).
+//
+//  (C) David Norman 2002 david@ellought.demon.co.uk
+//  (C) Greg Utas 2019-2025 greg@pentennea.com
+//
+//  This software may be reused for non-commercial purposes without charge,
+//  and without notifying the authors.  Use of any part of this software for
+//  commercial purposes without permission from the authors is prohibited.
+//
+#include "DipIncrement.h"
+#include "CliCommand.h"
+#include <cstddef>
+#include <cstdio>
+#include <iomanip>
+#include <ios>
+#include <istream>
+#include <string>
+#include <vector>
+#include "Algorithms.h"
+#include "CliIntParm.h"
+#include "CliTextParm.h"
+#include "CliThread.h"
+#include "Debug.h"
+#include "Duration.h"
+#include "Element.h"
+#include "FileSystem.h"
+#include "Formatters.h"
+#include "MapAndUnits.h"
+#include "NbCliParms.h"
+#include "Singleton.h"
+#include "Snapshot.h"
+#include "SteadyTime.h"
+#include "SysTypes.h"
+#include "Token.h"
+#include "TokenMessage.h"
+#include "WhatIfEngine.h"
+
+//------------------------------------------------------------------------------
+
+namespace Diplomacy
+{
+//  Returns the location at offset N in LOCS.
+//
+static const Location& LocationAt(const LocationSet& locs, size_t n)
+{
+   auto loc = locs.cbegin();
+   for(NO_OP; n > 0; --n) ++loc;
+   return *loc;
+}
+
+//------------------------------------------------------------------------------
+//
+//  Adds COUNT random sets of orders for the units in MAP to ORDERS.  Each
+//  unit holds, moves to a neighbouring location, or supports a neighbouring
+//  unit to hold.
+//
+static void GenerateOrders
+   (const MapAndUnits& map, size_t count, std::vector<WhatIfOrders>& orders)
+{
+   Debug::ft("Diplomacy.GenerateOrders");
+
+   for(size_t n = 0; n < count; ++n)
+   {
+      WhatIfOrders set;
+
+      for(auto u = map.units.cbegin(); u != map.units.cend(); ++u)
+      {
+         WhatIfOrder order;
+         order.unit = u->first;
+
+         auto dests = map.get_destinations(u->first);
+
+         if((dests != nullptr) && !dests->empty())
+         {
+            const auto& dest = LocationAt(*dests, rand(0, dests->size() - 1));
+
+            switch(rand(0, 3))
+            {
+            case 1:
+            case 2:
+               order.order = MOVE_ORDER;
+               order.dest = dest;
+               break;
+
+            case 3:
+               if(map.units.find(dest.province) != map.units.cend())
+               {
+                  order.order = SUPPORT_TO_HOLD_ORDER;
+                  order.client_loc = dest.province;
+               }
+            }
+         }
+
+         set.push_back(order);
+      }
+
+      orders.push_back(set);
+   }
+}
+
+//------------------------------------------------------------------------------
+//
+//  Passes TEXT, a DAIDE message in text form, to MAP.  Returns false if the
+//  message is invalid or is not an MDF, SCO, or NOW message.
+//
+static bool ProcessMessage(MapAndUnits& map, const std::string& text)
+{
+   Debug::ft("Diplomacy.ProcessMessage");
+
+   TokenMessage message;
+   if(message.set_from(text) != NO_ERROR) return false;
+   if(message.size() == 0) return false;
+
+   auto signal = message.front();
+   auto rc = NO_ERROR;
+
+   if(signal == TOKEN_COMMAND_MDF)
+      rc = map.process_mdf(message);
+   else if(signal == TOKEN_COMMAND_SCO)
+      rc = map.process_sco(message);
+   else if(signal == TOKEN_COMMAND_NOW)
+      rc = map.process_now(message);
+   else
+      return false;
+
+   return (rc == NO_ERROR);
+}
+
+//------------------------------------------------------------------------------
+//
+//  Returns true if the results in ACTUAL match those in EXPECTED.
+//
+static bool SameResults(const std::vector<WhatIfResults>& actual,
+   const std::vector<WhatIfResults>& expected)
+{
+   Debug::ft("Diplomacy.SameResults");
+
+   if(actual.size() != expected.size()) return false;
+
+   for(size_t n = 0; n < actual.size(); ++n)
+   {
+      auto& set1 = actual[n];
+      auto& set2 = expected[n];
+
+      if(set1.size() != set2.size()) return false;
+
+      for(size_t u = 0; u < set1.size(); ++u)
+      {
+         auto& r1 = set1[u];
+         auto& r2 = set2[u];
+
+         if((r1.unit != r2.unit) ||
+            (r1.loc.province != r2.loc.province) ||
+            (r1.loc.coast != r2.loc.coast) ||
+            (r1.unit_moves != r2.unit_moves) ||
+            (r1.bounce != r2.bounce) ||
+            (r1.dislodged != r2.dislodged) ||
+            (r1.support_cut != r2.support_cut) ||
+            (r1.convoy_disrupted != r2.convoy_disrupted)) return false;
+      }
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//  The LOADMAP command.
+//
+class LoadMapCommand : public CliCommand
+{
+public:
+   LoadMapCommand();
+private:
+   word ProcessCommand(CliThread& cli) const override;
+};
+
+fixed_string LoadMapFileExpl = "read messages from <str>.txt";
+
+fixed_string LoadMapStr = "loadmap";
+fixed_string LoadMapExpl = "Loads a map and position from a file.";
+
+LoadMapCommand::LoadMapCommand() : CliCommand(LoadMapStr, LoadMapExpl)
+{
+   BindParm(*new CliTextParm(LoadMapFileExpl, false, 0));
+}
+
+word LoadMapCommand::ProcessCommand(CliThread& cli) const
+{
+   Debug::ft("LoadMapCommand.ProcessCommand");
+
+   std::string name;
+
+   if(!GetString(name, cli)) return -1;
+   if(!cli.EndOfInput()) return -1;
+
+   auto path = Element::InputPath() + PATH_SEPARATOR + name + ".txt";
+   auto stream = FileSystem::CreateIstream(path.c_str());
+   if(stream == nullptr) return cli.Report(-2, NoFileExpl);
+
+   //  The file contains MDF, SCO, and NOW messages in text form.  A message
+   //  can span several lines and ends at an empty line.  A line that starts
+   //  with a '/' is a comment.
+   //
+   auto map = MapAndUnits::instance();
+   std::string input;
+   std::string text;
+   size_t line = 0;
+   size_t count = 0;
+
+   while(true)
+   {
+      auto eof = (stream->peek() == EOF);
+
+      if(!eof)
+      {
+         FileSystem::GetLine(*stream, input);
+         ++line;
+         if(!input.empty() && (input.front() == '/')) continue;
+      }
+
+      if(eof || input.empty())
+      {
+         if(!text.empty())
+         {
+            if(!ProcessMessage(*map, text))
+            {
+               std::string expl("Invalid message ending on line ");
+               return cli.Report(-3, expl + std::to_string(line));
+            }
+
+            text.clear();
+            ++count;
+         }
+
+         if(eof) break;
+         continue;
+      }
+
+      text += SPACE;
+      text += input;
+   }
+
+   *cli.obuf << spaces(2) << "Messages loaded: " << count << CRLF;
+   *cli.obuf << spaces(2) << "Provinces: " << map->number_of_provinces << CRLF;
+   *cli.obuf << spaces(2) << "Units: " << map->units.size() << CRLF;
+   return cli.Report(0, SuccessExpl);
+}
+
+//------------------------------------------------------------------------------
+//
+//  The WHATIF command.
+//
+fixed_string WhatIfCountExpl = "number of sets of orders to adjudicate";
+fixed_string WhatIfThreadsExpl = "maximum number of threads (default=1)";
+
+class WhatIfCommand : public CliCommand
+{
+public:
+   WhatIfCommand();
+private:
+   word ProcessCommand(CliThread& cli) const override;
+};
+
+fixed_string WhatIfStr = "whatif";
+fixed_string WhatIfExpl = "Measures how fast random orders are adjudicated.";
+
+WhatIfCommand::WhatIfCommand() : CliCommand(WhatIfStr, WhatIfExpl)
+{
+   BindParm(*new CliIntParm(WhatIfCountExpl, 1, 1000000));
+   BindParm(*new CliIntParm
+      (WhatIfThreadsExpl, 1, WhatIfEngine::MaxThreads, true));
+}
+
+fixed_string NoMapExpl = "A map has not been received or loaded.";
+
+word WhatIfCommand::ProcessCommand(CliThread& cli) const
+{
+   Debug::ft("WhatIfCommand.ProcessCommand");
+
+   word count, threads = 1;
+
+   if(!GetIntParm(count, cli)) return -1;
+   if(GetIntParmRc(threads, cli) == Error) return -1;
+   if(!cli.EndOfInput()) return -1;
+
+   auto map = MapAndUnits::instance();
+   if(map->number_of_provinces == 0) return cli.Report(-2, NoMapExpl);
+
+   GameSnapshot snapshot;
+   std::vector<WhatIfOrders> orders;
+   std::vector<WhatIfResults> results;
+   std::vector<WhatIfResults> expected;
+
+   map->take_snapshot(snapshot);
+   GenerateOrders(*map, count, orders);
+
+   //  Adjudicate the orders with 1, 2, 4... threads, up to THREADS.  The
+   //  results must be the same however many threads are used.
+   //
+   auto engine = Singleton<WhatIfEngine>::Instance();
+   *cli.obuf << "  threads  msecs  adjudications/sec" << CRLF;
+
+   for(word t = 1; true; t <<= 1)
+   {
+      if(t > threads) t = threads;
+
+      auto time0 = SteadyTime::Now();
+      if(!engine->Adjudicate(snapshot, orders, results, t))
+         return cli.Report(-3, "Adjudication failed.");
+      nsecs_t elapsed = SteadyTime::Now() - time0;
+
+      auto usecs = elapsed.count() / NS_TO_US;
+      if(usecs == 0) usecs = 1;
+      auto rate = (count * 1000000) / usecs;
+
+      *cli.obuf << std::setw(9) << t;
+      *cli.obuf << std::setw(7) << usecs / 1000;
+      *cli.obuf << std::setw(19) << rate << CRLF;
+
+      if(t == 1)
+         expected.swap(results);
+      else if(!SameResults(results, expected))
+         return cli.Report(-4, "Results differed from those of one thread.");
+
+      if(t == threads) break;
+   }
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//  The Diplomacy increment.
+//
+fixed_string DipText = "dip";
+fixed_string DipExpl = "Diplomacy Increment";
+
+DipIncrement::DipIncrement() : CliIncrement(DipText, DipExpl)
+{
+   Debug::ft("DipIncrement.ctor");
+
+   BindCommand(*new LoadMapCommand);
+   BindCommand(*new WhatIfCommand);
+}
+
+//------------------------------------------------------------------------------
+
+DipIncrement::~DipIncrement()
+{
+   Debug::ftnt("DipIncrement.dtor");
+}
+}
@@ -0,0 +1,41 @@
+//==============================================================================
+//
+//  DipIncrement.h
+//
+//  Diplomacy AI Client - Part of the DAIDE project (www.daide.org.uk).
+//
+//  (C) David Norman 2002 david@ellought.demon.co.uk
+//  (C) Greg Utas 2019-2025 greg@pentennea.com
+//
+//  This software may be reused for non-commercial purposes without charge,
+//  and without notifying the authors.  Use of any part of this software for
+//  commercial purposes without permission from the authors is prohibited.
+//
+#ifndef DIPINCREMENT_H_INCLUDED
+#define DIPINCREMENT_H_INCLUDED
+
+#include "CliIncrement.h"
+#include "NbTypes.h"
+
+using namespace NodeBase;
+
+//------------------------------------------------------------------------------
+
+namespace Diplomacy
+{
+//  The increment that provides Diplomacy commands.
+//
+class DipIncrement : public CliIncrement
+{
+   friend class Singleton<DipIncrement>;
+
+   //  Private because this is a singleton.
+   //
+   DipIncrement();
+
+   //  Private because this is a singleton.
+   //
+   ~DipIncrement();
+};
+}
+#endif
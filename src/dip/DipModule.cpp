@@ -25,10 +25,12 @@
 #include "BotThread.h"
 #include "BotTracer.h"
 #include "Debug.h"
+#include "DipIncrement.h"
 #include "DipProtocol.h"
 #include "ModuleRegistry.h"
 #include "NwModule.h"
 #include "Singleton.h"
+#include "WhatIfEngine.h"
 
 using namespace NodeBase;
 using namespace NetworkBase;
@@ -43,7 +45,7 @@ DipModule::DipModule() : Module("dip")
 
    //  Create the modules required by Diplomacy.
    //
-   Singleton<NwModule>::Instance();
+   Requires(*Singleton<NwModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
@@ -62,6 +64,8 @@ void DipModule::Enable()
 void DipModule::Shutdown(RestartLevel level)
 {
    Debug::ft("DipModule.Shutdown");
+
+   Singleton<WhatIfEngine>::Instance()->Shutdown(level);
 }
 
 //------------------------------------------------------------------------------
@@ -74,5 +78,7 @@ void DipModule::Startup(RestartLevel level)
    Singleton<BotTcpService>::Instance()->Startup(level);
    Singleton<BotTracer>::Instance();
    Singleton<BotThread>::Instance()->Startup(level);
+   Singleton<DipIncrement>::Instance()->Startup(level);
+   Singleton<WhatIfEngine>::Instance();
 }
 }
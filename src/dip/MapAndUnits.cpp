@@ -2461,6 +2461,72 @@ Token MapAndUnits::province_token(ProvinceId province) const
 
 //------------------------------------------------------------------------------
 
+void MapAndUnits::restore_snapshot(const GameSnapshot& snapshot)
+{
+   Debug::ft("MapAndUnits.restore_snapshot");
+
+   curr_season = snapshot.season;
+   curr_year = snapshot.year;
+
+   for(ProvinceId p = 0; p < number_of_provinces; ++p)
+   {
+      game_map[p].owner = snapshot.owners[p];
+   }
+
+   //  When many sets of orders are adjudicated against the same snapshot,
+   //  the units usually occupy the provinces that the snapshot does, so the
+   //  map of units need not be rebuilt.  But each unit must still be reset from
+   //  the snapshot.  Adjudication leaves fields such as dest and ring_status
+   //  set, and advance_attack_rings can even overwrite one unit with a copy
+   //  of another.  Either would affect the outcome of the next set.
+   //
+   size_t count = 0;
+   auto same = true;
+
+   for(ProvinceId p = 0; (p < number_of_provinces) && same; ++p)
+   {
+      const auto& snap = snapshot.units[p];
+      if(snap.unit_type == INVALID_TOKEN) continue;
+      ++count;
+
+      same = (units.find(p) != units.end());
+   }
+
+   if(same && (count == units.size()))
+   {
+      for(auto u = units.begin(); u != units.end(); ++u)
+      {
+         const auto& snap = snapshot.units[u->first];
+         UnitOrder unit;
+
+         unit.loc = Location(u->first, snap.coast);
+         unit.owner = snap.owner;
+         unit.unit_type = snap.unit_type;
+         u->second = unit;
+      }
+
+      dislodged_units.clear();
+      return;
+   }
+
+   units.clear();
+   dislodged_units.clear();
+
+   for(ProvinceId p = 0; p < number_of_provinces; ++p)
+   {
+      const auto& snap = snapshot.units[p];
+      if(snap.unit_type == INVALID_TOKEN) continue;
+
+      UnitOrder unit;
+      unit.loc = Location(p, snap.coast);
+      unit.owner = snap.owner;
+      unit.unit_type = snap.unit_type;
+      units.insert(UnitOrderMap::value_type(p, unit));
+   }
+}
+
+//------------------------------------------------------------------------------
+
 void MapAndUnits::set_build_order(const Location& location)
 {
    Debug::ft("MapAndUnits.set_build_order");
@@ -2733,6 +2799,31 @@ void MapAndUnits::set_waive_order()
 
 //------------------------------------------------------------------------------
 
+void MapAndUnits::take_snapshot(GameSnapshot& snapshot) const
+{
+   Debug::ft("MapAndUnits.take_snapshot");
+
+   snapshot.season = curr_season;
+   snapshot.year = curr_year;
+   snapshot.number_of_provinces = number_of_provinces;
+
+   for(ProvinceId p = 0; p < number_of_provinces; ++p)
+   {
+      snapshot.owners[p] = game_map[p].owner;
+      snapshot.units[p] = UnitSnapshot();
+   }
+
+   for(auto u = units.cbegin(); u != units.cend(); ++u)
+   {
+      auto& snap = snapshot.units[u->first];
+      snap.unit_type = u->second.unit_type;
+      snap.owner = u->second.owner;
+      snap.coast = u->second.loc.coast;
+   }
+}
+
+//------------------------------------------------------------------------------
+
 bool MapAndUnits::unorder_adjustment(const TokenMessage& not_sub, PowerId power)
 {
    Debug::ft("MapAndUnits.unorder_adjustment");
@@ -22,6 +22,7 @@
 #include "DipTypes.h"
 #include "Location.h"
 #include "Province.h"
+#include "Snapshot.h"
 #include "SysTypes.h"
 #include "Token.h"
 #include "TokenMessage.h"
@@ -308,6 +309,19 @@ public:
    //
    void adjudicate();
 
+   //  Captures the variable part of the current position in SNAPSHOT.
+   //
+   void take_snapshot(GameSnapshot& snapshot) const;
+
+   //  Replaces the current position with SNAPSHOT, adjudicates ORDERS as
+   //  movement orders, and updates RESULTS with the outcome for each unit.
+   //  Must only be used on a clone (see create_clone), whose position it
+   //  overwrites.  Adjudicating many sets of orders against the same
+   //  snapshot is much cheaper than creating a clone for each one.
+   //
+   void adjudicate_what_if(const GameSnapshot& snapshot,
+      const WhatIfOrders& orders, WhatIfResults& results);
+
    //  Builds ORD messages to report the results of adjudication.  Returns
    //  the number of messages built.
    //
@@ -361,6 +375,10 @@ private:
    //
    void set_our_power(const Token& token);
 
+   //  Used to implement adjudicate_what_if.
+   //
+   void restore_snapshot(const GameSnapshot& snapshot);
+
    //  Used to implement process_now.
    //
    size_t process_now_unit(const TokenMessage& unit_parm);
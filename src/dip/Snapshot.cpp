@@ -0,0 +1,55 @@
+//==============================================================================
+//
+//  Snapshot.cpp
+//
+//  Diplomacy AI Client - Part of the DAIDE project (www.daide.org.uk).
+//
+//  (C) David Norman 2002 david@ellought.demon.co.uk
+//  (C) Greg Utas 2019-2025 greg@pentennea.com
+//
+//  This software may be reused for non-commercial purposes without charge,
+//  and without notifying the authors.  Use of any part of this software for
+//  commercial purposes without permission from the authors is prohibited.
+//
+#include "Snapshot.h"
+
+//------------------------------------------------------------------------------
+
+namespace Diplomacy
+{
+UnitSnapshot::UnitSnapshot() :
+   owner(NIL_POWER),
+   coast(INVALID_TOKEN)
+{
+}
+
+//==============================================================================
+
+GameSnapshot::GameSnapshot() :
+   year(0),
+   number_of_provinces(0)
+{
+}
+
+//==============================================================================
+
+WhatIfOrder::WhatIfOrder() :
+   unit(NIL_PROVINCE),
+   order(HOLD_ORDER),
+   client_loc(NIL_PROVINCE),
+   client_dest(NIL_PROVINCE)
+{
+}
+
+//==============================================================================
+
+WhatIfResult::WhatIfResult() :
+   unit(NIL_PROVINCE),
+   unit_moves(false),
+   bounce(false),
+   dislodged(false),
+   support_cut(false),
+   convoy_disrupted(false)
+{
+}
+}
@@ -0,0 +1,103 @@
+//==============================================================================
+//
+//  Snapshot.h
+//
+//  Diplomacy AI Client - Part of the DAIDE project (www.daide.org.uk).
+//
+//  (C) David Norman 2002 david@ellought.demon.co.uk
+//  (C) Greg Utas 2019-2025 greg@pentennea.com
+//
+//  This software may be reused for non-commercial purposes without charge,
+//  and without notifying the authors.  Use of any part of this software for
+//  commercial purposes without permission from the authors is prohibited.
+//
+#ifndef SNAPSHOT_H_INCLUDED
+#define SNAPSHOT_H_INCLUDED
+
+#include <vector>
+#include "DipTypes.h"
+#include "Location.h"
+#include "Token.h"
+#include "UnitOrder.h"
+
+//------------------------------------------------------------------------------
+
+namespace Diplomacy
+{
+//  A unit in a GameSnapshot.  Its unit_type is INVALID_TOKEN if the province
+//  does not contain a unit.
+//
+struct UnitSnapshot
+{
+   Token unit_type;  // army or fleet
+   PowerId owner;    // unit's owner
+   Token coast;      // unit's coast (see Location.coast)
+
+   //  Initializes members to default values.
+   //
+   UnitSnapshot();
+};
+
+//  The variable part of a game position, in arrays indexed by ProvinceId.
+//  Unlike MapAndUnits, it contains no map details or containers, so it can
+//  be copied cheaply.  Dislodged units are not included, so a snapshot can
+//  only be used to adjudicate movement orders.
+//
+struct GameSnapshot
+{
+   Token season;                        // season of play
+   int year;                            // year of play
+   ProvinceId number_of_provinces;      // number of provinces on map
+   Token owners[PROVINCE_MAX];          // owner of each supply centre
+   UnitSnapshot units[PROVINCE_MAX];    // unit in each province
+
+   //  Initializes members to default values.
+   //
+   GameSnapshot();
+};
+
+//  A hypothetical movement order.  Its fields have the same meaning as
+//  those of the same name in UnitOrder.
+//
+struct WhatIfOrder
+{
+   ProvinceId unit;         // location of unit being ordered
+   OrderType order;         // HOLD_ORDER to MOVE_BY_CONVOY_ORDER
+   Location dest;           // destination of unit being ordered
+   ProvinceId client_loc;   // location of unit being supported or convoyed
+   ProvinceId client_dest;  // destination of supported or convoyed unit
+   UnitList convoyers;      // fleets specified by an army's convoy order
+
+   //  Initializes members to default values.
+   //
+   WhatIfOrder();
+};
+
+//  A set of hypothetical orders.  A unit that is not ordered holds.
+//
+typedef std::vector<WhatIfOrder> WhatIfOrders;
+
+//  The outcome for a unit after adjudicating WhatIfOrders.  Its fields
+//  have the same meaning as those of the same name in UnitOrder.
+//
+struct WhatIfResult
+{
+   ProvinceId unit;        // unit's location before adjudication
+   Location loc;           // unit's location after adjudication
+   bool unit_moves;        // move was successful
+   bool bounce;            // move bounced
+   bool dislodged;         // unit was dislodged
+   bool support_cut;       // support cut by an attack
+   bool convoy_disrupted;  // convoying fleet dislodged: convoy failed
+
+   //  Initializes members to default values.
+   //
+   WhatIfResult();
+};
+
+//  The outcome for each unit after adjudicating WhatIfOrders, in order of
+//  the units' initial locations.
+//
+typedef std::vector<WhatIfResult> WhatIfResults;
+}
+#endif
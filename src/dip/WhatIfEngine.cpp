@@ -0,0 +1,322 @@
+//==============================================================================
+//
+//  WhatIfEngine.cpp
+//
+//  Diplomacy AI Client - Part of the DAIDE project (www.daide.org.uk).
+//
+//  (C) David Norman 2002 david@ellought.demon.co.uk
+//  (C) Greg Utas 2019-2025 greg@pentennea.com
+//
+//  This software may be reused for non-commercial purposes without charge,
+//  and without notifying the authors.  Use of any part of this software for
+//  commercial purposes without permission from the authors is prohibited.
+//
+#include "WhatIfEngine.h"
+#include <ostream>
+#include <string>
+#include "Debug.h"
+#include "Formatters.h"
+#include "FunctionGuard.h"
+#include "MapAndUnits.h"
+#include "Singleton.h"
+#include "SysTypes.h"
+
+using std::ostream;
+using std::string;
+
+//------------------------------------------------------------------------------
+
+namespace Diplomacy
+{
+WhatIfEngine::WhatIfEngine() :
+   snapshot_(nullptr),
+   orders_(nullptr),
+   results_(nullptr),
+   next_(0),
+   running_(0),
+   client_(nullptr)
+{
+   Debug::ft("WhatIfEngine.ctor");
+
+   for(size_t t = 0; t < MaxThreads; ++t)
+   {
+      threads_[t] = nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+fn_name WhatIfEngine_dtor = "WhatIfEngine.dtor";
+
+WhatIfEngine::~WhatIfEngine()
+{
+   Debug::ftnt(WhatIfEngine_dtor);
+
+   Debug::SwLog(WhatIfEngine_dtor, UnexpectedInvocation, 0);
+}
+
+//------------------------------------------------------------------------------
+
+bool WhatIfEngine::Adjudicate(const GameSnapshot& snapshot,
+   const std::vector<WhatIfOrders>& orders,
+   std::vector<WhatIfResults>& results, size_t threads)
+{
+   Debug::ft("WhatIfEngine.Adjudicate");
+
+   if(running_ > 0) return false;
+
+   auto map = MapAndUnits::instance();
+   if(map->number_of_provinces == 0) return false;
+
+   results.clear();
+   results.resize(orders.size());
+   if(orders.empty()) return true;
+
+   if(threads == 0) threads = 1;
+   if(threads > MaxThreads) threads = MaxThreads;
+   if(threads > orders.size()) threads = orders.size();
+
+   snapshot_ = &snapshot;
+   orders_ = &orders;
+   results_ = &results;
+   next_ = 0;
+   running_ = threads;
+   client_ = Thread::RunningThread();
+
+   //  Reuse the threads that adjudicated previous batches, creating them
+   //  as needed.  Each one gets a new clone, which is created here because
+   //  this thread, unlike the others, cannot run while the bot is updating
+   //  the singleton instance.
+   //
+   for(size_t t = 0; t < threads; ++t)
+   {
+      if(threads_[t] == nullptr) threads_[t] = new WhatIfThread(t);
+      threads_[t]->Assign();
+   }
+
+   //  Sleep until the last thread finishes.  Another interrupt (such as
+   //  for a message) can also end the pause, so keep pausing until then.
+   //
+   while(running_ > 0)
+   {
+      Thread::Pause(TIMEOUT_NEVER);
+   }
+
+   snapshot_ = nullptr;
+   orders_ = nullptr;
+   results_ = nullptr;
+   client_ = nullptr;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfEngine::Display(ostream& stream,
+   const string& prefix, const Flags& options) const
+{
+   Permanent::Display(stream, prefix, options);
+
+   stream << prefix << "snapshot : " << snapshot_ << CRLF;
+   stream << prefix << "orders   : " << orders_ << CRLF;
+   stream << prefix << "results  : " << results_ << CRLF;
+   stream << prefix << "next     : " << next_.load() << CRLF;
+   stream << prefix << "running  : " << running_.load() << CRLF;
+   stream << prefix << "client   : " << client_ << CRLF;
+
+   stream << prefix << "threads  : " << CRLF;
+
+   for(size_t t = 0; t < MaxThreads; ++t)
+   {
+      if(threads_[t] == nullptr) continue;
+      stream << prefix << spaces(2) << strIndex(t) << threads_[t] << CRLF;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfEngine::Patch(sel_t selector, void* arguments)
+{
+   Permanent::Patch(selector, arguments);
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfEngine::Process(MapAndUnits& clone)
+{
+   Debug::ft("WhatIfEngine.Process");
+
+   auto size = orders_->size();
+
+   for(auto n = next_.fetch_add(1); n < size; n = next_.fetch_add(1))
+   {
+      clone.adjudicate_what_if(*snapshot_, orders_->at(n), results_->at(n));
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfEngine::Shutdown(RestartLevel level)
+{
+   Debug::ft("WhatIfEngine.Shutdown");
+
+   //  Our threads are destroyed during a restart, so any batch that was in
+   //  progress has been abandoned.
+   //
+   snapshot_ = nullptr;
+   orders_ = nullptr;
+   results_ = nullptr;
+   next_ = 0;
+   running_ = 0;
+   client_ = nullptr;
+
+   for(size_t t = 0; t < MaxThreads; ++t)
+   {
+      threads_[t] = nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfEngine::ThreadDeleted(size_t index, const WhatIfThread* thread)
+{
+   Debug::ftnt("WhatIfEngine.ThreadDeleted");
+
+   if(threads_[index] == thread) threads_[index] = nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfEngine::ThreadDone()
+{
+   Debug::ftnt("WhatIfEngine.ThreadDone");
+
+   //  This runs unpreemptably, as does the client, so the client cannot
+   //  see running_ reach zero before it is interrupted.  After a restart,
+   //  a thread that is being deleted may report a batch that Shutdown has
+   //  already abandoned.
+   //
+   if(running_ == 0) return;
+
+   if(--running_ == 0)
+   {
+      if(client_ != nullptr) client_->Interrupt(Thread::ResumeExecution);
+   }
+}
+
+//==============================================================================
+
+WhatIfThread::WhatIfThread(size_t index) : Thread(PayloadFaction),
+   index_(index),
+   clone_(nullptr),
+   assigned_(false),
+   busy_(false)
+{
+   Debug::ft("WhatIfThread.ctor");
+
+   SetInitialized();
+}
+
+//------------------------------------------------------------------------------
+
+WhatIfThread::~WhatIfThread()
+{
+   Debug::ftnt("WhatIfThread.dtor");
+
+   //  If we were assigned a batch, report that we're done with it so that
+   //  the engine's client doesn't wait forever.
+   //
+   auto engine = Singleton<WhatIfEngine>::Extant();
+
+   if(engine != nullptr)
+   {
+      if(assigned_ || busy_) engine->ThreadDone();
+      engine->ThreadDeleted(index_, this);
+   }
+
+   if(clone_ != nullptr) MapAndUnits::delete_clone(clone_);
+}
+
+//------------------------------------------------------------------------------
+
+c_string WhatIfThread::AbbrName() const
+{
+   return "whatif";
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfThread::Assign()
+{
+   Debug::ft("WhatIfThread.Assign");
+
+   if(clone_ != nullptr) MapAndUnits::delete_clone(clone_);
+   clone_ = MapAndUnits::create_clone();
+   assigned_ = true;
+   Interrupt(ResumeExecution);
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfThread::Display(ostream& stream,
+   const string& prefix, const Flags& options) const
+{
+   Thread::Display(stream, prefix, options);
+
+   stream << prefix << "index    : " << index_ << CRLF;
+   stream << prefix << "clone    : " << clone_ << CRLF;
+   stream << prefix << "assigned : " << assigned_ << CRLF;
+   stream << prefix << "busy     : " << busy_ << CRLF;
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfThread::Enter()
+{
+   Debug::ft("WhatIfThread.Enter");
+
+   auto engine = Singleton<WhatIfEngine>::Instance();
+
+   //  If we're reentered after trapping while adjudicating a batch, the
+   //  other threads will adjudicate its remaining orders.
+   //
+   if(busy_)
+   {
+      busy_ = false;
+      engine->ThreadDone();
+   }
+
+   while(true)
+   {
+      //  Sleep until the engine assigns us a batch.  Another interrupt
+      //  can also end the pause, so keep pausing until then.
+      //
+      if(!assigned_)
+      {
+         Pause(TIMEOUT_NEVER);
+         continue;
+      }
+
+      assigned_ = false;
+      busy_ = true;
+
+      //  Adjudicating orders only accesses our clone and the engine's
+      //  batch, so it can run preemptably, in parallel with the other
+      //  WhatIfThreads.
+      //
+      {
+         FunctionGuard guard(Guard_MakePreemptable);
+         engine->Process(*clone_);
+      }
+
+      busy_ = false;
+      engine->ThreadDone();
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void WhatIfThread::Patch(sel_t selector, void* arguments)
+{
+   Thread::Patch(selector, arguments);
+}
+}
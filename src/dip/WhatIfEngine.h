@@ -0,0 +1,186 @@
+//==============================================================================
+//
+//  WhatIfEngine.h
+//
+//  Diplomacy AI Client - Part of the DAIDE project (www.daide.org.uk).
+//
+//  (C) David Norman 2002 david@ellought.demon.co.uk
+//  (C) Greg Utas 2019-2025 greg@pentennea.com
+//
+//  This software may be reused for non-commercial purposes without charge,
+//  and without notifying the authors.  Use of any part of this software for
+//  commercial purposes without permission from the authors is prohibited.
+//
+#ifndef WHATIFENGINE_H_INCLUDED
+#define WHATIFENGINE_H_INCLUDED
+
+#include "Permanent.h"
+#include "Thread.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+#include "NbTypes.h"
+#include "Snapshot.h"
+
+namespace Diplomacy
+{
+   class MapAndUnits;
+   class WhatIfThread;
+}
+
+using namespace NodeBase;
+
+//------------------------------------------------------------------------------
+
+namespace Diplomacy
+{
+//  Adjudicates many sets of hypothetical orders in parallel, for a bot that
+//  searches for its best orders.  Each set of orders is adjudicated against
+//  a GameSnapshot by a WhatIfThread, using its own clone of MapAndUnits, so
+//  the singleton instance is never modified.
+//
+class WhatIfEngine : public Permanent
+{
+   friend class Singleton<WhatIfEngine>;
+   friend class WhatIfThread;
+public:
+   //  Deleted to prohibit copying.
+   //
+   WhatIfEngine(const WhatIfEngine& that) = delete;
+
+   //  Deleted to prohibit copy assignment.
+   //
+   WhatIfEngine& operator=(const WhatIfEngine& that) = delete;
+
+   //> The maximum number of threads that can adjudicate a batch.
+   //
+   static const size_t MaxThreads = 16;
+
+   //  Adjudicates each entry in ORDERS against SNAPSHOT and updates the
+   //  corresponding entry in RESULTS.  The work is divided among THREADS
+   //  threads, which run preemptably.  A thread is created the first time
+   //  that it is needed and then waits for subsequent batches.  The invoking
+   //  thread sleeps until the threads have finished.  Returns false if a
+   //  batch is already in progress or if a map has not been received.
+   //
+   bool Adjudicate(const GameSnapshot& snapshot,
+      const std::vector<WhatIfOrders>& orders,
+      std::vector<WhatIfResults>& results, size_t threads);
+
+   //  Overridden to display member variables.
+   //
+   void Display(std::ostream& stream,
+      const std::string& prefix, const Flags& options) const override;
+
+   //  Overridden for patching.
+   //
+   void Patch(sel_t selector, void* arguments) override;
+
+   //  Overridden for restarts.
+   //
+   void Shutdown(RestartLevel level) override;
+private:
+   //  Private because this is a singleton.
+   //
+   WhatIfEngine();
+
+   //  Private because this is a singleton.
+   //
+   ~WhatIfEngine();
+
+   //  Invoked by a WhatIfThread to adjudicate, using CLONE, the sets of
+   //  orders that have yet to be claimed by another thread.
+   //
+   void Process(MapAndUnits& clone);
+
+   //  Invoked by a WhatIfThread when it has finished.  The last thread to
+   //  finish wakes up the thread that invoked Adjudicate.
+   //
+   void ThreadDone();
+
+   //  Invoked when THREAD, which was created for threads_[INDEX], is deleted.
+   //
+   void ThreadDeleted(size_t index, const WhatIfThread* thread);
+
+   //  The arguments passed to Adjudicate.
+   //
+   const GameSnapshot* snapshot_;
+   const std::vector<WhatIfOrders>* orders_;
+   std::vector<WhatIfResults>* results_;
+
+   //  The next entry in orders_ to be adjudicated.
+   //
+   std::atomic_size_t next_;
+
+   //  The number of threads that are adjudicating orders_.
+   //
+   std::atomic_size_t running_;
+
+   //  The thread that invoked Adjudicate.
+   //
+   Thread* client_;
+
+   //  The threads that adjudicate orders.
+   //
+   WhatIfThread* threads_[MaxThreads];
+};
+
+//------------------------------------------------------------------------------
+//
+//  Thread for adjudicating orders on behalf of WhatIfEngine.  It sleeps until
+//  the engine assigns it a batch of orders.
+//
+class WhatIfThread : public Thread
+{
+   friend class WhatIfEngine;
+public:
+   //  Overridden to display member variables.
+   //
+   void Display(std::ostream& stream,
+      const std::string& prefix, const Flags& options) const override;
+
+   //  Overridden for patching.
+   //
+   void Patch(sel_t selector, void* arguments) override;
+private:
+   //  Creates the thread for WhatIfEngine.threads_[INDEX].  Private to
+   //  restrict creation.
+   //
+   explicit WhatIfThread(size_t index);
+
+   //  Private to restrict deletion.  Not subclassed.
+   //
+   ~WhatIfThread();
+
+   //  Overridden to return a name for the thread.
+   //
+   c_string AbbrName() const override;
+
+   //  Assigns the current batch to the thread, replacing its clone so that
+   //  it matches the singleton instance of MapAndUnits.
+   //
+   void Assign();
+
+   //  Overridden to adjudicate orders.
+   //
+   void Enter() override;
+
+   //  The thread's index in WhatIfEngine.threads_.
+   //
+   const size_t index_;
+
+   //  The clone used to adjudicate orders.
+   //
+   MapAndUnits* clone_;
+
+   //  Set when the thread has been assigned a batch that it has not
+   //  started to adjudicate.
+   //
+   bool assigned_;
+
+   //  Set while the thread is adjudicating a batch.
+   //
+   bool busy_;
+};
+}
+#endif
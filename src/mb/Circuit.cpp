@@ -24,6 +24,7 @@
 #include <ostream>
 #include "Algorithms.h"
 #include "Debug.h"
+#include "MediaEngine.h"
 #include "Singleton.h"
 #include "SysTypes.h"
 
@@ -34,7 +35,9 @@ using std::string;
 
 namespace MediaBase
 {
-Circuit::Circuit() : rxFrom_(Switch::SilentPort)
+Circuit::Circuit() :
+   rxFrom_(Switch::SilentPort),
+   connTime_(SteadyTime::Now())
 {
    Debug::ft("Circuit.ctor");
 
@@ -47,6 +50,9 @@ Circuit::~Circuit()
 {
    Debug::ftnt("Circuit.dtor");
 
+   auto engine = Singleton<MediaEngine>::Extant();
+   if(engine != nullptr) engine->Leave(TsPort());
+
    Singleton<Switch>::Extant()->UnbindCircuit(*this);
 }
 
@@ -76,7 +82,10 @@ void Circuit::MakeConn(Switch::PortId rxFrom)
 {
    Debug::ft("Circuit.MakeConn");
 
-   if(Switch::IsValidPort(rxFrom)) rxFrom_ = rxFrom;
+   if(!Switch::IsValidPort(rxFrom) || (rxFrom == rxFrom_)) return;
+
+   rxFrom_ = rxFrom;
+   connTime_ = SteadyTime::Now();
 }
 
 //------------------------------------------------------------------------------
@@ -27,6 +27,7 @@
 #include <string>
 #include "RegCell.h"
 #include "SbTypes.h"
+#include "SteadyTime.h"
 #include "Switch.h"
 
 using namespace NodeBase;
@@ -67,6 +68,11 @@ public:
    //
    void MakeConn(Switch::PortId rxFrom);
 
+   //  Returns the time at which the circuit started to listen to the
+   //  port returned by RxFrom.
+   //
+   SteadyTime::Point ConnTime() const { return connTime_; }
+
    //  Returns a string that identifies the circuit.
    //
    virtual std::string Name() const = 0;
@@ -95,6 +101,10 @@ private:
    //  The port to which the circuit is listening.
    //
    Switch::PortId rxFrom_;
+
+   //  When the circuit started to listen to rxFrom_.
+   //
+   SteadyTime::Point connTime_;
 };
 }
 #endif
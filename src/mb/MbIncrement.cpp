@@ -0,0 +1,230 @@
+//==============================================================================
+//
+//  MbIncrement.cpp
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "MbIncrement.h"
+#include "CliCommand.h"
+#include "CliText.h"
+#include "CliTextParm.h"
+#include <sstream>
+#include <string>
+#include "CliCharParm.h"
+#include "CliIntParm.h"
+#include "CliThread.h"
+#include "Debug.h"
+#include "MediaEngine.h"
+#include "NbCliParms.h"
+#include "Singleton.h"
+#include "SysTypes.h"
+
+using std::string;
+
+//------------------------------------------------------------------------------
+
+namespace MediaBase
+{
+//  Parameter for a companding law.
+//
+class LawParm : public CliCharParm
+{
+public: LawParm();
+};
+
+fixed_string LawParmStr = "ua";
+fixed_string LawParmExpl = "'u'=mu-law 'a'=A-law (default='u')";
+
+LawParm::LawParm() : CliCharParm(LawParmExpl, LawParmStr, true) { }
+
+//------------------------------------------------------------------------------
+//
+//  Obtains the optional companding law for COMM from CLI.  Returns false on
+//  an error.
+//
+static bool GetLaw(const CliCommand& comm,
+   CliThread& cli, MediaEngine::Law& law)
+{
+   Debug::ft("MediaBase.GetLaw");
+
+   char c = 'u';
+
+   if(comm.GetCharParmRc(c, cli) == CliParm::Error) return false;
+   law = (c == 'a' ? MediaEngine::ALaw : MediaEngine::MuLaw);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//  The MEDIA command.
+//
+class MediaStartText : public CliText
+{
+public: MediaStartText();
+};
+
+class MediaBenchText : public CliText
+{
+public: MediaBenchText();
+};
+
+class MediaAction : public CliTextParm
+{
+public: MediaAction();
+};
+
+class MediaCommand : public CliCommand
+{
+public:
+   MediaCommand();
+private:
+   word ProcessCommand(CliThread& cli) const override;
+};
+
+fixed_string FrameMsecsExpl = "frame interval (msecs)";
+
+fixed_string MediaStartTextStr = "start";
+fixed_string MediaStartTextExpl = "starts the media engine";
+
+MediaStartText::MediaStartText() :
+   CliText(MediaStartTextExpl, MediaStartTextStr)
+{
+   BindParm(*new CliIntParm(FrameMsecsExpl,
+      MediaEngine::MinFrameMsecs, MediaEngine::MaxFrameMsecs));
+   BindParm(*new LawParm);
+}
+
+fixed_string MediaStopTextStr = "stop";
+fixed_string MediaStopTextExpl = "stops the media engine";
+
+fixed_string MediaQueryTextStr = "query";
+fixed_string MediaQueryTextExpl = "displays media engine status and statistics";
+
+fixed_string BenchFramesExpl = "number of frames to run";
+
+fixed_string MediaBenchTextStr = "bench";
+fixed_string MediaBenchTextExpl = "measures the cost of handling every port";
+
+MediaBenchText::MediaBenchText() :
+   CliText(MediaBenchTextExpl, MediaBenchTextStr)
+{
+   BindParm(*new CliIntParm(FrameMsecsExpl,
+      MediaEngine::MinFrameMsecs, MediaEngine::MaxFrameMsecs));
+   BindParm(*new CliIntParm(BenchFramesExpl, 1, 1000));
+   BindParm(*new LawParm);
+}
+
+constexpr id_t MediaStartIndex = 1;
+constexpr id_t MediaStopIndex = 2;
+constexpr id_t MediaQueryIndex = 3;
+constexpr id_t MediaBenchIndex = 4;
+
+fixed_string MediaActionExpl = "subcommand...";
+
+MediaAction::MediaAction() : CliTextParm(MediaActionExpl)
+{
+   BindText(*new MediaStartText, MediaStartIndex);
+   BindText(*new CliText
+      (MediaStopTextExpl, MediaStopTextStr), MediaStopIndex);
+   BindText(*new CliText
+      (MediaQueryTextExpl, MediaQueryTextStr), MediaQueryIndex);
+   BindText(*new MediaBenchText, MediaBenchIndex);
+}
+
+fixed_string MediaStr = "media";
+fixed_string MediaExpl = "Controls the engine that moves media frames.";
+
+MediaCommand::MediaCommand() : CliCommand(MediaStr, MediaExpl)
+{
+   BindParm(*new MediaAction);
+}
+
+fn_name MediaCommand_ProcessCommand = "MediaCommand.ProcessCommand";
+
+word MediaCommand::ProcessCommand(CliThread& cli) const
+{
+   Debug::ft(MediaCommand_ProcessCommand);
+
+   id_t index;
+   word msecs, frames;
+   MediaEngine::Law law;
+   string expl;
+
+   if(!GetTextIndex(index, cli)) return -1;
+
+   auto engine = Singleton<MediaEngine>::Instance();
+
+   switch(index)
+   {
+   case MediaStartIndex:
+      if(!GetIntParm(msecs, cli)) return -1;
+      if(!GetLaw(*this, cli, law)) return -1;
+      if(!cli.EndOfInput()) return -1;
+      if(!engine->Start(msecs, law, expl)) return cli.Report(-2, expl);
+      break;
+
+   case MediaStopIndex:
+      if(!cli.EndOfInput()) return -1;
+      engine->Stop();
+      break;
+
+   case MediaQueryIndex:
+      if(!cli.EndOfInput()) return -1;
+      engine->Query(*cli.obuf);
+      break;
+
+   case MediaBenchIndex:
+      if(!GetIntParm(msecs, cli)) return -1;
+      if(!GetIntParm(frames, cli)) return -1;
+      if(!GetLaw(*this, cli, law)) return -1;
+      if(!cli.EndOfInput()) return -1;
+      if(!engine->Benchmark(*cli.obuf, msecs, law, frames, expl))
+      {
+         return cli.Report(-2, expl);
+      }
+      break;
+
+   default:
+      Debug::SwLog(MediaCommand_ProcessCommand, UnexpectedIndex, index);
+      return cli.Report(index, SystemErrorExpl);
+   }
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+//
+//  The MediaBase increment.
+//
+fixed_string MbText = "mb";
+fixed_string MbExpl = "MediaBase Increment";
+
+MbIncrement::MbIncrement() : CliIncrement(MbText, MbExpl)
+{
+   Debug::ft("MbIncrement.ctor");
+
+   BindCommand(*new MediaCommand);
+}
+
+//------------------------------------------------------------------------------
+
+MbIncrement::~MbIncrement()
+{
+   Debug::ftnt("MbIncrement.dtor");
+}
+}
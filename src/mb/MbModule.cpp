@@ -21,7 +21,9 @@
 //
 #include "MbModule.h"
 #include "Debug.h"
+#include "MbIncrement.h"
 #include "MbPools.h"
+#include "MediaEngine.h"
 #include "ModuleRegistry.h"
 #include "SbModule.h"
 #include "Singleton.h"
@@ -42,7 +44,7 @@ MbModule::MbModule() : Module()
 
    //  Create the modules required by MediaBase.
    //
-   Singleton<SbModule>::Instance();
+   Requires(*Singleton<SbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
@@ -69,6 +71,9 @@ void MbModule::Shutdown(RestartLevel level)
 {
    Debug::ft("MbModule.Shutdown");
 
+   auto engine = Singleton<MediaEngine>::Extant();
+   if(engine != nullptr) engine->Shutdown(level);
+
    Singleton<ToneRegistry>::Instance()->Shutdown(level);
    Singleton<Switch>::Instance()->Shutdown(level);
 }
@@ -79,6 +84,8 @@ void MbModule::Startup(RestartLevel level)
 {
    Debug::ft("MbModule.Startup");
 
+   Singleton<MbIncrement>::Instance()->Startup(level);
+
    Singleton<Switch>::Instance()->Startup(level);
    Singleton<ToneRegistry>::Instance()->Startup(level);
    Singleton<ToneSilent>::Instance()->Startup(level);
@@ -0,0 +1,962 @@
+//==============================================================================
+//
+//  MediaEngine.cpp
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "MediaEngine.h"
+#include "StatisticsGroup.h"
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <new>
+#include <ostream>
+#include "Circuit.h"
+#include "Debug.h"
+#include "Formatters.h"
+#include "Memory.h"
+#include "Restart.h"
+#include "Singleton.h"
+#include "Statistics.h"
+#include "SteadyTime.h"
+#include "ToneRegistry.h"
+
+using std::ostream;
+using std::setw;
+using std::string;
+
+//------------------------------------------------------------------------------
+
+namespace MediaBase
+{
+//  The peak amplitude of each frequency in a tone, as a linear sample.
+//
+constexpr double ToneAmplitude = 4000.0;
+
+//  Used to build the sine table.
+//
+constexpr double Pi = 3.14159265358979;
+
+//------------------------------------------------------------------------------
+//
+//  Returns the linear value of the A-law sample SAMPLE.
+//
+static int16_t ALawToLinear(uint8_t sample)
+{
+   Debug::ft("MediaBase.ALawToLinear");
+
+   sample ^= 0x55;
+   int32_t magnitude = (sample & 0x0f) << 4;
+   auto segment = (sample & 0x70) >> 4;
+
+   if(segment == 0)
+   {
+      magnitude += 8;
+   }
+   else
+   {
+      magnitude += 0x108;
+      if(segment > 1) magnitude <<= (segment - 1);
+   }
+
+   return int16_t((sample & 0x80) != 0 ? magnitude : -magnitude);
+}
+
+//------------------------------------------------------------------------------
+//
+//  Returns the A-law value of the linear sample SAMPLE.
+//
+static uint8_t LinearToALaw(int32_t sample)
+{
+   Debug::ft("MediaBase.LinearToALaw");
+
+   uint8_t mask = 0xd5;
+
+   if(sample < 0)
+   {
+      sample = -sample - 1;
+      mask = 0x55;
+   }
+
+   //  A-law uses 13-bit samples.  Find the segment, whose upper limit
+   //  doubles from 0x1f to 0xfff.
+   //
+   sample >>= 3;
+
+   uint8_t segment = 0;
+
+   while((segment < 8) && (sample >= (int32_t(0x20) << segment)))
+   {
+      ++segment;
+   }
+
+   if(segment >= 8) return (0x7f ^ mask);
+
+   uint8_t value = segment << 4;
+
+   if(segment < 2)
+      value |= (sample >> 1) & 0x0f;
+   else
+      value |= (sample >> segment) & 0x0f;
+
+   return (value ^ mask);
+}
+
+//------------------------------------------------------------------------------
+//
+//  Returns the linear value of the mu-law sample SAMPLE.
+//
+static int16_t MuLawToLinear(uint8_t sample)
+{
+   Debug::ft("MediaBase.MuLawToLinear");
+
+   sample = ~sample;
+   int32_t magnitude = ((sample & 0x0f) << 3) + 0x84;
+   magnitude <<= ((sample & 0x70) >> 4);
+   magnitude -= 0x84;
+   return int16_t((sample & 0x80) != 0 ? -magnitude : magnitude);
+}
+
+//------------------------------------------------------------------------------
+//
+//  Returns the mu-law value of the linear sample SAMPLE.
+//
+static uint8_t LinearToMuLaw(int32_t sample)
+{
+   Debug::ft("MediaBase.LinearToMuLaw");
+
+   uint8_t sign = 0;
+
+   if(sample < 0)
+   {
+      sample = -sample;
+      sign = 0x80;
+   }
+
+   if(sample > 32635) sample = 32635;
+   sample += 0x84;
+
+   uint8_t exponent = 7;
+
+   for(int32_t mask = 0x4000; (sample & mask) == 0; mask >>= 1)
+   {
+      if(--exponent == 0) break;
+   }
+
+   uint8_t mantissa = (sample >> (exponent + 3)) & 0x0f;
+   return ~(sign | (exponent << 4) | mantissa);
+}
+
+//------------------------------------------------------------------------------
+//
+//  Returns the amount by which to advance a tone's phase for each sample
+//  in order to synthesize FREQ.
+//
+static uint32_t PhaseIncr(uint32_t freq)
+{
+   return uint32_t((uint64_t(freq) << 32) /
+      (MediaEngine::SamplesPerMsec * 1000));
+}
+
+//==============================================================================
+
+class MediaEngineStats : public Dynamic
+{
+public:
+   MediaEngineStats();
+   ~MediaEngineStats();
+
+   CounterPtr       ticks_;
+   CounterPtr       overruns_;
+   HistogramPtr     tickTimes_;
+   HighWatermarkPtr maxTick_;
+};
+
+//------------------------------------------------------------------------------
+
+MediaEngineStats::MediaEngineStats()
+{
+   Debug::ft("MediaEngineStats.ctor");
+
+   ticks_.reset(new Counter("frames produced"));
+   overruns_.reset(new Counter("frames longer than the frame interval"));
+   tickTimes_.reset(new Histogram("frame times in usecs", NS_TO_US));
+   maxTick_.reset(new HighWatermark("longest frame (usecs)", NS_TO_US));
+}
+
+//------------------------------------------------------------------------------
+
+MediaEngineStats::~MediaEngineStats()
+{
+   Debug::ftnt("MediaEngineStats.dtor");
+}
+
+//==============================================================================
+
+class MediaEngineStatsGroup : public StatisticsGroup
+{
+public:
+   MediaEngineStatsGroup();
+   ~MediaEngineStatsGroup();
+   void DisplayStats
+      (ostream& stream, id_t id, const Flags& options) const override;
+};
+
+//------------------------------------------------------------------------------
+
+MediaEngineStatsGroup::MediaEngineStatsGroup() :
+   StatisticsGroup("Media Engine")
+{
+   Debug::ft("MediaEngineStatsGroup.ctor");
+}
+
+//------------------------------------------------------------------------------
+
+MediaEngineStatsGroup::~MediaEngineStatsGroup()
+{
+   Debug::ftnt("MediaEngineStatsGroup.dtor");
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngineStatsGroup::DisplayStats
+   (ostream& stream, id_t id, const Flags& options) const
+{
+   Debug::ft("MediaEngineStatsGroup.DisplayStats");
+
+   StatisticsGroup::DisplayStats(stream, id, options);
+
+   Singleton<MediaEngine>::Instance()->DisplayStats(stream, options);
+}
+
+//==============================================================================
+
+MediaEngine::MediaEngine() :
+   frameMsecs_(0),
+   law_(MuLaw),
+   frameSize_(0),
+   ticks_(0),
+   toneRxs_(0),
+   portRxs_(0)
+{
+   Debug::ft("MediaEngine.ctor");
+
+   for(size_t i = 0; i < NumBanks; ++i)
+   {
+      tx_[i] = nullptr;
+      rx_[i] = nullptr;
+   }
+
+   //  Build the tables used to convert and synthesize samples.  An entry
+   //  in an encoding table covers four linear values, so it uses the middle
+   //  one.
+   //
+   for(size_t i = 0; i < 256; ++i)
+   {
+      decodeMu_[i] = MuLawToLinear(uint8_t(i));
+      decodeA_[i] = ALawToLinear(uint8_t(i));
+   }
+
+   for(size_t i = 0; i < 16384; ++i)
+   {
+      auto linear = int32_t(i << 2) + INT16_MIN + 2;
+      encodeMu_[i] = LinearToMuLaw(linear);
+      encodeA_[i] = LinearToALaw(linear);
+   }
+
+   for(size_t i = 0; i < 256; ++i)
+   {
+      sine_[i] = int16_t(ToneAmplitude * std::sin(Pi * i / 128));
+   }
+
+   memset(phase1_, 0, sizeof(phase1_));
+   memset(phase2_, 0, sizeof(phase2_));
+   memset(portToConf_, 0, sizeof(portToConf_));
+   memset(confs_, 0, sizeof(confs_));
+
+   stats_.reset(new MediaEngineStats);
+   statsGroup_.reset(new MediaEngineStatsGroup);
+}
+
+//------------------------------------------------------------------------------
+
+MediaEngine::~MediaEngine()
+{
+   Debug::ftnt("MediaEngine.dtor");
+
+   FreeBanks(tx_);
+   FreeBanks(rx_);
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::AddFrame(int32_t* sum, const int16_t* in, size_t size)
+{
+   for(size_t i = 0; i < size; ++i)
+   {
+      sum[i] += in[i];
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool MediaEngine::AllocBanks(uint8_t* banks[], uint8_t silence)
+{
+   Debug::ft("MediaEngine.AllocBanks");
+
+   auto size = PortsPerBank * MaxFrameSize;
+
+   for(size_t i = 0; i < NumBanks; ++i)
+   {
+      banks[i] = nullptr;
+   }
+
+   for(size_t i = 0; i < NumBanks; ++i)
+   {
+      banks[i] = (uint8_t*) Memory::Alloc(size, MemSlab, std::nothrow);
+      if(banks[i] == nullptr) return false;
+      memset(banks[i], silence, size);
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+bool MediaEngine::Benchmark(ostream& stream,
+   size_t msecs, Law law, size_t ticks, string& expl) const
+{
+   Debug::ft("MediaEngine.Benchmark");
+
+   //  Use separate frames so that the test does not disturb the engine.
+   //  Fill each port's transmit frame with a different part of a sine wave.
+   //
+   uint8_t* tx[NumBanks];
+   uint8_t* rx[NumBanks];
+   auto silence = SilentSample(law);
+   auto decode = DecodeTable(law);
+   auto encode = EncodeTable(law);
+
+   if(!AllocBanks(tx, silence) || !AllocBanks(rx, silence))
+   {
+      FreeBanks(tx);
+      FreeBanks(rx);
+      expl = "Memory for the frames was not available.";
+      return false;
+   }
+
+   auto size = msecs * SamplesPerMsec;
+
+   for(Switch::PortId pid = 1; pid < Switch::MaxPortId; ++pid)
+   {
+      auto frame = Frame(tx, pid);
+
+      for(size_t i = 0; i < size; ++i)
+      {
+         auto s = sine_[(pid + (i << 3)) & 0xff];
+         frame[i] = encode[(s - INT16_MIN) >> 2];
+      }
+
+      if((pid % PortsPerBank) == 0) Thread::PauseOver(90);
+   }
+
+   //  Time each workload over every port, a bank at a time, pausing between
+   //  banks.  The time spent paused is not included.  Each port in a simple
+   //  call listens to another port, and conferences have three ports.
+   //
+   size_t ports = Switch::MaxPortId - 1;
+   size_t confPorts = 0;
+   nsecs_t copyTime(0);
+   nsecs_t mixTime(0);
+   nsecs_t decodeTime(0);
+   nsecs_t addTime(0);
+   nsecs_t encodeTime(0);
+   int16_t lin[MaxFrameSize];
+   int32_t sum[MaxFrameSize];
+
+   for(size_t t = 0; t < ticks; ++t)
+   {
+      for(Switch::PortId first = 1; first < Switch::MaxPortId;
+         first += PortsPerBank)
+      {
+         Switch::PortId last = first + PortsPerBank;
+         if(last > Switch::MaxPortId) last = Switch::MaxPortId;
+
+         auto start = SteadyTime::Now();
+
+         for(auto pid = first; pid < last; ++pid)
+         {
+            auto from = ((pid * 7919) % (Switch::MaxPortId - 1)) + 1;
+            memcpy(Frame(rx, pid), Frame(tx, from), size);
+         }
+
+         copyTime += SteadyTime::Now() - start;
+         start = SteadyTime::Now();
+
+         for(auto pid = first; pid + 2 < last; pid += 3)
+         {
+            Switch::PortId conf[3];
+            conf[0] = pid;
+            conf[1] = pid + 1;
+            conf[2] = pid + 2;
+            MixFrames(law, conf, 3, tx, rx, size);
+            if(t == 0) confPorts += 3;
+         }
+
+         mixTime += SteadyTime::Now() - start;
+         start = SteadyTime::Now();
+
+         for(auto pid = first; pid < last; ++pid)
+         {
+            DecodeFrame(decode, Frame(tx, pid), lin, size);
+         }
+
+         decodeTime += SteadyTime::Now() - start;
+         memset(sum, 0, sizeof(sum));
+         start = SteadyTime::Now();
+
+         for(auto pid = first; pid < last; ++pid)
+         {
+            AddFrame(sum, lin, size);
+         }
+
+         addTime += SteadyTime::Now() - start;
+         start = SteadyTime::Now();
+
+         for(auto pid = first; pid < last; ++pid)
+         {
+            EncodeFrame(encode, sum, lin, Frame(rx, pid), size);
+         }
+
+         encodeTime += SteadyTime::Now() - start;
+         Thread::PauseOver(90);
+      }
+   }
+
+   FreeBanks(tx);
+   FreeBanks(rx);
+
+   auto frames = ports * ticks;
+   auto copyNsecs = size_t(copyTime.count()) / frames;
+   auto mixNsecs = size_t(mixTime.count()) / (confPorts * ticks);
+   auto frameNsecs = msecs * NS_TO_MS;
+
+   stream << "MEDIA ENGINE BENCHMARK" << CRLF;
+   stream << "  frame interval : " << msecs << " msecs (";
+   stream << size << " samples)" << CRLF;
+   stream << "  law            : " << (law == ALaw ? "A-law" : "mu-law");
+   stream << CRLF;
+   stream << "  ports          : " << ports << CRLF;
+   stream << "  frames         : " << ticks << CRLF;
+   stream << CRLF;
+   stream << "  Workload            nsecs/port  ports/core" << CRLF;
+   stream << "  simple call copy" << setw(14) << copyNsecs;
+   stream << setw(12) << (copyNsecs > 0 ? frameNsecs / copyNsecs : 0) << CRLF;
+   stream << "  3-port conference" << setw(13) << mixNsecs;
+   stream << setw(12) << (mixNsecs > 0 ? frameNsecs / mixNsecs : 0) << CRLF;
+   stream << CRLF;
+   stream << "  Kernel             nsecs/frame" << CRLF;
+   stream << "  decode" << setw(24);
+   stream << size_t(decodeTime.count()) / frames << CRLF;
+   stream << "  add" << setw(27);
+   stream << size_t(addTime.count()) / frames << CRLF;
+   stream << "  saturate + encode" << setw(13);
+   stream << size_t(encodeTime.count()) / frames << CRLF;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+bool MediaEngine::CopyFrames()
+{
+   Debug::ft("MediaEngine.CopyFrames");
+
+   auto tsw = Singleton<Switch>::Instance();
+   size_t toneRxs = 0;
+   size_t portRxs = 0;
+
+   for(Switch::PortId pid = 1; pid < Switch::MaxPortId; ++pid)
+   {
+      if((pid % PortsPerBank) == 0)
+      {
+         Thread::PauseOver(90);
+         if(frameMsecs_ == 0) return false;
+      }
+
+      if(portToConf_[pid] != NIL_ID) continue;
+
+      auto cct = tsw->GetCircuit(pid);
+      if(cct == nullptr) continue;
+
+      //  A tone's port identifier is the same as its tone identifier.
+      //
+      auto from = cct->RxFrom();
+
+      if(from > Tone::MaxId)
+         ++portRxs;
+      else if(from != Tone::Silence)
+         ++toneRxs;
+
+      memcpy(Frame(rx_, pid), Frame(tx_, from), frameSize_);
+   }
+
+   toneRxs_ = toneRxs;
+   portRxs_ = portRxs;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::DecodeFrame(const int16_t* decode,
+   const uint8_t* in, int16_t* out, size_t size)
+{
+   for(size_t i = 0; i < size; ++i)
+   {
+      out[i] = decode[in[i]];
+   }
+}
+
+//------------------------------------------------------------------------------
+
+const int16_t* MediaEngine::DecodeTable(Law law) const
+{
+   return (law == ALaw ? decodeA_ : decodeMu_);
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::Display(ostream& stream,
+   const string& prefix, const Flags& options) const
+{
+   Dynamic::Display(stream, prefix, options);
+
+   stream << prefix << "frameMsecs : " << frameMsecs_ << CRLF;
+   stream << prefix << "law        : " << law_ << CRLF;
+   stream << prefix << "frameSize  : " << frameSize_ << CRLF;
+   stream << prefix << "ticks      : " << ticks_ << CRLF;
+   stream << prefix << "toneRxs    : " << toneRxs_ << CRLF;
+   stream << prefix << "portRxs    : " << portRxs_ << CRLF;
+   stream << prefix << "tx[0]      : " << strPtr(tx_[0]) << CRLF;
+   stream << prefix << "rx[0]      : " << strPtr(rx_[0]) << CRLF;
+   stream << prefix << "stats      : " << strObj(stats_.get()) << CRLF;
+   stream << prefix << "statsGroup : " << strObj(statsGroup_.get()) << CRLF;
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::DisplayStats(ostream& stream, const Flags& options) const
+{
+   Debug::ft("MediaEngine.DisplayStats");
+
+   if(stats_ == nullptr) return;
+
+   stats_->ticks_->DisplayStat(stream, options);
+   stats_->overruns_->DisplayStat(stream, options);
+   stats_->tickTimes_->DisplayStat(stream, options);
+   stats_->maxTick_->DisplayStat(stream, options);
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::EncodeFrame(const uint8_t* encode, const int32_t* sum,
+   const int16_t* own, uint8_t* out, size_t size)
+{
+   for(size_t i = 0; i < size; ++i)
+   {
+      auto s = sum[i] - own[i];
+      if(s > INT16_MAX) s = INT16_MAX;
+      if(s < INT16_MIN) s = INT16_MIN;
+      out[i] = encode[(s - INT16_MIN) >> 2];
+   }
+}
+
+//------------------------------------------------------------------------------
+
+const uint8_t* MediaEngine::EncodeTable(Law law) const
+{
+   return (law == ALaw ? encodeA_ : encodeMu_);
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::FreeBanks(uint8_t* banks[])
+{
+   Debug::ftnt("MediaEngine.FreeBanks");
+
+   for(size_t i = 0; i < NumBanks; ++i)
+   {
+      if(banks[i] != nullptr)
+      {
+         Memory::Free(banks[i], MemSlab);
+         banks[i] = nullptr;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool MediaEngine::Join(ConfId cid, Switch::PortId pid)
+{
+   Debug::ft("MediaEngine.Join");
+
+   if((cid == NIL_ID) || (cid > MaxConfId)) return false;
+   if(!Switch::IsValidPort(pid)) return false;
+   if(portToConf_[pid] != NIL_ID) return false;
+
+   auto& conf = confs_[cid];
+   if(conf.size >= MaxConfPorts) return false;
+
+   conf.ports[conf.size] = pid;
+   ++conf.size;
+   portToConf_[pid] = cid;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::Leave(Switch::PortId pid)
+{
+   Debug::ftnt("MediaEngine.Leave");
+
+   if(!Switch::IsValidPort(pid)) return;
+
+   auto cid = portToConf_[pid];
+   if(cid == NIL_ID) return;
+
+   auto& conf = confs_[cid];
+
+   for(size_t i = 0; i < conf.size; ++i)
+   {
+      if(conf.ports[i] == pid)
+      {
+         --conf.size;
+         conf.ports[i] = conf.ports[conf.size];
+         break;
+      }
+   }
+
+   portToConf_[pid] = NIL_ID;
+}
+
+//------------------------------------------------------------------------------
+
+bool MediaEngine::MixConferences()
+{
+   Debug::ft("MediaEngine.MixConferences");
+
+   for(ConfId cid = 1; cid <= MaxConfId; ++cid)
+   {
+      if((cid % 256) == 0)
+      {
+         Thread::PauseOver(90);
+         if(frameMsecs_ == 0) return false;
+      }
+
+      const auto& conf = confs_[cid];
+      if(conf.size == 0) continue;
+
+      MixFrames(law_, conf.ports, conf.size, tx_, rx_, frameSize_);
+   }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::MixFrames(Law law, const Switch::PortId ports[], size_t size,
+   uint8_t* const tx[], uint8_t* const rx[], size_t length) const
+{
+   //  Sum the linear samples of all ports.  Each port then receives the
+   //  sum minus its own samples.
+   //
+   int16_t lin[MaxConfPorts * MaxFrameSize];
+   int32_t sum[MaxFrameSize];
+   auto decode = DecodeTable(law);
+   auto encode = EncodeTable(law);
+
+   memset(sum, 0, length * sizeof(int32_t));
+
+   for(size_t i = 0; i < size; ++i)
+   {
+      auto own = &lin[i * MaxFrameSize];
+      DecodeFrame(decode, Frame(tx, ports[i]), own, length);
+      AddFrame(sum, own, length);
+   }
+
+   for(size_t i = 0; i < size; ++i)
+   {
+      auto own = &lin[i * MaxFrameSize];
+      EncodeFrame(encode, sum, own, Frame(rx, ports[i]), length);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::Query(ostream& stream) const
+{
+   Debug::ft("MediaEngine.Query");
+
+   size_t confs = 0;
+   size_t ports = 0;
+
+   for(size_t i = 1; i <= MaxConfId; ++i)
+   {
+      if(confs_[i].size == 0) continue;
+      ++confs;
+      ports += confs_[i].size;
+   }
+
+   stream << "Frame interval (msecs)   " << frameMsecs_ << CRLF;
+   stream << "Companding law           " << (law_ == ALaw ? "A-law" : "mu-law");
+   stream << CRLF;
+   stream << "Frames since started     " << ticks_ << CRLF;
+   stream << "Circuits receiving tones " << toneRxs_ << CRLF;
+   stream << "Circuits receiving ports " << portRxs_ << CRLF;
+   stream << "Conferences              " << confs << CRLF;
+   stream << "Ports in conferences     " << ports << CRLF;
+   stream << CRLF;
+   statsGroup_->DisplayStats(stream, 0, NoFlags);
+}
+
+//------------------------------------------------------------------------------
+
+const uint8_t* MediaEngine::RxFrame(Switch::PortId pid) const
+{
+   Debug::ft("MediaEngine.RxFrame");
+
+   if((frameMsecs_ == 0) || !Switch::IsValidPort(pid)) return nullptr;
+   return Frame(rx_, pid);
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::Shutdown(RestartLevel level)
+{
+   Debug::ft("MediaEngine.Shutdown");
+
+   //  The engine's thread exits during a restart, so stop the engine.  If
+   //  its memory is about to be freed, so are its frames.
+   //
+   if(Restart::ClearsMemory(MemType())) return;
+   Stop();
+}
+
+//------------------------------------------------------------------------------
+
+uint8_t MediaEngine::SilentSample(Law law)
+{
+   return (law == ALaw ? 0xd5 : 0xff);
+}
+
+//------------------------------------------------------------------------------
+
+bool MediaEngine::Start(size_t msecs, Law law, string& expl)
+{
+   Debug::ft("MediaEngine.Start");
+
+   if((msecs < MinFrameMsecs) || (msecs > MaxFrameMsecs))
+   {
+      expl = "The frame interval is not supported.";
+      return false;
+   }
+
+   if((frameMsecs_ != 0) && (law != law_))
+   {
+      expl = "The engine must be stopped to change its companding law.";
+      return false;
+   }
+
+   if(frameMsecs_ == 0)
+   {
+      auto silence = SilentSample(law);
+
+      if(!AllocBanks(tx_, silence) || !AllocBanks(rx_, silence))
+      {
+         FreeBanks(tx_);
+         FreeBanks(rx_);
+         expl = "Memory for the frames was not available.";
+         return false;
+      }
+
+      law_ = law;
+      ticks_ = 0;
+   }
+
+   frameMsecs_ = msecs;
+   frameSize_ = msecs * SamplesPerMsec;
+   Singleton<MediaThread>::Instance()->Interrupt(Thread::ResumeExecution);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::Stop()
+{
+   Debug::ft("MediaEngine.Stop");
+
+   frameMsecs_ = 0;
+   frameSize_ = 0;
+   toneRxs_ = 0;
+   portRxs_ = 0;
+   FreeBanks(tx_);
+   FreeBanks(rx_);
+}
+
+//------------------------------------------------------------------------------
+
+void MediaEngine::SynthesizeTones()
+{
+   Debug::ft("MediaEngine.SynthesizeTones");
+
+   auto reg = Singleton<ToneRegistry>::Instance();
+   auto elapsed = ticks_ * frameMsecs_;
+   auto encode = EncodeTable(law_);
+   auto silence = SilentSample(law_);
+
+   for(Tone::Id tid = 1; tid <= Tone::MaxId; ++tid)
+   {
+      auto tone = reg->GetTone(tid);
+      if(tone == nullptr) continue;
+
+      auto frame = Frame(tx_, tone->TsPort());
+      auto on = (tone->Freq1() != 0);
+      auto cycle = size_t(tone->OnMsecs()) + tone->OffMsecs();
+
+      if(on && (tone->OffMsecs() > 0))
+      {
+         on = ((elapsed % cycle) < tone->OnMsecs());
+      }
+
+      if(!on)
+      {
+         memset(frame, silence, frameSize_);
+         continue;
+      }
+
+      auto incr1 = PhaseIncr(tone->Freq1());
+      auto incr2 = PhaseIncr(tone->Freq2());
+      auto phase1 = phase1_[tid];
+      auto phase2 = phase2_[tid];
+
+      for(size_t i = 0; i < frameSize_; ++i)
+      {
+         int32_t s = sine_[phase1 >> 24] + sine_[phase2 >> 24];
+         frame[i] = encode[(s - INT16_MIN) >> 2];
+         phase1 += incr1;
+         phase2 += incr2;
+      }
+
+      phase1_[tid] = phase1;
+      phase2_[tid] = phase2;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+nsecs_t MediaEngine::Tick()
+{
+   Debug::ft("MediaEngine.Tick");
+
+   auto start = SteadyTime::Now();
+   auto msecs = frameMsecs_;
+
+   if(msecs == 0) return nsecs_t(0);
+
+   //  Tones are synthesized first, because circuits can listen to them.
+   //
+   SynthesizeTones();
+   auto done = (CopyFrames() && MixConferences());
+
+   nsecs_t elapsed = SteadyTime::Now() - start;
+   if(!done) return elapsed;
+
+   ++ticks_;
+   stats_->ticks_->Incr();
+   stats_->tickTimes_->Record(elapsed.count());
+   stats_->maxTick_->Update(elapsed.count());
+   if(size_t(elapsed.count()) > msecs * NS_TO_MS) stats_->overruns_->Incr();
+   return elapsed;
+}
+
+//------------------------------------------------------------------------------
+
+uint8_t* MediaEngine::TxFrame(Switch::PortId pid) const
+{
+   Debug::ft("MediaEngine.TxFrame");
+
+   if((frameMsecs_ == 0) || !Switch::IsValidPort(pid)) return nullptr;
+   return Frame(tx_, pid);
+}
+
+//==============================================================================
+
+MediaThread::MediaThread() : Thread(PayloadFaction)
+{
+   Debug::ft("MediaThread.ctor");
+
+   SetInitialized();
+}
+
+//------------------------------------------------------------------------------
+
+MediaThread::~MediaThread()
+{
+   Debug::ftnt("MediaThread.dtor");
+}
+
+//------------------------------------------------------------------------------
+
+c_string MediaThread::AbbrName() const
+{
+   return "media";
+}
+
+//------------------------------------------------------------------------------
+
+void MediaThread::Destroy()
+{
+   Debug::ft("MediaThread.Destroy");
+
+   Singleton<MediaThread>::Destroy();
+}
+
+//------------------------------------------------------------------------------
+
+void MediaThread::Enter()
+{
+   Debug::ft("MediaThread.Enter");
+
+   while(true)
+   {
+      //  Sleep until the engine is started.  When it is running, produce a
+      //  frame and sleep for the rest of the frame interval.
+      //
+      auto engine = Singleton<MediaEngine>::Instance();
+      auto msecs = engine->FrameMsecs();
+
+      if(msecs == 0)
+      {
+         Pause(TIMEOUT_NEVER);
+         continue;
+      }
+
+      auto used = size_t(engine->Tick().count() / NS_TO_MS);
+      Pause(used >= msecs ? TIMEOUT_IMMED : msecs_t(msecs - used));
+   }
+}
+}
@@ -0,0 +1,368 @@
+//==============================================================================
+//
+//  MediaEngine.h
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef MEDIAENGINE_H_INCLUDED
+#define MEDIAENGINE_H_INCLUDED
+
+#include "Dynamic.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include "Duration.h"
+#include "NbTypes.h"
+#include "Switch.h"
+#include "SysTypes.h"
+#include "Thread.h"
+#include "Tones.h"
+
+namespace MediaBase
+{
+   class MediaEngineStats;
+}
+
+using namespace NodeBase;
+
+//------------------------------------------------------------------------------
+
+namespace MediaBase
+{
+//  The media engine moves G.711 (mu-law or A-law) frames through the Switch.
+//  When it is running, it wakes up every frame interval to synthesize a frame
+//  for each tone in ToneRegistry, copy a frame to each circuit that listens
+//  to another port, and mix a frame for each participant in a conference.
+//  A POTS call therefore hears dial tone, ringback, and the other party as
+//  the Switch connects its circuit to them.  Frames are kept in banks of
+//  ports, so each step streams through contiguous memory using a short,
+//  branch-free loop.  The engine is optional: the Switch only tracks which
+//  port each circuit listens to, and nothing depends on the engine.
+//
+class MediaEngine : public Dynamic
+{
+   friend class Singleton<MediaEngine>;
+public:
+   //  Deleted to prohibit copying.
+   //
+   MediaEngine(const MediaEngine& that) = delete;
+
+   //  Deleted to prohibit copy assignment.
+   //
+   MediaEngine& operator=(const MediaEngine& that) = delete;
+
+   //  The G.711 companding laws.
+   //
+   enum Law
+   {
+      MuLaw,  // North America and Japan
+      ALaw,   // elsewhere
+      Law_N   // number of laws
+   };
+
+   //  The number of G.711 samples in one msec of speech.
+   //
+   static const size_t SamplesPerMsec = 8;
+
+   //  The shortest and longest supported frame intervals, in msecs.
+   //
+   static const size_t MinFrameMsecs = 10;
+   static const size_t MaxFrameMsecs = 20;
+
+   //  The number of bytes reserved for each port's frame.
+   //
+   static const size_t MaxFrameSize = MaxFrameMsecs * SamplesPerMsec;
+
+   //  The number of ports whose frames are kept in each bank.
+   //
+   static const size_t PortsPerBank = 1024;
+
+   //  The number of banks needed to hold a frame for every port.
+   //
+   static const size_t NumBanks =
+      (Switch::MaxPortId + PortsPerBank - 1) / PortsPerBank;
+
+   //  Type for identifying a conference.
+   //
+   typedef uint16_t ConfId;
+
+   //  The maximum conference identifier.
+   //
+   static const ConfId MaxConfId = 4095;
+
+   //  The maximum number of ports in a conference.
+   //
+   static const size_t MaxConfPorts = 8;
+
+   //  Starts the engine with a frame interval of MSECS, using LAW to encode
+   //  samples.  If the engine is already running, only its frame interval
+   //  can be changed.  Returns false and updates EXPL if the engine could
+   //  not be started.
+   //
+   bool Start(size_t msecs, Law law, std::string& expl);
+
+   //  Stops the engine and frees its frames.
+   //
+   void Stop();
+
+   //  Returns the frame interval, in msecs, or 0 if the engine is stopped.
+   //
+   size_t FrameMsecs() const { return frameMsecs_; }
+
+   //  Returns the law used to encode samples.
+   //
+   Law GetLaw() const { return law_; }
+
+   //  Returns the frame that PID will transmit during the next tick.  Its
+   //  size is FrameMsecs() * SamplesPerMsec.  Returns nullptr if PID is
+   //  invalid or the engine is stopped.
+   //
+   uint8_t* TxFrame(Switch::PortId pid) const;
+
+   //  Returns the frame that PID received during the last tick.  Returns
+   //  nullptr if PID is invalid or the engine is stopped.
+   //
+   const uint8_t* RxFrame(Switch::PortId pid) const;
+
+   //  Adds PID to the conference identified by CID.  Each participant hears
+   //  the sum of the other participants.  Returns false if an argument is
+   //  invalid, if PID is already in a conference, or if CID is full.
+   //
+   bool Join(ConfId cid, Switch::PortId pid);
+
+   //  Removes PID from its conference, if any.
+   //
+   void Leave(Switch::PortId pid);
+
+   //  Produces the next frame for each port.  Invoked by the engine's thread
+   //  every FrameMsecs().  Returns the time that it took.
+   //
+   nsecs_t Tick();
+
+   //  Measures the cost of the engine's work when every port is busy, using
+   //  a frame interval of MSECS, encoding samples using LAW, and running for
+   //  TICKS frames.  Displays the results in STREAM.  Returns false and
+   //  updates EXPL if the frames for the test could not be allocated.
+   //
+   bool Benchmark(std::ostream& stream,
+      size_t msecs, Law law, size_t ticks, std::string& expl) const;
+
+   //  Displays status information.
+   //
+   void Query(std::ostream& stream) const;
+
+   //  Displays statistics in STREAM.
+   //
+   void DisplayStats(std::ostream& stream, const Flags& options) const;
+
+   //  Overridden to stop the engine during a restart.
+   //
+   void Shutdown(RestartLevel level) override;
+
+   //  Overridden to display member variables.
+   //
+   void Display(std::ostream& stream,
+      const std::string& prefix, const Flags& options) const override;
+private:
+   //  Private because this is a singleton.
+   //
+   MediaEngine();
+
+   //  Private because this is a singleton.
+   //
+   ~MediaEngine();
+
+   //  The participants in a conference.
+   //
+   struct Conference
+   {
+      Switch::PortId ports[MaxConfPorts];  // ports in the conference
+      size_t size;                         // number of ports
+   };
+
+   //  Returns the sample that represents silence when using LAW.
+   //
+   static uint8_t SilentSample(Law law);
+
+   //  Allocates a frame for every port in BANKS and fills each frame with
+   //  SILENCE.  Returns false if memory was not available.
+   //
+   static bool AllocBanks(uint8_t* banks[], uint8_t silence);
+
+   //  Frees the frames in BANKS.
+   //
+   static void FreeBanks(uint8_t* banks[]);
+
+   //  Returns the frame for PID in BANKS.
+   //
+   static uint8_t* Frame(uint8_t* const banks[], Switch::PortId pid)
+   {
+      return banks[pid / PortsPerBank] + ((pid % PortsPerBank) * MaxFrameSize);
+   }
+
+   //  Returns the tables that convert samples encoded using LAW to linear
+   //  samples, and linear samples to ones encoded using LAW.
+   //
+   const int16_t* DecodeTable(Law law) const;
+   const uint8_t* EncodeTable(Law law) const;
+
+   //  Converts the first SIZE samples in IN to linear samples in OUT, using
+   //  the DECODE table.
+   //
+   static void DecodeFrame(const int16_t* decode,
+      const uint8_t* in, int16_t* out, size_t size);
+
+   //  Adds the first SIZE samples in IN to SUM.
+   //
+   static void AddFrame(int32_t* sum, const int16_t* in, size_t size);
+
+   //  Subtracts the first SIZE samples in OWN from SUM and converts the
+   //  results, saturated to 16 bits, to samples in OUT, using the ENCODE
+   //  table.
+   //
+   static void EncodeFrame(const uint8_t* encode, const int32_t* sum,
+      const int16_t* own, uint8_t* out, size_t size);
+
+   //  Mixes the frames that the SIZE ports in PORTS transmit in TX, writing
+   //  the frame that each port receives in RX.  Each frame has LENGTH
+   //  samples encoded using LAW.
+   //
+   void MixFrames(Law law, const Switch::PortId ports[], size_t size,
+      uint8_t* const tx[], uint8_t* const rx[], size_t length) const;
+
+   //  Synthesizes the frame that each tone transmits.
+   //
+   void SynthesizeTones();
+
+   //  Copies a frame to each circuit that is not in a conference.  Returns
+   //  false if the engine was stopped while the thread was paused.
+   //
+   bool CopyFrames();
+
+   //  Mixes the frames for each conference.  Returns false if the engine
+   //  was stopped while the thread was paused.
+   //
+   bool MixConferences();
+
+   //  The frame interval, in msecs.  Zero if the engine is stopped.
+   //
+   size_t frameMsecs_;
+
+   //  The law used to encode samples.
+   //
+   Law law_;
+
+   //  The number of samples in each frame.
+   //
+   size_t frameSize_;
+
+   //  The number of ticks since the engine was started.
+   //
+   size_t ticks_;
+
+   //  The number of circuits that received a tone, and the number that
+   //  received another port, during the last tick.
+   //
+   size_t toneRxs_;
+   size_t portRxs_;
+
+   //  The frames that ports transmit, by bank.
+   //
+   uint8_t* tx_[NumBanks];
+
+   //  The frames that ports receive, by bank.
+   //
+   uint8_t* rx_[NumBanks];
+
+   //  Map mu-law and A-law samples to linear ones.
+   //
+   int16_t decodeMu_[256];
+   int16_t decodeA_[256];
+
+   //  Map linear samples, shifted right two bits, to mu-law and A-law ones.
+   //
+   uint8_t encodeMu_[16384];
+   uint8_t encodeA_[16384];
+
+   //  One cycle of a sine wave for synthesizing tones.
+   //
+   int16_t sine_[256];
+
+   //  The phases of each tone's two frequencies.
+   //
+   uint32_t phase1_[Tone::MaxId + 1];
+   uint32_t phase2_[Tone::MaxId + 1];
+
+   //  The conference, if any, that each port is in.
+   //
+   ConfId portToConf_[Switch::MaxPortId];
+
+   //  The conferences.
+   //
+   Conference confs_[MaxConfId + 1];
+
+   //  The engine's statistics.
+   //
+   std::unique_ptr<MediaEngineStats> stats_;
+
+   //  The engine's statistics group.
+   //
+   StatisticsGroupPtr statsGroup_;
+};
+
+//------------------------------------------------------------------------------
+//
+//  The thread that runs the media engine.
+//
+class MediaThread : public Thread
+{
+   friend class Singleton<MediaThread>;
+public:
+   //  Deleted to prohibit copying.
+   //
+   MediaThread(const MediaThread& that) = delete;
+
+   //  Deleted to prohibit copy assignment.
+   //
+   MediaThread& operator=(const MediaThread& that) = delete;
+private:
+   //  Private because this is a singleton.
+   //
+   MediaThread();
+
+   //  Private because this is a singleton.
+   //
+   ~MediaThread();
+
+   //  Overridden to return a name for the thread.
+   //
+   c_string AbbrName() const override;
+
+   //  Overridden to delete the singleton.
+   //
+   void Destroy() override;
+
+   //  Overridden to run the engine every frame interval, and to sleep
+   //  while the engine is stopped.
+   //
+   void Enter() override;
+};
+}
+#endif
@@ -36,7 +36,12 @@ using std::string;
 
 namespace MediaBase
 {
-Tone::Tone(Id tid)
+Tone::Tone(Id tid, uint16_t freq1, uint16_t freq2,
+   uint16_t onMsecs, uint16_t offMsecs) :
+   freq1_(freq1),
+   freq2_(freq2),
+   onMsecs_(onMsecs),
+   offMsecs_(offMsecs)
 {
    Debug::ft("Tone.ctor");
 
@@ -69,12 +74,16 @@ void Tone::Display(ostream& stream,
 {
    Circuit::Display(stream, prefix, options);
 
-   stream << prefix << "tid : " << tid_.to_str() << CRLF;
+   stream << prefix << "tid      : " << tid_.to_str() << CRLF;
+   stream << prefix << "freq1    : " << freq1_ << CRLF;
+   stream << prefix << "freq2    : " << freq2_ << CRLF;
+   stream << prefix << "onMsecs  : " << onMsecs_ << CRLF;
+   stream << prefix << "offMsecs : " << offMsecs_ << CRLF;
 }
 
 //==============================================================================
 
-ToneBusy::ToneBusy() : Tone(Busy) { }
+ToneBusy::ToneBusy() : Tone(Busy, 480, 620, 500, 500) { }
 
 string ToneBusy::Name() const
 {
@@ -83,7 +92,7 @@ string ToneBusy::Name() const
 
 //------------------------------------------------------------------------------
 
-ToneCallWaiting::ToneCallWaiting() : Tone(CallWaiting) { }
+ToneCallWaiting::ToneCallWaiting() : Tone(CallWaiting, 440, 0, 300, 9700) { }
 
 string ToneCallWaiting::Name() const
 {
@@ -92,7 +101,8 @@ string ToneCallWaiting::Name() const
 
 //------------------------------------------------------------------------------
 
-ToneConfirmation::ToneConfirmation() : Tone(Confirmation) { }
+ToneConfirmation::ToneConfirmation() :
+   Tone(Confirmation, 350, 440, 100, 100) { }
 
 string ToneConfirmation::Name() const
 {
@@ -101,7 +111,7 @@ string ToneConfirmation::Name() const
 
 //------------------------------------------------------------------------------
 
-ToneDial::ToneDial() : Tone(Dial) { }
+ToneDial::ToneDial() : Tone(Dial, 350, 440, 1, 0) { }
 
 string ToneDial::Name() const
 {
@@ -110,7 +120,7 @@ string ToneDial::Name() const
 
 //------------------------------------------------------------------------------
 
-ToneHeld::ToneHeld() : Tone(Held) { }
+ToneHeld::ToneHeld() : Tone(Held, 440, 0, 1000, 1000) { }
 
 string ToneHeld::Name() const
 {
@@ -119,7 +129,8 @@ string ToneHeld::Name() const
 
 //------------------------------------------------------------------------------
 
-ToneReceiverOffHook::ToneReceiverOffHook() : Tone(ReceiverOffHook) { }
+ToneReceiverOffHook::ToneReceiverOffHook() :
+   Tone(ReceiverOffHook, 1400, 2060, 100, 100) { }
 
 string ToneReceiverOffHook::Name() const
 {
@@ -128,7 +139,7 @@ string ToneReceiverOffHook::Name() const
 
 //------------------------------------------------------------------------------
 
-ToneReorder::ToneReorder() : Tone(Reorder) { }
+ToneReorder::ToneReorder() : Tone(Reorder, 480, 620, 250, 250) { }
 
 string ToneReorder::Name() const
 {
@@ -137,7 +148,7 @@ string ToneReorder::Name() const
 
 //------------------------------------------------------------------------------
 
-ToneRingback::ToneRingback() : Tone(Ringback) { }
+ToneRingback::ToneRingback() : Tone(Ringback, 440, 480, 2000, 4000) { }
 
 string ToneRingback::Name() const
 {
@@ -148,7 +159,7 @@ string ToneRingback::Name() const
 
 fn_name ToneSilent_ctor = "ToneSilent.ctor";
 
-ToneSilent::ToneSilent() : Tone(Silence)
+ToneSilent::ToneSilent() : Tone(Silence, 0, 0, 0, 0)
 {
    Debug::ft(ToneSilent_ctor);
 
@@ -167,7 +178,8 @@ string ToneSilent::Name() const
 
 //------------------------------------------------------------------------------
 
-ToneStutteredDial::ToneStutteredDial() : Tone(StutteredDial) { }
+ToneStutteredDial::ToneStutteredDial() :
+   Tone(StutteredDial, 350, 440, 100, 100) { }
 
 string ToneStutteredDial::Name() const
 {
@@ -72,6 +72,18 @@ public:
    //
    Id Tid() const { return Id(tid_.GetId()); }
 
+   //  Returns the tone's frequencies (Hz).  The first is 0 if the tone is
+   //  silent, and the second is 0 if the tone only has one frequency.
+   //
+   uint16_t Freq1() const { return freq1_; }
+   uint16_t Freq2() const { return freq2_; }
+
+   //  Returns the length of each burst of the tone and of the gap after it
+   //  (msecs).  The gap is 0 if the tone is continuous.
+   //
+   uint16_t OnMsecs() const { return onMsecs_; }
+   uint16_t OffMsecs() const { return offMsecs_; }
+
    //  Returns the offset to tid_.
    //
    static ptrdiff_t CellDiff();
@@ -81,9 +93,12 @@ public:
    void Display(std::ostream& stream,
       const std::string& prefix, const Flags& options) const override;
 protected:
-   //  Protected because this class is virtual.
+   //  Creates the tone identified by TID, which consists of FREQ1 and FREQ2
+   //  played in bursts of ONMSECS separated by gaps of OFFMSECS.  Protected
+   //  because this class is virtual.
    //
-   explicit Tone(Id tid);
+   Tone(Id tid, uint16_t freq1, uint16_t freq2,
+      uint16_t onMsecs, uint16_t offMsecs);
 
    //  Protected because subclasses should be singletons.
    //
@@ -92,6 +107,16 @@ private:
    //  The tone's identifier.
    //
    RegCell tid_;
+
+   //  The tone's frequencies.
+   //
+   const uint16_t freq1_;
+   const uint16_t freq2_;
+
+   //  The tone's cadence.
+   //
+   const uint16_t onMsecs_;
+   const uint16_t offMsecs_;
 };
 
 //------------------------------------------------------------------------------
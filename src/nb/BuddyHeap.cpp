@@ -39,6 +39,7 @@
 #include "Restart.h"
 #include "Singleton.h"
 #include "SysMemory.h"
+#include "ThreadAdmin.h"
 
 using std::ostream;
 using std::string;
@@ -105,6 +106,23 @@ constexpr size_t MinBlockSizeLog2 = BYTES_PER_WORD_LOG2 + 2;
 constexpr BuddyHeap::level_t NumLevels = 32;
 constexpr BuddyHeap::level_t LastLevel = NumLevels - 1;
 
+//  Log2 of the size of the largest block that is cached when it is freed
+//  (see HeapPriv::cache).
+//
+constexpr size_t MaxCachedSizeLog2 = 10;
+
+//  The level of the largest cached blocks, and the number of levels whose
+//  blocks are cached.
+//
+constexpr BuddyHeap::level_t FirstCachedLevel =
+   LastLevel - (MaxCachedSizeLog2 - MinBlockSizeLog2);
+constexpr size_t NumCachedLevels = LastLevel - FirstCachedLevel + 1;
+
+//  The maximum number of blocks in each cache queue.  When a queue is full,
+//  a freed block is returned to the free queue for its level.
+//
+constexpr size_t MaxCachedBlocks = 64;
+
 //  Types of heap corruption that can be detected.
 //
 enum HeapCorruptionReason
@@ -221,6 +239,19 @@ struct HeapPriv
    //
    Q2Way<HeapBlock> freeq[NumLevels];
 
+   //  Small blocks that have been freed but that are still marked as
+   //  allocated.  Each level from FirstCachedLevel to LastLevel has its
+   //  own queue, so that a block of a common size can be reallocated
+   //  without splitting a larger block and freed without merging it with
+   //  its sibling.  The blocks are returned to the free queues if the heap
+   //  runs out of memory.
+   //
+   Q2Way<HeapBlock> cache[NumCachedLevels];
+
+   //  The number of blocks in each cache queue.
+   //
+   size_t cacheCount[NumCachedLevels];
+
    //  The state of each block (see BuddyHeap::BlockState).  Each state uses
    //  two bits.
    //
@@ -235,6 +266,12 @@ struct HeapPriv
       state(nullptr)
    {
       for(auto i = 0; i <= LastLevel; ++i) freeq[i].Init(0);
+
+      for(size_t i = 0; i < NumCachedLevels; ++i)
+      {
+         cache[i].Init(0);
+         cacheCount[i] = 0;
+      }
    }
 };
 
@@ -245,7 +282,11 @@ fn_name BuddyHeap_ctor = "BuddyHeap.ctor";
 BuddyHeap::BuddyHeap(MemoryType type) : Heap(),
    heap_(nullptr),
    size_(0),
-   type_(type)
+   type_(type),
+   pageSize_(SysMemory::PageSize()),
+   unprotCount_(0),
+   firstUnprot_(SIZE_MAX),
+   lastUnprot_(0)
 {
    Debug::ft(BuddyHeap_ctor);
 }
@@ -283,7 +324,10 @@ bool BuddyHeap::AddrIsValid(const void* addr, bool header) const
       //  A queued block can point to the queue header, which is included in
       //  the chain (and which points to itself if the queue is empty).
       //
-      return ((addr >= &heap_->freeq[0]) && (addr < &heap_->freeq[NumLevels]));
+      if((addr >= &heap_->freeq[0]) && (addr < &heap_->freeq[NumLevels]))
+         return true;
+      auto end = &heap_->cache[NumCachedLevels];
+      return ((addr >= &heap_->cache[0]) && (addr < end));
    }
 
    return false;
@@ -303,7 +347,21 @@ void* BuddyHeap::Alloc(size_t size)
    auto level = SizeToLevel(size);
    if(level > LastLevel) return nullptr;
 
-   auto block = AllocBlock(level, size);
+   //  Reuse a cached block if one is available.  If a block cannot be
+   //  allocated, return all cached blocks to the free queues and retry.
+   //
+   auto block = DeqCached(level);
+
+   if(block == nullptr)
+   {
+      block = AllocBlock(level, size);
+
+      if((block == nullptr) && FlushCache())
+      {
+         block = AllocBlock(level, size);
+      }
+   }
+
    size = size_t(1) << log2(size, true);
    Requested(size, block);
    return block;
@@ -491,6 +549,11 @@ bool BuddyHeap::Create(size_t size)
    new (heap_) HeapPriv();
    heap_->lock.reset(lock.release());
 
+   //  Track which pages have been unprotected individually.
+   //
+   unprotected_.clear();
+   unprotected_.resize((size_ + pageSize_ - 1) / pageSize_, false);
+
    //  Find the heap's lowest level, which is the level where the smallest
    //  block that would span the entire heap would be placed.  Update SIZE
    //  to the lowest power of 2 that would span the entire heap.
@@ -584,11 +647,39 @@ size_t BuddyHeap::CurrAvail() const
       avail += (count * size);
    }
 
+   for(size_t i = 0; i < NumCachedLevels; ++i)
+   {
+      avail += (heap_->cacheCount[i] * LevelToSize(FirstCachedLevel + i));
+   }
+
    return avail;
 }
 
 //------------------------------------------------------------------------------
 
+HeapBlock* BuddyHeap::DeqCached(level_t level) const
+{
+   if(level < FirstCachedLevel) return nullptr;
+
+   //  A cached block is already marked as allocated, so just check its
+   //  fence after dequeueing it.
+   //
+   auto i = level - FirstCachedLevel;
+   auto block = heap_->cache[i].Deq();
+   if(block == nullptr) return nullptr;
+   --heap_->cacheCount[i];
+
+   if((block->fence[0] != HeapBlock::FencePattern) ||
+      (block->fence[1] != HeapBlock::FencePattern))
+   {
+      Corrupt(FenceInvalid, true);
+   }
+
+   return block;
+}
+
+//------------------------------------------------------------------------------
+
 HeapBlock* BuddyHeap::Dequeue(level_t level) const
 {
    auto block = heap_->freeq[level].Deq();
@@ -611,6 +702,8 @@ void BuddyHeap::Display(ostream& stream,
    stream << prefix << "heap     : " << heap_ << CRLF;
    stream << prefix << "size     : " << size_ << CRLF;
    stream << prefix << "type     : " << type_ << CRLF;
+   stream << prefix << "pageSize : " << pageSize_ << CRLF;
+   stream << prefix << "unprots  : " << unprotCount_ << CRLF;
    stream << std::hex;
    stream << prefix << "leftAddr : " << heap_->leftAddr << CRLF;
    stream << prefix << "minAddr  : " << heap_->minAddr << CRLF;
@@ -640,6 +733,22 @@ void BuddyHeap::Display(ostream& stream,
 
       stream << prefix << "Free bytes : " << avail << CRLF;
 
+      avail = 0;
+      stream << prefix << "cache [level] : " << CRLF;
+
+      for(size_t i = 0; i < NumCachedLevels; ++i)
+      {
+         auto count = heap_->cacheCount[i];
+         if(count == 0) continue;
+         auto level = FirstCachedLevel + i;
+         auto size = LevelToSize(level);
+         stream << lead << strIndex(level);
+         stream << "count=" << count << " size=" << size << CRLF;
+         avail += (count * size);
+      }
+
+      stream << prefix << "Cached bytes : " << avail << CRLF;
+
       //  The following exists for debugging purposes.  If the heap is
       //  small enough, display the state of all blocks at each level.
       //
@@ -703,6 +812,23 @@ void BuddyHeap::EnqBlock(HeapBlock* block, index_t index, level_t level) const
 
 //------------------------------------------------------------------------------
 
+bool BuddyHeap::EnqCached(HeapBlock* block, level_t level) const
+{
+   if(level < FirstCachedLevel) return false;
+
+   //  BLOCK remains marked as allocated.
+   //
+   auto i = level - FirstCachedLevel;
+   if(heap_->cacheCount[i] >= MaxCachedBlocks) return false;
+
+   new (block) HeapBlock();
+   heap_->cache[i].Enq(*block);
+   ++heap_->cacheCount[i];
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
 HeapBlock* BuddyHeap::Enqueue(HeapBlock* block, level_t level) const
 {
    auto b = BlockToIndex(block, level);
@@ -748,8 +874,20 @@ void BuddyHeap::Free(void* addr)
    auto level = SizeToLevel(size);
    if(level > LastLevel) return;
 
+   //  A cached block is still marked as allocated, so BlockToSize does not
+   //  detect that it is being freed again.
+   //
+   auto block = (HeapBlock*) addr;
+
+   if(IsCached(block, level))
+   {
+      guard.Release();
+      Debug::SwLog(BuddyHeap_Free, "block already freed", uintptr_t(addr));
+      return;
+   }
+
    Freeing(addr, size);
-   FreeBlock((HeapBlock*) addr, level);
+   if(!EnqCached(block, level)) FreeBlock(block, level);
 }
 
 //------------------------------------------------------------------------------
@@ -773,6 +911,27 @@ void BuddyHeap::FreeBlock(HeapBlock* block, level_t level)
 
 //------------------------------------------------------------------------------
 
+bool BuddyHeap::FlushCache()
+{
+   auto flushed = false;
+
+   for(size_t i = 0; i < NumCachedLevels; ++i)
+   {
+      auto level = FirstCachedLevel + i;
+
+      for(auto block = DeqCached(level); block != nullptr;
+         block = DeqCached(level))
+      {
+         FreeBlock(block, level);
+         flushed = true;
+      }
+   }
+
+   return flushed;
+}
+
+//------------------------------------------------------------------------------
+
 BuddyHeap::BlockState BuddyHeap::GetState(index_t index) const
 {
    //  Each byte holds four states, so right shift INDEX by 2 bits to find the
@@ -802,6 +961,23 @@ HeapBlock* BuddyHeap::IndexToBlock(index_t index, level_t level) const
 
 //------------------------------------------------------------------------------
 
+bool BuddyHeap::IsCached(const HeapBlock* block, level_t level) const
+{
+   if(level < FirstCachedLevel) return false;
+
+   //  An allocated block is cached if it has a fence and is linked into
+   //  a queue.
+   //
+   if(block->fence[0] != HeapBlock::FencePattern) return false;
+   if(block->fence[1] != HeapBlock::FencePattern) return false;
+   if(!AddrIsValid(block->link.prev, true)) return false;
+   if(!AddrIsValid(block->link.next, true)) return false;
+   if((HeapBlock*) block->link.prev->next != block) return false;
+   return ((HeapBlock*) block->link.next->prev == block);
+}
+
+//------------------------------------------------------------------------------
+
 size_t BuddyHeap::Overhead() const
 {
    return (heap_->minAddr - uintptr_t(heap_));
@@ -816,6 +992,24 @@ void BuddyHeap::Patch(sel_t selector, void* arguments)
 
 //------------------------------------------------------------------------------
 
+int BuddyHeap::Protect(uintptr_t addr, size_t size, MemoryProtection attrs)
+{
+   Debug::ft("BuddyHeap.Protect");
+
+   auto err = SysMemory::Protect((void*) addr, size, attrs);
+
+   if(err == 0)
+   {
+      ThreadAdmin::CountProtection(size);
+      return 0;
+   }
+
+   Restart::Initiate(Restart::LevelToClear(Type()), HeapProtectionFailed, err);
+   return err;
+}
+
+//------------------------------------------------------------------------------
+
 void BuddyHeap::ReleaseBlock(HeapBlock* block, level_t level) const
 {
    //  When the heap is initialized, queueing a block means that it is split
@@ -832,6 +1026,45 @@ void BuddyHeap::ReleaseBlock(HeapBlock* block, level_t level) const
 
 //------------------------------------------------------------------------------
 
+int BuddyHeap::ReprotectPages()
+{
+   Debug::ft("BuddyHeap.ReprotectPages");
+
+   //  Write-protect each run of adjacent pages with a single request.
+   //
+   auto heapAddr = uintptr_t(heap_);
+   auto page = firstUnprot_;
+
+   while((unprotCount_ > 0) && (page <= lastUnprot_))
+   {
+      if(!unprotected_[page])
+      {
+         ++page;
+         continue;
+      }
+
+      auto start = page;
+
+      while((page <= lastUnprot_) && unprotected_[page])
+      {
+         unprotected_[page] = false;
+         ++page;
+      }
+
+      auto count = page - start;
+      unprotCount_ -= count;
+
+      auto err = Protect
+         (heapAddr + (start * pageSize_), count * pageSize_, MemReadOnly);
+      if(err != 0) return err;
+   }
+
+   ResetPages();
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+
 void BuddyHeap::ReserveBlock(const HeapBlock* block) const
 {
    //  Mark BLOCK as allocated and proceed up the tree to mark its ancestors
@@ -845,15 +1078,44 @@ void BuddyHeap::ReserveBlock(const HeapBlock* block) const
 
 //------------------------------------------------------------------------------
 
+void BuddyHeap::ResetPages()
+{
+   Debug::ft("BuddyHeap.ResetPages");
+
+   if(unprotCount_ > 0)
+   {
+      for(auto p = firstUnprot_; p <= lastUnprot_; ++p)
+      {
+         unprotected_[p] = false;
+      }
+   }
+
+   unprotCount_ = 0;
+   firstUnprot_ = SIZE_MAX;
+   lastUnprot_ = 0;
+}
+
+//------------------------------------------------------------------------------
+
 int BuddyHeap::SetPermissions(MemoryProtection attrs)
 {
    Debug::ft("BuddyHeap.SetPermissions");
 
-   if(GetPermissions() == attrs) return 0;
-   auto err = SysMemory::Protect(heap_, size_, attrs);
-   if(err == 0) return SetAttrs(attrs);
-   Restart::Initiate(Restart::LevelToClear(Type()), HeapProtectionFailed, err);
-   return err;
+   MutexGuard guard(heap_->lock.get());
+
+   if(GetPermissions() == attrs)
+   {
+      if((attrs == MemReadOnly) && (unprotCount_ > 0)) return ReprotectPages();
+      return 0;
+   }
+
+   //  Changing the permissions of the entire heap also changes those of any
+   //  pages that were unprotected individually.
+   //
+   auto err = Protect(uintptr_t(heap_), size_, attrs);
+   if(err != 0) return err;
+   ResetPages();
+   return SetAttrs(attrs);
 }
 
 //------------------------------------------------------------------------------
@@ -889,6 +1151,61 @@ void BuddyHeap::SplitAncestors(index_t block) const
 
 //------------------------------------------------------------------------------
 
+int BuddyHeap::UnprotectPages(const void* addr, size_t size)
+{
+   Debug::ft("BuddyHeap.UnprotectPages");
+
+   //  If the heap is not write-protected, its pages are already writable.
+   //
+   if(GetPermissions() != MemReadOnly) return 0;
+
+   auto heapAddr = uintptr_t(heap_);
+   auto begin = uintptr_t(addr);
+
+   if((size == 0) || (begin < heapAddr) || (begin + size > heapAddr + size_))
+   {
+      return 0;
+   }
+
+   MutexGuard guard(heap_->lock.get());
+
+   auto page = (begin - heapAddr) / pageSize_;
+   auto last = (begin + size - 1 - heapAddr) / pageSize_;
+   if(page < firstUnprot_) firstUnprot_ = page;
+   if(last > lastUnprot_) lastUnprot_ = last;
+
+   //  Write-enable each run of adjacent pages that are still protected with
+   //  a single request.
+   //
+   while(page <= last)
+   {
+      if(unprotected_[page])
+      {
+         ++page;
+         continue;
+      }
+
+      auto start = page;
+
+      while((page <= last) && !unprotected_[page])
+      {
+         unprotected_[page] = true;
+         ++page;
+      }
+
+      auto count = page - start;
+      unprotCount_ += count;
+
+      auto err = Protect
+         (heapAddr + (start * pageSize_), count * pageSize_, MemReadWrite);
+      if(err != 0) return err;
+   }
+
+   return 0;
+}
+
+//------------------------------------------------------------------------------
+
 bool BuddyHeap::Validate(const void* addr) const
 {
    Debug::ft("BuddyHeap.Validate");
@@ -900,6 +1217,7 @@ bool BuddyHeap::Validate(const void* addr) const
       auto size = BlockToSize((const HeapBlock*) addr);
       if(size == 0) return false;
       auto level = SizeToLevel(size);
+      if(IsCached((const HeapBlock*) addr, level)) return false;
       auto index = BlockToIndex((const HeapBlock*) addr, level);
       return (ValidateBlock(index, level, false) == Allocated);
    }
@@ -917,6 +1235,19 @@ bool BuddyHeap::Validate(const void* addr) const
       levelSize <<= 1;
    }
 
+   //  Check the links and fence of each cached block.  Each block is
+   //  checked before following its link to the next block.
+   //
+   for(size_t i = 0; i < NumCachedLevels; ++i)
+   {
+      const auto& cache = heap_->cache[i];
+
+      for(auto block = cache.First(); block != nullptr; cache.Next(block))
+      {
+         if(ValidateLinks(block, false) == Invalid) return false;
+      }
+   }
+
    return true;
 }
 
@@ -941,21 +1272,7 @@ BuddyHeap::BlockState BuddyHeap::ValidateBlock
       //  The block is on the free queue, so check its links and fence.
       //
       auto block = IndexToBlock(index, level);
-
-      if(!AddrIsValid(block->link.prev, true))
-         return Corrupt(PrevInvalid, restart);
-      if(!AddrIsValid(block->link.next, true))
-         return Corrupt(NextInvalid, restart);
-
-      if(block->fence[0] != HeapBlock::FencePattern)
-         return Corrupt(FenceInvalid, restart);
-      if(block->fence[1] != HeapBlock::FencePattern)
-         return Corrupt(FenceInvalid, restart);
-
-      if((HeapBlock*) block->link.prev->next != block)
-         return Corrupt(PrevNextInvalid, restart);
-      if((HeapBlock*) block->link.next->prev != block)
-         return Corrupt(NextPrevInvalid, restart);
+      if(ValidateLinks(block, restart) == Invalid) return Invalid;
       [[fallthrough]];
    }
 
@@ -989,4 +1306,27 @@ BuddyHeap::BlockState BuddyHeap::ValidateBlock
 
    return state;
 }
+
+//------------------------------------------------------------------------------
+
+BuddyHeap::BlockState BuddyHeap::ValidateLinks
+   (const HeapBlock* block, bool restart) const
+{
+   if(!AddrIsValid(block->link.prev, true))
+      return Corrupt(PrevInvalid, restart);
+   if(!AddrIsValid(block->link.next, true))
+      return Corrupt(NextInvalid, restart);
+
+   if(block->fence[0] != HeapBlock::FencePattern)
+      return Corrupt(FenceInvalid, restart);
+   if(block->fence[1] != HeapBlock::FencePattern)
+      return Corrupt(FenceInvalid, restart);
+
+   if((HeapBlock*) block->link.prev->next != block)
+      return Corrupt(PrevNextInvalid, restart);
+   if((HeapBlock*) block->link.next->prev != block)
+      return Corrupt(NextPrevInvalid, restart);
+
+   return Available;
+}
 }
@@ -24,6 +24,8 @@
 
 #include "Heap.h"
 #include <cstddef>
+#include <cstdint>
+#include <vector>
 #include "SysTypes.h"
 
 namespace NodeBase
@@ -88,10 +90,18 @@ public:
    //
    void Patch(sel_t selector, void* arguments) override;
 
-   //  Overridden to change the heap's memory protection.
+   //  Overridden to change the heap's memory protection.  If the heap is
+   //  already write-protected and MemReadOnly is requested, restores write
+   //  protection to any pages that were unprotected by UnprotectPages.
    //
    int SetPermissions(MemoryProtection attrs) override;
 
+   //  Overridden to write-enable the pages that contain ADDR[0 to SIZE-1],
+   //  combining adjacent pages that are still write-protected into a single
+   //  request.  Does nothing if ADDR is not in the heap.
+   //
+   int UnprotectPages(const void* addr, size_t size) override;
+
    //  Overridden to return the heap's size.
    //
    size_t Size() const override { return size_; }
@@ -194,9 +204,31 @@ private:
    //
    HeapBlock* Enqueue(HeapBlock* block, level_t level) const;
 
+   //  Dequeues a cached block at LEVEL, which is still marked as allocated.
+   //  Returns nullptr if blocks at LEVEL are not cached or none are cached.
+   //
+   HeapBlock* DeqCached(level_t level) const;
+
+   //  Caches BLOCK, which was freed at LEVEL, instead of returning it to
+   //  the free queue.  Returns false if blocks at LEVEL are not cached or
+   //  the cache for LEVEL is full.
+   //
+   bool EnqCached(HeapBlock* block, level_t level) const;
+
+   //  Returns all cached blocks to the free queues.  Returns false if no
+   //  blocks were cached.
+   //
+   bool FlushCache();
+
+   //  Returns true if BLOCK, which is marked as allocated at LEVEL, is
+   //  actually cached.
+   //
+   bool IsCached(const HeapBlock* block, level_t level) const;
+
    //  Returns true if ADDR
    //  o is a legal block address regardless of its current state, or
-   //  o if HEADER is set, if ADDR the address of a free queue header.
+   //  o if HEADER is set, if ADDR the address of a free or cache queue
+   //    header.
    //
    bool AddrIsValid(const void* addr, bool header) const;
 
@@ -206,6 +238,12 @@ private:
    //
    BlockState ValidateBlock(index_t index, level_t level, bool restart) const;
 
+   //  Validates the links and fence of BLOCK, which is queued, and returns
+   //  Available.  If the block is corrupt, returns Invalid or initiates a
+   //  restart if RESTART is set.
+   //
+   BlockState ValidateLinks(const HeapBlock* block, bool restart) const;
+
    //  Invoked when heap corruption is detected.  REASON specifies the type
    //  of corruption, and RESTART is set to initiate a restart.
    //
@@ -223,6 +261,20 @@ private:
    //
    HeapBlock* IndexToBlock(index_t index, level_t level) const;
 
+   //  Applies ATTRS to ADDR[0 to SIZE-1], which is within the heap, and
+   //  updates the statistics for memory protection changes.  Initiates a
+   //  restart and returns a system-specific error code on failure.
+   //
+   int Protect(uintptr_t addr, size_t size, MemoryProtection attrs);
+
+   //  Write-protects the pages that were unprotected by UnprotectPages.
+   //
+   int ReprotectPages();
+
+   //  Clears unprotected_ after the entire heap's permissions were changed.
+   //
+   void ResetPages();
+
    //  The heap, which begins with its management information.
    //
    HeapPriv* heap_;
@@ -234,6 +286,27 @@ private:
    //  The type of memory that the heap manages.
    //
    const MemoryType type_;
+
+   //  The size of a page.
+   //
+   size_t pageSize_;
+
+   //  Set for each page that UnprotectPages has write-enabled while the
+   //  rest of the heap is write-protected.  Threads in different lanes
+   //  can unprotect pages at the same time, and a vector<bool> packs its
+   //  flags into shared words, so this and the following members are only
+   //  accessed under the heap's lock.
+   //
+   std::vector<bool> unprotected_;
+
+   //  The number of pages that are set in unprotected_.
+   //
+   size_t unprotCount_;
+
+   //  The range of pages that may be set in unprotected_.
+   //
+   size_t firstUnprot_;
+   size_t lastUnprot_;
 };
 }
 #endif
@@ -0,0 +1,63 @@
+//==============================================================================
+//
+//  FunctionRing.cpp
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "FunctionRing.h"
+#include <new>
+#include "Memory.h"
+
+//------------------------------------------------------------------------------
+
+namespace NodeBase
+{
+FunctionRing::FunctionRing(SysThreadId nid) :
+   nid_(nid),
+   next_(0),
+   lost_(0)
+{
+}
+
+//------------------------------------------------------------------------------
+
+FunctionRing* FunctionRing::Create(SysThreadId nid)
+{
+   auto addr = Memory::Alloc(sizeof(FunctionRing), MemPermanent, std::nothrow);
+   if(addr == nullptr) return nullptr;
+   return new (addr) FunctionRing(nid);
+}
+
+//------------------------------------------------------------------------------
+
+void FunctionRing::Destroy(FunctionRing* ring)
+{
+   if(ring == nullptr) return;
+   ring->~FunctionRing();
+   Memory::Free(ring, MemPermanent);
+}
+
+//------------------------------------------------------------------------------
+
+void FunctionRing::Reset(SysThreadId nid)
+{
+   nid_ = nid;
+   next_ = 0;
+   lost_ = 0;
+}
+}
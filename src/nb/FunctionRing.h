@@ -0,0 +1,147 @@
+//==============================================================================
+//
+//  FunctionRing.h
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FUNCTIONRING_H_INCLUDED
+#define FUNCTIONRING_H_INCLUDED
+
+#include <cstddef>
+#include "SysDecls.h"
+#include "SystemTime.h"
+#include "SysTypes.h"
+
+//------------------------------------------------------------------------------
+
+namespace NodeBase
+{
+//  Records function invocations on one thread when the function tracer's
+//  scope is FunctionTrace::Compact.  An entry is much smaller than a
+//  FunctionTrace record, and only the thread that owns a ring writes to it,
+//  so capturing an invocation needs neither an atomic slot in the trace
+//  buffer nor a search of it.  The entries are converted to FunctionTrace
+//  records when the trace buffer is processed (see TraceBuffer::MergeRings).
+//
+class FunctionRing
+{
+public:
+   //  An entry in the ring.
+   //
+   struct Entry
+   {
+      c_string func;           // function that was invoked
+      SystemTime::Point time;  // when it was invoked
+      fn_depth depth;          // its depth on the stack
+   };
+
+   //> The number of entries in each ring (in log2).
+   //
+   static const size_t Log2Size = 14;
+
+   //  Creates a ring for the thread identified by NID.  Returns nullptr
+   //  if the memory cannot be allocated.
+   //
+   static FunctionRing* Create(SysThreadId nid);
+
+   //  Frees RING.
+   //
+   static void Destroy(FunctionRing* ring);
+
+   //  Deleted to prohibit copying.
+   //
+   FunctionRing(const FunctionRing& that) = delete;
+
+   //  Deleted to prohibit copy assignment.
+   //
+   FunctionRing& operator=(const FunctionRing& that) = delete;
+
+   //  Records an invocation of FUNC at DEPTH.  When the ring is full, the
+   //  oldest entry is overwritten if WRAP is set; otherwise the invocation
+   //  is discarded.
+   //
+   void Capture(fn_name_arg func, fn_depth depth, bool wrap)
+   {
+      if((next_ >= Size) && !wrap)
+      {
+         ++lost_;
+         return;
+      }
+
+      auto& entry = entries_[next_ & (Size - 1)];
+      entry.func = func;
+      entry.time = SystemTime::Now();
+      entry.depth = depth;
+      ++next_;
+   }
+
+   //  Returns the thread whose invocations are being recorded.
+   //
+   SysThreadId Nid() const { return nid_; }
+
+   //  Returns the number of entries in the ring.
+   //
+   size_t Count() const { return (next_ < Size ? next_ : Size); }
+
+   //  Returns the number of invocations that were discarded or overwritten.
+   //
+   size_t Lost() const { return lost_ + (next_ > Size ? next_ - Size : 0); }
+
+   //  Returns the entry at INDEX, where 0 is the oldest entry.
+   //
+   const Entry& At(size_t index) const
+   {
+      auto first = (next_ > Size ? next_ - Size : 0);
+      return entries_[(first + index) & (Size - 1)];
+   }
+
+   //  Discards all entries and assigns the ring to the thread identified
+   //  by NID.
+   //
+   void Reset(SysThreadId nid);
+private:
+   //  The number of entries in the ring.
+   //
+   static const size_t Size = 1 << Log2Size;
+
+   //  Private to restrict creation to Create.
+   //
+   explicit FunctionRing(SysThreadId nid);
+
+   //  Private to restrict deletion to Destroy.
+   //
+   ~FunctionRing() = default;
+
+   //  The thread whose invocations are being recorded.
+   //
+   SysThreadId nid_;
+
+   //  The total number of invocations written to the ring.
+   //
+   size_t next_;
+
+   //  The number of invocations discarded because the ring was full.
+   //
+   size_t lost_;
+
+   //  The entries.
+   //
+   Entry entries_[Size];
+};
+}
+#endif
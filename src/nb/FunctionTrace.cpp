@@ -38,6 +38,7 @@
 #include "SysStackTrace.h"
 #include "SystemTime.h"
 #include "SysThread.h"
+#include "Thread.h"
 #include "TraceBuffer.h"
 #include "TraceDump.h"
 #include "TraceRecord.h"
@@ -547,6 +548,21 @@ FunctionTrace::FunctionTrace(fn_name_arg func, fn_depth depth) :
 
 //------------------------------------------------------------------------------
 
+FunctionTrace::FunctionTrace(fn_name_arg func,
+   fn_depth depth, SysThreadId nid, const SystemTime::Point& time) :
+   TimedRecord(FunctionTracer, nid, time),
+   func_(func),
+   depth_(depth),
+   invokerDepth_(0),
+   gross_(0),
+   net_(0)
+{
+   if(depth_ < 0) depth_ = 0;
+   rid_ = NIL_ID;
+}
+
+//------------------------------------------------------------------------------
+
 FunctionTrace::FunctionTrace() :
    TimedRecord(FunctionTracer),
    func_(nullptr),
@@ -690,7 +706,7 @@ void FunctionTrace::CalcTimes()
 
 fn_name Cxx_delete = "C++.delete";
 
-void FunctionTrace::Capture(fn_name_arg func)
+void FunctionTrace::Capture(fn_name_arg func, const Thread* thr)
 {
    //  The actual trace is
    //    func
@@ -711,6 +727,16 @@ void FunctionTrace::Capture(fn_name_arg func)
    if(buff == nullptr) return;
    auto depth = SysStackTrace::FuncDepth() - 3;
 
+   //  In a compact trace, record the invocation in the thread's ring.  The
+   //  check for inserting "C++.delete" is deferred until the rings are
+   //  merged into the buffer (see ExpandRing).
+   //
+   if((Scope_ == Compact) && (thr != nullptr))
+   {
+      buff->CaptureInRing(*thr, func, depth);
+      return;
+   }
+
    //  If this is a destructor call that is not one level deeper than the last
    //  destructor or function, add a call to a compiler-generated "C++.delete"
    //  function.  The compiler generates this code to invoke a delete operator
@@ -804,6 +830,58 @@ bool FunctionTrace::FindDeleteOperator()
 
 //------------------------------------------------------------------------------
 
+void FunctionTrace::ExpandRing
+   (const FunctionRing& ring, std::vector<FunctionRing::Entry>& entries)
+{
+   Debug::ft("FunctionTrace.ExpandRing");
+
+   //  This mimics Capture, where TraceBuffer::LastDtorDepth only looks at
+   //  the previous 30 functions and TraceBuffer::LastFunction returns the
+   //  most recent function on the same thread.
+   //
+   auto count = ring.Count();
+   fn_depth dtorDepth = -1;
+   size_t sinceDtor = SIZE_MAX;
+
+   entries.reserve(entries.size() + count);
+
+   for(size_t i = 0; i < count; ++i)
+   {
+      const auto& entry = ring.At(i);
+      auto depth = entry.depth;
+
+      if(strstr(entry.func, FunctionName::DtorTag) != nullptr)
+      {
+         auto insert = ((sinceDtor > 30) || (dtorDepth != depth - 1));
+
+         if(!insert && !entries.empty())
+         {
+            insert = (entries.back().depth != depth - 1);
+         }
+
+         if(insert)
+         {
+            FunctionRing::Entry del;
+            del.func = Cxx_delete;
+            del.time = entry.time;
+            del.depth = depth - 1;
+            entries.push_back(del);
+         }
+
+         dtorDepth = depth;
+         sinceDtor = 0;
+      }
+      else if(sinceDtor != SIZE_MAX)
+      {
+         ++sinceDtor;
+      }
+
+      entries.push_back(entry);
+   }
+}
+
+//------------------------------------------------------------------------------
+
 void FunctionTrace::FindInvokerDepths()
 {
    auto buff = Singleton<TraceBuffer>::Instance();
@@ -876,6 +954,7 @@ void FunctionTrace::Process(const string& opts)
    //  them again.
    //
    auto buff = Singleton<TraceBuffer>::Instance();
+   buff->MergeRings();
    if(buff->HasBeenProcessed()) return;
 
    buff->Lock();
@@ -25,10 +25,17 @@
 #include "TimedRecord.h"
 #include <cstddef>
 #include <string>
+#include <vector>
 #include "Duration.h"
+#include "FunctionRing.h"
 #include "SysTypes.h"
 #include "ToolTypes.h"
 
+namespace NodeBase
+{
+   class Thread;
+}
+
 //------------------------------------------------------------------------------
 
 namespace NodeBase
@@ -38,6 +45,7 @@ namespace NodeBase
 class FunctionTrace : public TimedRecord
 {
    friend class Thread;
+   friend class TraceBuffer;
 public:
    //  Constructs a default record.
    //
@@ -51,8 +59,9 @@ public:
    //
    enum Scope
    {
-      FullTrace,  // capturing a detailed history of function invocations
-      CountsOnly  // only counting how many times each function was invoked
+      FullTrace,   // capturing a detailed history of function invocations
+      CountsOnly,  // only counting how many times each function was invoked
+      Compact      // a detailed history, captured in per-thread rings
    };
 
    //  Sets the scope of the function trace.
@@ -96,6 +105,12 @@ protected:
    //
    FunctionTrace(fn_name_arg func, fn_depth depth);
 private:
+   //  Sets func_ and depth_ for an invocation that was recorded in the
+   //  FunctionRing for the thread identified by NID.
+   //
+   FunctionTrace(fn_name_arg func,
+      fn_depth depth, SysThreadId nid, const SystemTime::Point& time);
+
    //  Overridden to allocate space in the buffer allocated for records
    //  that belong to this class.
    //
@@ -111,10 +126,18 @@ private:
    //
    static void* operator new(size_t size, void* place);
 
-   //  Captures a call to FUNC when tracing is enabled.  Applications use
+   //  Captures a call to FUNC, on THR, when tracing is enabled.  THR is
+   //  nullptr if the running thread is not known.  Applications use
    //  Debug::ft instead of invoking this directly.
    //
-   static void Capture(fn_name_arg func);
+   static void Capture(fn_name_arg func, const Thread* thr);
+
+   //  Copies the entries in RING to ENTRIES, inserting the calls to
+   //  "C++.delete" that Capture would have inserted if the entries had
+   //  been captured directly in the trace buffer.
+   //
+   static void ExpandRing
+      (const FunctionRing& ring, std::vector<FunctionRing::Entry>& entries);
 
    //  Adjusts all functions' depths to prevent unnecessary indentation.
    //
@@ -288,6 +288,15 @@ MemoryType Heap::Type() const
 
 //------------------------------------------------------------------------------
 
+int Heap::UnprotectPages(const void* addr, size_t size)
+{
+   Debug::ft("Heap.UnprotectPages");
+
+   return SetPermissions(MemReadWrite);
+}
+
+//------------------------------------------------------------------------------
+
 fn_name Heap_Validate = "Heap.Validate";
 
 bool Heap::Validate(const void* addr) const
@@ -84,6 +84,13 @@ public:
    //
    virtual int SetPermissions(MemoryProtection attrs);
 
+   //  Write-enables the pages that contain ADDR[0 to SIZE-1] if the heap
+   //  is write-protected.  The pages remain writable until SetPermissions
+   //  is next invoked.  Returns 0 on success.  The default version applies
+   //  MemReadWrite to the entire heap.
+   //
+   virtual int UnprotectPages(const void* addr, size_t size);
+
    //  Returns the number of bytes available.  Simply subtracting
    //  the number of bytes allocated from the size of the heap is
    //  inaccurate because of management overhead.
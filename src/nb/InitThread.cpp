@@ -47,8 +47,7 @@ static uint64_t RunningTicks_ = 0;
 //------------------------------------------------------------------------------
 
 InitThread::InitThread() : Thread(SystemFaction),
-   state_(Initializing),
-   timeout_(false)
+   state_(Initializing)
 {
    Debug::ft("InitThread.ctor");
 
@@ -80,17 +79,25 @@ msecs_t InitThread::CalculateDelay() const
    //  Wake up at the earliest of the following:
    //  o the time before which RootThread must be interrupted to
    //    prevent a scheduling timeout;
-   //  o the time before which the unpreemptable thread must yield;
-   //  o the RTC timeout, if no unpreemptable thread is running (or
-   //    if it has already been signalled for running too long).
+   //  o the time before which an unpreemptable thread must yield;
+   //  o the RTC timeout, if no unpreemptable thread is running in a
+   //    lane (or if it has already been signalled for running too long).
    //
-   msecs_t timeout;
-   auto thr = LockedThread();
+   msecs_t timeout(0);
+   auto lanes = LanesInUse();
 
-   if((thr != nullptr) && !timeout_)
-      timeout = thr->TimeLeft();
-   else
-      timeout = ThreadAdmin::RtcTimeout();
+   for(size_t lane = 0; lane < lanes; ++lane)
+   {
+      msecs_t time;
+      auto thr = LockedThread(SchedLane(lane));
+
+      if((thr != nullptr) && !timeouts_.test(lane))
+         time = thr->TimeLeft();
+      else
+         time = ThreadAdmin::RtcTimeout();
+
+      if((lane == 0) || (time < timeout)) timeout = time;
+   }
 
    msecs_t delay(ThreadAdmin::SchedTimeout().count() >> 1);
 
@@ -157,8 +164,8 @@ void InitThread::Display(ostream& stream,
 {
    Thread::Display(stream, prefix, options);
 
-   stream << prefix << "state   : " << state_ << CRLF;
-   stream << prefix << "timeout : " << timeout_ << CRLF;
+   stream << prefix << "state    : " << state_ << CRLF;
+   stream << prefix << "timeouts : " << timeouts_.to_string() << CRLF;
 }
 
 //------------------------------------------------------------------------------
@@ -201,7 +208,7 @@ void InitThread::Enter()
          }
 
          delay = CalculateDelay();
-         timeout_ = false;
+         timeouts_.reset();
 
          if(Pause(delay) == DelayCompleted)
             HandleTimeout();
@@ -253,25 +260,22 @@ void InitThread::HandleInterrupt()
 
 //------------------------------------------------------------------------------
 
-void InitThread::HandleTimeout()
+void InitThread::HandleLaneTimeout(SchedLane lane)
 {
-   Debug::ft("InitThread.HandleTimeout");
+   Debug::ft("InitThread.HandleLaneTimeout");
 
-   //  Interrupt RootThread so that its watchdog timer won't expire.
-   //
-   Singleton<RootThread>::Extant()->Interrupt(Heartbeat);
-   timeout_ = false;
+   timeouts_.reset(lane);
 
    //  If there is no locked thread, schedule one.  If the locked thread
    //  is still waiting to proceed, signal it.  Both of these are unusual
    //  situations that occur because of race conditions.
    //
-   auto thr = LockedThread();
+   auto thr = LockedThread(lane);
 
    if(thr == nullptr)
    {
-      ContextSwitch();
-      if(ActiveThread() != nullptr) ThreadAdmin::Incr(ThreadAdmin::Delays);
+      SwitchLane(lane);
+      if(ActiveThread(lane) != nullptr) ThreadAdmin::Incr(ThreadAdmin::Delays);
       return;
    }
    else if(thr->IsScheduled())
@@ -287,7 +291,28 @@ void InitThread::HandleTimeout()
    if((thr->TimeLeft() == ZERO_SECS) && !ThreadAdmin::BreakEnabled())
    {
       thr->RtcTimeout();
-      timeout_ = true;
+      timeouts_.set(lane);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void InitThread::HandleTimeout()
+{
+   Debug::ft("InitThread.HandleTimeout");
+
+   //  Interrupt RootThread so that its watchdog timer won't expire.
+   //
+   Singleton<RootThread>::Extant()->Interrupt(Heartbeat);
+
+   //  Each scheduler lane has its own locked thread, so enforce the
+   //  run-to-completion timeout in each one.
+   //
+   auto lanes = LanesInUse();
+
+   for(size_t lane = 0; lane < lanes; ++lane)
+   {
+      HandleLaneTimeout(SchedLane(lane));
    }
 }
 
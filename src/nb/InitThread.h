@@ -23,6 +23,7 @@
 #define INITTHREAD_H_INCLUDED
 
 #include "Thread.h"
+#include <bitset>
 #include <cstdint>
 #include "Duration.h"
 #include "NbTypes.h"
@@ -107,6 +108,11 @@ private:
    //
    void HandleTimeout();
 
+   //  Invoked by HandleTimeout to enforce the run-to-completion timeout
+   //  on the locked thread in LANE.
+   //
+   void HandleLaneTimeout(SchedLane lane);
+
    //  Invoked if interrupted while sleeping.
    //
    void HandleInterrupt();
@@ -137,9 +143,9 @@ private:
    //
    State state_;
 
-   //  Set when a run-to-completion timeout has occurred.
+   //  Set when a run-to-completion timeout has occurred in a lane.
    //
-   bool timeout_;
+   std::bitset<SchedLane_N> timeouts_;
 };
 }
 #endif
@@ -42,11 +42,13 @@
 #include "LogBufferRegistry.h"
 #include "LogGroup.h"
 #include "LogGroupRegistry.h"
+#include "LogRing.h"
 #include "LogThread.h"
 #include "Restart.h"
 #include "Singleton.h"
 #include "Statistics.h"
 #include "SysConsole.h"
+#include "Thread.h"
 
 using std::ostream;
 using std::string;
@@ -154,6 +156,66 @@ const string Log::Tab = spaces(Indent);
 
 //------------------------------------------------------------------------------
 
+LogArg::LogArg() :
+   label_(nullptr),
+   int_(0),
+   str_(nullptr),
+   type_(DecType)
+{
+}
+
+//------------------------------------------------------------------------------
+
+LogArg::LogArg(c_string label, int64_t value) :
+   label_(label),
+   int_(value),
+   str_(nullptr),
+   type_(DecType)
+{
+}
+
+//------------------------------------------------------------------------------
+
+void LogArg::Display(ostream& stream) const
+{
+   if(label_ != nullptr) stream << label_ << '=';
+
+   switch(type_)
+   {
+   case DecType:
+      stream << int_;
+      break;
+   case HexType:
+      stream << strHex(uint64_t(int_));
+      break;
+   case StrType:
+      stream << (str_ != nullptr ? str_ : "nullptr");
+      break;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+LogArg LogArg::Hex(c_string label, uint64_t value)
+{
+   LogArg arg(label, int64_t(value));
+   arg.type_ = HexType;
+   return arg;
+}
+
+//------------------------------------------------------------------------------
+
+LogArg LogArg::Str(c_string label, c_string value)
+{
+   LogArg arg;
+   arg.label_ = label;
+   arg.str_ = value;
+   arg.type_ = StrType;
+   return arg;
+}
+
+//------------------------------------------------------------------------------
+
 fn_name Log_ctor = "Log.ctor";
 
 Log::Log(LogGroup* group, LogId id, c_string expl) :
@@ -198,6 +260,21 @@ Log::~Log()
 
 //------------------------------------------------------------------------------
 
+void Log::Buffer(const string& str) const
+{
+   Debug::ftnt("Log.Buffer");
+
+   auto buffer = Singleton<LogBufferRegistry>::Extant()->Active();
+   if(buffer == nullptr) return;
+
+   if(buffer->Push(str))
+      bufferCount_->Incr();
+   else
+      discardCount_->Incr();
+}
+
+//------------------------------------------------------------------------------
+
 ptrdiff_t Log::CellDiff()
 {
    uintptr_t local;
@@ -224,17 +301,7 @@ ostringstreamPtr Log::Create(c_string groupName, LogId id)
    auto log = NodeBase::Find(groupName, id, group);
    if(log == nullptr) return CreateStartupLog();
 
-   //  Check if the log is to be suppressed or throttled.
-   //
-   if(group->Suppressed()) return log->Suppressed();
-
-   if(log->dyn_->interval_ != 1)
-   {
-      if(log->dyn_->interval_ == 0) return log->Suppressed();
-      if(--log->dyn_->sequence_ > 0) return log->Suppressed();
-      log->dyn_->sequence_ = log->dyn_->interval_;
-   }
-
+   if(log->IsSuppressed()) return nullptr;
    return log->Format(NoAlarm);
 }
 
@@ -287,6 +354,23 @@ void Log::Display(ostream& stream,
 
 //------------------------------------------------------------------------------
 
+void Log::DisplayHeader(ostream& stream, AlarmStatus status,
+   const SystemTime::Point& time, size_t seqNo) const
+{
+   //  The first line of each log, after any alarm indicator, contains the
+   //  log's group name and identifier, followed by the time and node on
+   //  which it occurred, a sequence number, and a line feed that precedes
+   //  log-specific data.
+   //
+   stream << std::boolalpha << std::nouppercase << CRLF;
+   stream << AlarmStatusSymbol(status) << SPACE;
+   stream << group_->Name() << id_ << SPACE;
+   stream << to_string(time, FullAlpha) << " on " << Element::Name() << SPACE;
+   stream << '{' << seqNo << '}' << CRLF;
+}
+
+//------------------------------------------------------------------------------
+
 void Log::DisplayStats(ostream& stream, const Flags& options) const
 {
    Debug::ft("Log.DisplayStats");
@@ -348,21 +432,121 @@ ostringstreamPtr Log::Format(AlarmStatus status) const
    ostringstreamPtr stream(new (std::nothrow) std::ostringstream);
    if(stream == nullptr) return nullptr;
 
-   //  The first line of each log, after any alarm indicator, contains the
-   //  log's group name and identifier, followed by the time and node on
-   //  which it occurred, a sequence number, and a line feed that precedes
-   //  log-specific data.
-   //
-   *stream << std::boolalpha << std::nouppercase << CRLF;
-   *stream << AlarmStatusSymbol(status) << SPACE;
-   *stream << group_->Name() << id_ << SPACE;
-   *stream << Element::strTimePlace() << SPACE;
-   *stream << '{' << ++SeqNo_ << '}' << CRLF;
+   DisplayHeader(*stream, status, SystemTime::Now(), ++SeqNo_);
    return stream;
 }
 
 //------------------------------------------------------------------------------
 
+string Log::Format(const LogRecord& rec)
+{
+   Debug::ftnt("Log.Format(record)");
+
+   std::ostringstream stream;
+
+   rec.log->DisplayHeader(stream, NoAlarm, rec.time, rec.seqNo);
+   stream << Tab;
+
+   for(size_t i = 0; i < rec.argc; ++i)
+   {
+      if(i > 0) stream << SPACE;
+      rec.args[i].Display(stream);
+   }
+
+   stream << CRLF;
+   return stream.str();
+}
+
+//------------------------------------------------------------------------------
+
+bool Log::IsSuppressed() const
+{
+   Debug::ftnt("Log.IsSuppressed");
+
+   //  Check if the log is to be suppressed or throttled.
+   //
+   if(group_->Suppressed())
+   {
+      Suppressed();
+      return true;
+   }
+
+   if(dyn_->interval_ != 1)
+   {
+      if((dyn_->interval_ == 0) || (--dyn_->sequence_ > 0))
+      {
+         Suppressed();
+         return true;
+      }
+
+      dyn_->sequence_ = dyn_->interval_;
+   }
+
+   return false;
+}
+
+//------------------------------------------------------------------------------
+
+fn_name Log_Post = "Log.Post";
+
+void Log::Post(c_string groupName,
+   LogId id, const LogArg args[], size_t count)
+{
+   Debug::ftnt(Log_Post);
+
+   if(count > LogRecord::MaxArgs)
+   {
+      Debug::SwLog(Log_Post, "too many arguments", count);
+      count = LogRecord::MaxArgs;
+   }
+
+   //  During a restart, or if the log is not registered or the running
+   //  thread cannot save it in a ring, format it immediately.
+   //
+   LogGroup* group = nullptr;
+   auto log = NodeBase::Find(groupName, id, group);
+
+   if((log != nullptr) && (Restart::GetStage() == Running))
+   {
+      if(log->IsSuppressed()) return;
+
+      auto seqNo = ++SeqNo_;
+      if(LogRing::Push(*log, seqNo, args, count))
+      {
+         auto thread = Singleton<LogThread>::Extant();
+         if(thread != nullptr) thread->Interrupt(Thread::WorkAvailable);
+         return;
+      }
+
+      //  The ring was full, so format the log now.
+      //
+
+      LogRecord rec;
+      rec.log = log;
+      rec.time = SystemTime::Now();
+      rec.seqNo = seqNo;
+      rec.argc = count;
+      for(size_t i = 0; i < count; ++i) rec.args[i] = args[i];
+      log->Buffer(Format(rec));
+      return;
+   }
+
+   auto stream = Create(groupName, id);
+   if(stream == nullptr) return;
+
+   *stream << Log::Tab;
+
+   for(size_t i = 0; i < count; ++i)
+   {
+      if(i > 0) *stream << SPACE;
+      args[i].Display(*stream);
+   }
+
+   Submit(stream);
+}
+
+//------------------------------------------------------------------------------
+
 void Log::Patch(sel_t selector, void* arguments)
 {
    Immutable::Patch(selector, arguments);
@@ -459,13 +643,7 @@ void Log::Submit(ostringstreamPtr& stream)
 
    //  Add the log to the active log buffer.
    //
-   auto buffer = Singleton<LogBufferRegistry>::Extant()->Active();
-   if(buffer == nullptr) return;
-
-   if(buffer->Push(str))
-      log->bufferCount_->Incr();
-   else
-      log->discardCount_->Incr();
+   log->Buffer(str);
 }
 
 //------------------------------------------------------------------------------
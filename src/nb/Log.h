@@ -30,6 +30,7 @@
 #include <string>
 #include "NbTypes.h"
 #include "RegCell.h"
+#include "SystemTime.h"
 #include "SysTypes.h"
 
 namespace NodeBase
@@ -37,18 +38,76 @@ namespace NodeBase
    class Alarm;
    class LogGroup;
    struct LogDynamic;
+   struct LogRecord;
 }
 
 //------------------------------------------------------------------------------
 
 namespace NodeBase
 {
+//  An argument for a log that is generated by Log::Post.  The log is not
+//  formatted until later, so its label and a string value must reference
+//  strings with static storage duration (usually string literals).
+//
+class LogArg
+{
+public:
+   //  Creates an argument that displays VALUE in decimal.
+   //
+   LogArg(c_string label, int64_t value);
+
+   //  Creates an argument that displays VALUE in hex.
+   //
+   static LogArg Hex(c_string label, uint64_t value);
+
+   //  Creates an argument that displays VALUE.  If LABEL is nullptr, only
+   //  VALUE is displayed.
+   //
+   static LogArg Str(c_string label, c_string value);
+
+   //  Creates an empty argument.  Used for arrays.
+   //
+   LogArg();
+
+   //  Displays the argument in STREAM as "label=value".
+   //
+   void Display(std::ostream& stream) const;
+private:
+   //  Types of arguments.
+   //
+   enum Type : uint8_t
+   {
+      DecType,  // integer displayed in decimal
+      HexType,  // integer displayed in hex
+      StrType   // string
+   };
+
+   //  The argument's label.
+   //
+   c_string label_;
+
+   //  The argument's value if it is an integer.
+   //
+   int64_t int_;
+
+   //  The argument's value if it is a string.
+   //
+   c_string str_;
+
+   //  The argument's type.
+   //
+   Type type_;
+};
+
+//------------------------------------------------------------------------------
+//
 //  Interface for defining and generating logs.  Logs survive all restarts
 //  so that they can be generated during a restart.
 //
 class Log : public Immutable
 {
    friend class Alarm;
+   friend class LogRing;
 public:
    //  Deleted to prohibit copying.
    //
@@ -101,6 +160,16 @@ public:
    //
    static void Submit(ostringstreamPtr& stream);
 
+   //  Generates the log identified by groupName and ID, whose contents are
+   //  ARGS, an array of COUNT arguments displayed on one line.  Unlike Create,
+   //  which formats the log immediately, this saves the arguments in a ring
+   //  for the running thread.  LogThread formats them when it spools the log,
+   //  which makes this much less expensive than Create and Submit.  Only the
+   //  first LogRecord::MaxArgs arguments are included in the log.
+   //
+   static void Post(c_string groupName,
+      LogId id, const LogArg args[], size_t count);
+
    //  Logs a trap in main().  EX and E are the exceptions that were caught,
    //  CODE is from a system_error exception, and STACK captured the thread
    //  stack at the time of the trap.  Returns the exit code for main().
@@ -167,10 +236,30 @@ private:
    //
    ostringstreamPtr Format(AlarmStatus status = NoAlarm) const;
 
+   //  Displays, in STREAM, the header for an occurrence of the log that
+   //  has sequence number seqNo and occurred at TIME.  STATUS is used when
+   //  modifying an alarm.
+   //
+   void DisplayHeader(std::ostream& stream, AlarmStatus status,
+      const SystemTime::Point& time, size_t seqNo) const;
+
+   //  Returns the log generated by Post and saved in REC.
+   //
+   static std::string Format(const LogRecord& rec);
+
+   //  Returns true if this occurrence of the log should be suppressed or
+   //  throttled, after incrementing the count of suppressed logs.
+   //
+   bool IsSuppressed() const;
+
    //  Returns nullptr after incrementing the count of suppressed logs.
    //
    ostringstreamPtr Suppressed() const;
 
+   //  Adds STR, an occurrence of this log, to the active log buffer.
+   //
+   void Buffer(const std::string& str) const;
+
    //  The group to which the log belongs.
    //
    LogGroup* const group_;
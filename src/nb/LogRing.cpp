@@ -0,0 +1,180 @@
+//==============================================================================
+//
+//  LogRing.cpp
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "LogRing.h"
+#include <algorithm>
+#include <new>
+#include <string>
+#include <vector>
+#include "Debug.h"
+#include "LogThread.h"
+#include "Restart.h"
+#include "Statistics.h"
+#include "Thread.h"
+
+//------------------------------------------------------------------------------
+
+namespace NodeBase
+{
+//  A pointer to a thread's ring.
+//
+typedef std::atomic<LogRing*> LogRingPtr;
+
+//  The ring for each thread, indexed by ThreadId.  Allocated when the first
+//  log is posted.
+//
+static std::atomic<LogRingPtr*> Rings_ = { nullptr };
+
+//------------------------------------------------------------------------------
+//
+//  Returns true if R1 was generated before R2.
+//
+static bool LogRecordsAreSorted(const LogRecord& r1, const LogRecord& r2)
+{
+   return (r1.seqNo < r2.seqNo);
+}
+
+//------------------------------------------------------------------------------
+
+LogRing::LogRing() : head_(0), tail_(0) { }
+
+//------------------------------------------------------------------------------
+
+LogRing* LogRing::AccessRing()
+{
+   Debug::ftnt("LogRing.AccessRing");
+
+   auto thr = Thread::RunningThread(std::nothrow);
+   if(thr == nullptr) return nullptr;
+
+   //  Allocate the array of rings if it doesn't exist.  If another thread
+   //  allocates it first, free ours.
+   //
+   auto rings = Rings_.load(std::memory_order_acquire);
+
+   if(rings == nullptr)
+   {
+      auto array = new (std::nothrow) LogRingPtr[Thread::MaxId + 1];
+      if(array == nullptr) return nullptr;
+
+      for(ThreadId t = 0; t <= Thread::MaxId; ++t)
+      {
+         array[t].store(nullptr);
+      }
+
+      if(Rings_.compare_exchange_strong(rings, array))
+         rings = array;
+      else
+         delete[] array;
+   }
+
+   //  A ring is only created by the thread that owns it.
+   //
+   auto& slot = rings[thr->Tid()];
+   auto ring = slot.load(std::memory_order_acquire);
+   if(ring != nullptr) return ring;
+
+   ring = new (std::nothrow) LogRing;
+   if(ring == nullptr) return nullptr;
+   slot.store(ring, std::memory_order_release);
+   return ring;
+}
+
+//------------------------------------------------------------------------------
+
+bool LogRing::Push(const Log& log,
+   size_t seqNo, const LogArg args[], size_t count)
+{
+   Debug::ftnt("LogRing.Push");
+
+   auto ring = AccessRing();
+   if(ring == nullptr) return false;
+
+   auto head = ring->head_.load(std::memory_order_relaxed);
+   auto tail = ring->tail_.load(std::memory_order_acquire);
+   if(head - tail >= Size) return false;
+
+   auto& rec = ring->records_[head & (Size - 1)];
+   rec.log = &log;
+   rec.time = SystemTime::Now();
+   rec.seqNo = seqNo;
+   rec.argc = count;
+   for(size_t i = 0; i < count; ++i) rec.args[i] = args[i];
+
+   ring->head_.store(head + 1, std::memory_order_release);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void LogRing::Spool()
+{
+   Debug::ft("LogRing.Spool");
+
+   auto rings = Rings_.load(std::memory_order_acquire);
+   if(rings == nullptr) return;
+
+   //  Copy the records out of each ring, so that its owner can reuse their
+   //  slots, and then sort them so that their sequence numbers ascend.
+   //
+   std::vector<LogRecord> recs;
+
+   for(ThreadId t = 0; t <= Thread::MaxId; ++t)
+   {
+      auto ring = rings[t].load(std::memory_order_acquire);
+      if(ring == nullptr) continue;
+
+      auto head = ring->head_.load(std::memory_order_acquire);
+      auto tail = ring->tail_.load(std::memory_order_relaxed);
+
+      while(tail != head)
+      {
+         recs.push_back(ring->records_[tail & (Size - 1)]);
+         ++tail;
+      }
+
+      ring->tail_.store(tail, std::memory_order_release);
+   }
+
+   if(recs.empty()) return;
+
+   std::sort(recs.begin(), recs.end(), LogRecordsAreSorted);
+
+   auto running = (Restart::GetStage() == Running);
+
+   for(auto r = recs.cbegin(); r != recs.cend(); ++r)
+   {
+      auto str = Log::Format(*r);
+
+      if(running)
+      {
+         r->log->Buffer(str);
+      }
+      else
+      {
+         LogThread::Spool(str, r->log);
+
+         if(r->log->bufferCount_ != nullptr)
+            r->log->bufferCount_->Incr();
+      }
+   }
+}
+}
@@ -0,0 +1,118 @@
+//==============================================================================
+//
+//  LogRing.h
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef LOGRING_H_INCLUDED
+#define LOGRING_H_INCLUDED
+
+#include <atomic>
+#include <cstddef>
+#include "Log.h"
+#include "SystemTime.h"
+
+//------------------------------------------------------------------------------
+
+namespace NodeBase
+{
+//  An occurrence of a log that was generated by Log::Post and that has yet
+//  to be formatted.
+//
+struct LogRecord
+{
+   //> The maximum number of arguments in a log generated by Log::Post.
+   //
+   static const size_t MaxArgs = 4;
+
+   const Log* log;          // the log that was generated
+   SystemTime::Point time;  // when it was generated
+   size_t seqNo;            // its sequence number
+   size_t argc;             // the number of entries in args
+   LogArg args[MaxArgs];    // its arguments
+};
+
+//------------------------------------------------------------------------------
+//
+//  Saves the logs that one thread generates with Log::Post.  Only the thread
+//  that owns a ring adds records to it, and only LogThread removes them, so
+//  a ring needs no lock.  LogThread formats the records and moves them to
+//  the active log buffer, which keeps the cost of generating a log off the
+//  thread that generated it.
+//
+class LogRing
+{
+public:
+   //  Deleted to prohibit copying.
+   //
+   LogRing(const LogRing& that) = delete;
+
+   //  Deleted to prohibit copy assignment.
+   //
+   LogRing& operator=(const LogRing& that) = delete;
+
+   //  Saves an occurrence of LOG, with sequence number seqNo and the COUNT
+   //  arguments in ARGS, in the running thread's ring.  Returns false if
+   //  the running thread does not have a ring and one cannot be allocated,
+   //  or if its ring is full, in which case the log must be formatted
+   //  immediately.
+   //
+   static bool Push(const Log& log,
+      size_t seqNo, const LogArg args[], size_t count);
+
+   //  Formats the records in all rings, in order of sequence number, and
+   //  adds them to the active log buffer.  During a restart, they are
+   //  output immediately instead.  Invoked by LogThread.
+   //
+   static void Spool();
+private:
+   //> The number of records in each ring (in log2).
+   //
+   static const size_t Log2Size = 6;
+
+   //  The number of records in each ring.
+   //
+   static const size_t Size = 1 << Log2Size;
+
+   //  Private to restrict creation to Push.
+   //
+   LogRing();
+
+   //  Private because rings are never deleted.
+   //
+   ~LogRing() = default;
+
+   //  Returns the ring for the running thread, creating it if necessary.
+   //
+   static LogRing* AccessRing();
+
+   //  The index of the next record to be added.  Written by the thread
+   //  that owns the ring.
+   //
+   std::atomic_size_t head_;
+
+   //  The index of the next record to be removed.  Written by LogThread.
+   //
+   std::atomic_size_t tail_;
+
+   //  The records.
+   //
+   LogRecord records_[Size];
+};
+}
+#endif
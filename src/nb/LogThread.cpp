@@ -36,6 +36,7 @@
 #include "Log.h"
 #include "LogBuffer.h"
 #include "LogBufferRegistry.h"
+#include "LogRing.h"
 #include "Mutex.h"
 #include "NbDaemons.h"
 #include "NbPools.h"
@@ -121,6 +122,10 @@ void LogThread::Destroy()
 {
    Debug::ft("LogThread.Destroy");
 
+   //  Output any logs that were posted but not yet spooled, because
+   //  they may refer to logs that will not survive the restart.
+   //
+   LogRing::Spool();
    Singleton<LogThread>::Destroy();
 }
 
@@ -161,6 +166,8 @@ void LogThread::Enter()
          continue;
       }
 
+      LogRing::Spool();
+
       auto buff = reg->Active();
       CallbackRequestPtr callback;
       auto periodic = false;
@@ -43,6 +43,7 @@ class LogThread : public Thread
 {
    friend class Singleton<LogThread>;
    friend class Log;
+   friend class LogRing;
 public:
    //  Overridden to display member variables.
    //
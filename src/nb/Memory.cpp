@@ -572,6 +572,27 @@ bool Memory::Unprotect(MemoryType type)
 
 //------------------------------------------------------------------------------
 
+fn_name Memory_UnprotectPages = "Memory.UnprotectPages";
+
+bool Memory::UnprotectPages(MemoryType type, const void* addr, size_t size)
+{
+   switch(type)
+   {
+   case MemProtected:
+   case MemImmutable:
+      break;
+   default:
+      Debug::SwLog(Memory_UnprotectPages, "invalid memory type", type);
+      return true;
+   }
+
+   auto heap = AccessHeap(type);
+   if(heap == nullptr) return false;
+   return (heap->UnprotectPages(addr, size) == 0);
+}
+
+//------------------------------------------------------------------------------
+
 int Memory::Validate(MemoryType type, const void* addr)
 {
    Debug::ft("Memory.Validate");
@@ -81,7 +81,8 @@ namespace Memory
    //
    Heap* AccessHeap(MemoryType type);
 
-   //  Protects the heap for TYPE.
+   //  Protects the heap for TYPE.  This includes any pages that were
+   //  unprotected by UnprotectPages.
    //
    bool Protect(MemoryType type);
 
@@ -89,6 +90,12 @@ namespace Memory
    //
    bool Unprotect(MemoryType type);
 
+   //  Unprotects only the pages in the heap for TYPE that contain ADDR[0
+   //  to SIZE-1].  This is cheaper than unprotecting the entire heap when
+   //  only a few bytes need to be modified.
+   //
+   bool UnprotectPages(MemoryType type, const void* addr, size_t size);
+
    //  Validates ADDR, which should be of TYPE.  If ADDR is nullptr, the
    //  entire heap for TYPE is validated.  Returns
    //  o 1 if the heap was validated
@@ -82,9 +82,17 @@ void Module::Display(ostream& stream,
 {
    Immutable::Display(stream, prefix, options);
 
-   stream << prefix << "mid     : " << mid_.to_str() << CRLF;
-   stream << prefix << "symbol  : " << symbol_ << CRLF;
-   stream << prefix << "enabled : " << enabled_ << CRLF;
+   stream << prefix << "mid      : " << mid_.to_str() << CRLF;
+   stream << prefix << "symbol   : " << symbol_ << CRLF;
+   stream << prefix << "enabled  : " << enabled_ << CRLF;
+   stream << prefix << "required :";
+
+   for(size_t i = 0; i < required_.size(); ++i)
+   {
+      stream << SPACE << required_[i];
+   }
+
+   stream << CRLF;
 }
 
 //------------------------------------------------------------------------------
@@ -110,6 +118,25 @@ void Module::Patch(sel_t selector, void* arguments)
 
 //------------------------------------------------------------------------------
 
+fn_name Module_Requires = "Module.Requires";
+
+void Module::Requires(const Module& module)
+{
+   Debug::ft(Module_Requires);
+
+   auto mid = module.Mid();
+
+   if(mid == NIL_ID)
+   {
+      Debug::SwLog(Module_Requires, "module not registered", 0);
+      return;
+   }
+
+   required_.push_back(mid);
+}
+
+//------------------------------------------------------------------------------
+
 void Module::Shutdown(RestartLevel level)
 {
    Debug::ft("Module.Shutdown");
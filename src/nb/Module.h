@@ -25,6 +25,8 @@
 #include "Immutable.h"
 #include <cstddef>
 #include <string>
+#include <vector>
+#include "Allocators.h"
 #include "NbTypes.h"
 #include "RegCell.h"
 #include "SysTypes.h"
@@ -61,9 +63,9 @@ namespace NodeBase
 //          //  it adds itself to the registry, the registry will contain
 //          //  modules in the (partial) ordering of their dependencies.
 //          //
-//          Singleton<Module1>::Instance();
+//          Requires(*Singleton<Module1>::Instance());
 //          //  ...
-//          Singleton<ModuleN>::Instance();
+//          Requires(*Singleton<ModuleN>::Instance());
 //          Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 //       }
 //
@@ -135,6 +137,11 @@ public:
    //
    bool IsEnabled() const { return enabled_; }
 
+   //  Returns the identifiers of the modules that this one directly requires.
+   //
+   const std::vector<ModuleId, ImmutableAllocator<ModuleId>>&
+      Required() const { return required_; }
+
    //  Returns the offset to mid_.
    //
    static ptrdiff_t CellDiff();
@@ -166,6 +173,12 @@ protected:
    //
    Module(c_string symbol = EMPTY_STR);
 
+   //  Records that this module requires MODULE, which must already have
+   //  been added to the module registry.  Invoked by a subclass constructor
+   //  on each module that it creates because it requires that module.
+   //
+   void Requires(const Module& module);
+
    //  Removes the module from the global module registry.  Protected
    //  because subclasses should be singletons.
    //
@@ -182,6 +195,10 @@ private:
    //  Set if the module is enabled.
    //
    bool enabled_;
+
+   //  The identifiers of the modules that this one directly requires.
+   //
+   std::vector<ModuleId, ImmutableAllocator<ModuleId>> required_;
 };
 }
 #endif
@@ -33,7 +33,6 @@
 #include <sstream>
 #include "CfgParmRegistry.h"
 #include "Debug.h"
-#include "Duration.h"
 #include "Element.h"
 #include "Formatters.h"
 #include "InitFlags.h"
@@ -41,6 +40,7 @@
 #include "Log.h"
 #include "MainArgs.h"
 #include "Memory.h"
+#include "Module.h"
 #include "NbLogs.h"
 #include "NbModule.h"
 #include "NbSignals.h"
@@ -127,6 +127,24 @@ static void OutputNodeRunningLog()
    }
 }
 
+//------------------------------------------------------------------------------
+//
+//  Returns true if USER directly requires USED.
+//
+static bool RequiresModule(const Module& user, const Module& used)
+{
+   Debug::ft("NodeBase.RequiresModule");
+
+   const auto& required = user.Required();
+
+   for(size_t i = 0; i < required.size(); ++i)
+   {
+      if(required[i] == used.Mid()) return true;
+   }
+
+   return false;
+}
+
 //------------------------------------------------------------------------------
 
 static const FactionFlags& ShutdownFactions()
@@ -400,6 +418,92 @@ RestartLevel ModuleRegistry::NextLevel()
 
 //------------------------------------------------------------------------------
 
+fixed_string CriticalPathStr = "critical path";
+
+void ModuleRegistry::OutputCriticalPath
+   (const std::vector<nsecs_t>& times, bool startup) const
+{
+   Debug::ft("ModuleRegistry.OutputCriticalPath");
+
+   //  Put the modules that were started up or shut down in the order in
+   //  which that occurred, which is a topological sort of their dependencies.
+   //
+   std::vector<const Module*> order;
+
+   if(startup)
+   {
+      for(auto m = modules_.First(); m != nullptr; modules_.Next(m))
+      {
+         if(m->IsEnabled() || (m->Mid() == 1)) order.push_back(m);
+      }
+   }
+   else
+   {
+      for(auto m = modules_.Last(); m != nullptr; modules_.Prev(m))
+      {
+         if(m->IsEnabled() || (m->Mid() == 1)) order.push_back(m);
+      }
+   }
+
+   //  FINISH[mid] is when module MID would have finished if it had started
+   //  as soon as the modules that it waits for had finished.  PREV[mid] is
+   //  the last of those modules to finish, which precedes MID on its path.
+   //
+   std::vector<nsecs_t> finish(times.size(), nsecs_t(0));
+   std::vector<ModuleId> prev(times.size(), NIL_ID);
+   ModuleId last = NIL_ID;
+
+   for(size_t i = 0; i < order.size(); ++i)
+   {
+      auto mid = order[i]->Mid();
+      nsecs_t start(0);
+
+      for(size_t j = 0; j < i; ++j)
+      {
+         auto waits = (startup ? RequiresModule(*order[i], *order[j]) :
+            RequiresModule(*order[j], *order[i]));
+         if(!waits) continue;
+
+         auto pred = order[j]->Mid();
+
+         if((prev[mid] == NIL_ID) || (finish[pred] > start))
+         {
+            start = finish[pred];
+            prev[mid] = pred;
+         }
+      }
+
+      finish[mid] = start + times[mid];
+      if((last == NIL_ID) || (finish[mid] > finish[last])) last = mid;
+   }
+
+   if(last == NIL_ID) return;
+
+   //  Output the length of the critical path, followed by its modules.
+   //
+   std::vector<ModuleId> path;
+
+   for(auto mid = last; mid != NIL_ID; mid = prev[mid])
+   {
+      path.push_back(mid);
+   }
+
+   *Stream() << CriticalPathStr << setw(36 - strlen(CriticalPathStr));
+   *Stream() << finish[last].count() / NS_TO_MS << CRLF;
+
+   for(size_t i = path.size(); i > 0; --i)
+   {
+      auto mid = path[i - 1];
+      auto name = spaces(2) + strClass(modules_.At(mid));
+      *Stream() << name << setw(36 - name.size());
+      *Stream() << times[mid].count() / NS_TO_MS << CRLF;
+   }
+
+   Log::Submit(stream_);
+}
+
+//------------------------------------------------------------------------------
+
 void ModuleRegistry::Patch(sel_t selector, void* arguments)
 {
    Immutable::Patch(selector, arguments);
@@ -499,7 +603,7 @@ void ModuleRegistry::Shutdown(RestartLevel level)
       for(size_t tries = 120, idle = 0; (tries > 0) && (idle <= 8); --tries)
       {
          ThisThread::Pause(delay);
-         if(Thread::SwitchContext() != nullptr)
+         if(Thread::SwitchContext())
             idle = 0;
          else
             ++idle;
@@ -572,6 +676,8 @@ void ModuleRegistry::Shutdown(RestartLevel level)
 
    //  Modules must be shut down in reverse order of their initialization.
    //
+   std::vector<nsecs_t> times(Module::MaxId + 1, nsecs_t(0));
+
    for(auto m = modules_.Last(); m != nullptr; modules_.Prev(m))
    {
       if(m->IsEnabled() || (m->Mid() == 1))
@@ -587,6 +693,7 @@ void ModuleRegistry::Shutdown(RestartLevel level)
 
          *Stream() << ShutdownStr << setw(36 - strlen(ShutdownStr));
          elapsed = SteadyTime::Now() - point;
+         times[m->Mid()] = elapsed;
          *Stream() << elapsed.count() / NS_TO_MS << CRLF;
          Log::Submit(stream_);
       }
@@ -598,6 +705,8 @@ void ModuleRegistry::Shutdown(RestartLevel level)
    *Stream() << ShutdownTotalStr;
    *Stream() << setw(36 - width) << elapsed.count() / NS_TO_MS << CRLF;
    Log::Submit(stream_);
+
+   OutputCriticalPath(times, false);
 }
 
 //------------------------------------------------------------------------------
@@ -629,6 +738,16 @@ void ModuleRegistry::Startup(RestartLevel level)
       *Stream() << setw(16) << to_string(zeroTime, LowAlpha) << CRLF;
    }
 
+   //  Modules are started one at a time, in order, even though the critical
+   //  path reported below shows that independent modules could overlap.  A
+   //  module's Startup function creates singletons (Singleton::Instance) and
+   //  adds objects to shared registries, such as those for statistics and
+   //  configuration parameters (Registry::Insert).  None of these are
+   //  thread-safe, so starting modules in parallel would first require
+   //  locking them.
+   //
+   std::vector<nsecs_t> times(Module::MaxId + 1, nsecs_t(0));
+
    for(auto m = modules_.First(); m != nullptr; modules_.Next(m))
    {
       if(m->IsEnabled() || (m->Mid() == 1))
@@ -643,6 +762,7 @@ void ModuleRegistry::Startup(RestartLevel level)
          m->Startup(level);
 
          nsecs_t elapsed = SteadyTime::Now() - point;
+         times[m->Mid()] = elapsed;
          *Stream() << InitializedStr << setw(36 - strlen(InitializedStr));
          *Stream() << elapsed.count() / NS_TO_MS << CRLF;
          Log::Submit(stream_);
@@ -668,6 +788,8 @@ void ModuleRegistry::Startup(RestartLevel level)
    *Stream() << StartupTotalStr;
    *Stream() << setw(36 - width) << elapsed.count() / NS_TO_MS << CRLF;
    Log::Submit(stream_);
+
+   OutputCriticalPath(times, true);
 }
 
 //------------------------------------------------------------------------------
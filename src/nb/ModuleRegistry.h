@@ -25,6 +25,8 @@
 #include "Immutable.h"
 #include <memory>
 #include <string>
+#include <vector>
+#include "Duration.h"
 #include "NbTypes.h"
 #include "Registry.h"
 #include "SysTypes.h"
@@ -119,6 +121,15 @@ private:
    //
    Module* FindModule(const std::string& symbol) const;
 
+   //  Outputs the critical path through the modules that were just started
+   //  up (if STARTUP is set) or shut down.  TIMES[mid] is how long module
+   //  MID took.  A module need only wait for the modules that it requires
+   //  to start up, and for the modules that require it to shut down, so the
+   //  critical path is the minimum time in which they could all complete.
+   //
+   void OutputCriticalPath
+      (const std::vector<nsecs_t>& times, bool startup) const;
+
    //  Overridden to shut down all modules.
    //
    void Shutdown(RestartLevel level) override;
@@ -56,6 +56,10 @@ namespace NodeBase
 //  between logical units of work.  If the locked thread blocks on a mutex, no
 //  other locked thread can run, but a preemptable or high priority thread
 //  should be holding the mutex, and it should be able to run and release it.
+//  The exception is multi-lane scheduling (see SchedLane), under which locked
+//  threads in different lanes run at the same time.  Data that those threads
+//  share must then be protected by a mutex, which is why multi-lane scheduling
+//  is only compiled in when MULTI_LANE is #defined.
 //
 //  1. Whenever possible, declare a mutex at file scope in a .cpp.
 //     A mutex--especially when locked--should not be deleted.  The risk of
@@ -94,9 +94,16 @@ string FunctionTraceTool::Status() const
 {
    auto str = Tool::Status();
 
-   if(FunctionTrace::GetScope() == FunctionTrace::CountsOnly)
+   switch(FunctionTrace::GetScope())
    {
+   case FunctionTrace::CountsOnly:
       str += " (invocation counts only)";
+      break;
+   case FunctionTrace::Compact:
+      str += " (compact)";
+      break;
+   default:
+      break;
    }
 
    return str;
@@ -104,6 +104,15 @@ char FactionChar(Faction faction)
 
 //------------------------------------------------------------------------------
 
+fixed_string SchedLaneStrings[SchedLane_N + 1] =
+{
+   "service",
+   "payload",
+   ERROR_STR
+};
+
+//------------------------------------------------------------------------------
+
 LogType GetLogType(LogId id)
 {
    Debug::ftnt("NodeBase.GetLogType");
@@ -150,4 +159,15 @@ ostream& operator<<(ostream& stream, Faction faction)
       stream << FactionStrings[Faction_N];
    return stream;
 }
+
+//------------------------------------------------------------------------------
+
+ostream& operator<<(ostream& stream, SchedLane lane)
+{
+   if((lane >= 0) && (lane < SchedLane_N))
+      stream << SchedLaneStrings[lane];
+   else
+      stream << SchedLaneStrings[SchedLane_N];
+   return stream;
+}
 }
@@ -95,6 +95,22 @@ std::ostream& operator<<(std::ostream& stream, Faction faction);
 //
 char FactionChar(Faction faction);
 
+//  Scheduler lanes.  Each lane has its own active thread, so unpreemptable
+//  threads in different lanes can run at the same time (on different cores).
+//  Unless multi-lane scheduling is enabled, every faction uses ServiceLane.
+//  See ThreadAdmin::MultiLaneEnabled.
+//
+enum SchedLane
+{
+   ServiceLane,  // all factions not assigned to another lane
+   PayloadLane,  // payload and load test factions
+   SchedLane_N   // number of lanes
+};
+
+//  Inserts a string for LANE into STREAM.
+//
+std::ostream& operator<<(std::ostream& stream, SchedLane lane);
+
 //  Types of logs.  Each LogId (see below) should be defined using one
 //  of these enumerators plus an offset.
 //
@@ -196,6 +212,7 @@ class CfgStrParm;
 class Counter;
 class Accumulator;
 class HighWatermark;
+class Histogram;
 class LowWatermark;
 class StatisticsGroup;
 
@@ -206,6 +223,7 @@ typedef std::unique_ptr<CfgStrParm> CfgStrParmPtr;
 typedef std::unique_ptr<Counter> CounterPtr;
 typedef std::unique_ptr<Accumulator> AccumulatorPtr;
 typedef std::unique_ptr<HighWatermark> HighWatermarkPtr;
+typedef std::unique_ptr<Histogram> HistogramPtr;
 typedef std::unique_ptr<LowWatermark> LowWatermarkPtr;
 typedef std::unique_ptr<StatisticsGroup> StatisticsGroupPtr;
 
@@ -37,6 +37,7 @@
 #include "FunctionGuard.h"
 #include "Log.h"
 #include "Memory.h"
+#include "Mutex.h"
 #include "NbLogs.h"
 #include "ObjectPoolRegistry.h"
 #include "ObjectPoolTrace.h"
@@ -47,6 +48,8 @@
 #include "Singleton.h"
 #include "Statistics.h"
 #include "ThisThread.h"
+#include "Thread.h"
+#include "ThreadAdmin.h"
 #include "ToolTypes.h"
 #include "TraceBuffer.h"
 
@@ -64,6 +67,7 @@ struct BlockHeader
 {
    ObjectPoolId pid : 8;       // the pool to which the block belongs
    PooledObjectSeqNo seq : 8;  // the block's sequence number
+   PooledObjectId bid;         // the block's identifier
 };
 
 //  This struct references the block for a Pooled and the location
@@ -87,6 +91,25 @@ static ObjectBlock* ObjToBlock(const Pooled* obj)
    return (ObjectBlock*) getptr1(obj, BlockHeaderSize);
 }
 
+//------------------------------------------------------------------------------
+//
+//  Returns the word in MARKS that contains the bit for the Kth block in a
+//  segment.
+//
+static std::atomic<uword>& MarkWord(std::atomic<uword>* marks, size_t k)
+{
+   return marks[k / BITS_PER_WORD];
+}
+
+//------------------------------------------------------------------------------
+//
+//  Returns the bit for the Kth block in a segment within its MarkWord.
+//
+static uword MarkBit(size_t k)
+{
+   return uword(1) << (k % BITS_PER_WORD);
+}
+
 //==============================================================================
 //
 //  The configuration parameter for an object pool, which expands
@@ -198,6 +221,45 @@ ObjectPoolStats::~ObjectPoolStats()
 
 //==============================================================================
 //
+//> The maximum number of blocks in a magazine.  An empty magazine is refilled
+//  with half this many blocks, and half the blocks in a full magazine are
+//  returned to the free queue.
+//
+constexpr size_t MagazineSize = 32;
+
+//  A cache of free blocks for the unpreemptable application threads in a
+//  scheduler lane.  Only one of these threads runs in a lane at any time,
+//  so it can allocate and free blocks without acquiring FreeqLock_.
+//
+struct BlockMagazine
+{
+   //  Constructor.
+   //
+   BlockMagazine() : count_(0), busy_(false), stuck_(0)
+   {
+      blocks_.Init(Pooled::LinkDiff());
+   }
+
+   //  The magazine's blocks.
+   //
+   Q1Way<Pooled> blocks_;
+
+   //  The number of blocks in blocks_.
+   //
+   size_t count_;
+
+   //  Set while the magazine is being accessed.  This prevents the
+   //  object pool audit from reclaiming its blocks at the same time.
+   //
+   std::atomic_bool busy_;
+
+   //  The number of consecutive audits that found the magazine busy.
+   //
+   uint8_t stuck_;
+};
+
+//------------------------------------------------------------------------------
+//
 //  Data that changes too frequently to unprotect and reprotect memory
 //  when it needs to be modified.
 //
@@ -209,7 +271,9 @@ struct ObjectPoolDynamic : public Persistent
       availCount_(0),
       totalCount_(0),
       delta_(0),
-      corruptQHead_(false)
+      corruptQHead_(false),
+      marked_(false),
+      recovered_(0)
    {
       freeq_.Init(Pooled::LinkDiff());
    }
@@ -218,7 +282,8 @@ struct ObjectPoolDynamic : public Persistent
    //
    Q1Way<Pooled> freeq_;
 
-   //  The number of blocks in freeq_.
+   //  The number of blocks in freeq_.  Blocks in magazines are counted
+   //  separately.
    //
    size_t availCount_;
 
@@ -233,8 +298,38 @@ struct ObjectPoolDynamic : public Persistent
    //  Used to detect a corrupt queue header when auditing freeq_.
    //
    bool corruptQHead_;
+
+   //  Set from the time that AuditFreeq marks the pool's blocks until
+   //  RecoverBlocks has swept all of them.  Atomic because threads in
+   //  other scheduler lanes read it without acquiring FreeqLock_ when
+   //  they allocate or free blocks from their magazines.
+   //
+   std::atomic_bool marked_;
+
+   //  The number of orphans recovered by the current sweep.
+   //
+   size_t recovered_;
+
+   //  The magazine for each scheduler lane.
+   //
+   BlockMagazine mags_[SchedLane_N];
 };
 
+//==============================================================================
+//
+//  Critical section lock for free queues.  Unpreemptable threads are normally
+//  mutually excluded, so it is only needed when multi-lane scheduling allows
+//  them to run at the same time.
+//
+static Mutex FreeqLock_("ObjectPoolFreeqLock");
+
+//  Returns the lock for free queues, or nullptr if it is not needed.
+//
+static Mutex* FreeqLock()
+{
+   return (ThreadAdmin::MultiLaneEnabled() ? &FreeqLock_ : nullptr);
+}
+
 //==============================================================================
 
 const ObjectPoolId ObjectPool::MaxId = 255;
@@ -249,6 +344,11 @@ constexpr uint8_t OrphanThreshold = 4;
 //
 constexpr size_t OrphanMaxLogs = 8;
 
+//> The maximum number of segments that RecoverBlocks sweeps before it
+//  returns so that the audit can pause.
+//
+constexpr size_t SweepSegments = 16;
+
 ObjectPool::ObjectPool
    (ObjectPoolId pid, MemoryType mem, size_t size, const string& name) :
    name_(name.c_str()),
@@ -260,6 +360,7 @@ ObjectPool::ObjectPool
    currSegments_(0),
    targSegmentsCfg_(nullptr),
    blocks_{nullptr},
+   marks_{nullptr},
    alarm_(nullptr)
 {
    Debug::ft("ObjectPool.ctor");
@@ -293,6 +394,8 @@ ObjectPool::~ObjectPool()
    {
       Memory::Free(blocks_[i], mem_);
       blocks_[i] = nullptr;
+      Memory::Free(marks_[i], mem_);
+      marks_[i] = nullptr;
    }
 
    Singleton<ObjectPoolRegistry>::Extant()->UnbindPool(*this);
@@ -308,10 +411,16 @@ bool ObjectPool::AllocBlocks()
    {
       auto pid = Pid();
       auto size = sizeof(uword) * segSize_;
-      blocks_[currSegments_] = (uword*) Memory::Alloc(size, mem_, std::nothrow);
+      auto seg = (uword*) Memory::Alloc(size, mem_, std::nothrow);
+      size = sizeof(uword) * MarkWords;
+      auto marks =
+         (std::atomic<uword>*) Memory::Alloc(size, mem_, std::nothrow);
 
-      if(blocks_[currSegments_] == nullptr)
+      if((seg == nullptr) || (marks == nullptr))
       {
+         Memory::Free(seg, mem_);
+         Memory::Free(marks, mem_);
+
          auto log = Log::Create(ObjPoolLogGroup, ObjPoolExpansionFailed);
 
          if(log != nullptr)
@@ -325,10 +434,16 @@ bool ObjectPool::AllocBlocks()
          return false;
       }
 
+      for(size_t w = 0; w < MarkWords; ++w)
+      {
+         marks[w].store(0);
+      }
+
+      blocks_[currSegments_] = seg;
+      marks_[currSegments_] = marks;
       auto bid = currSegments_ << ObjectsPerSegmentLog2;
       ++currSegments_;
       dyn_->totalCount_ = currSegments_ * ObjectsPerSegment;
-      auto seg = blocks_[currSegments_ - 1];
 
       for(size_t j = 0; j < segSize_; j += segIncr_)
       {
@@ -336,6 +451,7 @@ bool ObjectPool::AllocBlocks()
          ++bid;
          b->header.pid = pid;
          b->header.seq = 0;
+         b->header.bid = PooledObjectId(bid);
          b->obj.link_.next = nullptr;
          b->obj.assigned_ = false;
          b->obj.orphaned_ = OrphanThreshold;
@@ -361,29 +477,35 @@ void ObjectPool::AuditFreeq()
 
    size_t count = 0;
 
-   //  Increment all orphan counts.  The free queue is checked immediately
-   //  after marking the blocks so that if the traversal finds an unmarked
-   //  block, it knows that the previous block has a bad pointer (either
-   //  back to an earlier point in the queue or to something that isn't a
-   //  block in the pool).
+   //  Mark all blocks by setting every bit in each segment's bitmap.  The
+   //  free queue is checked immediately after marking the blocks so that if
+   //  the traversal finds an unmarked block, it knows that the previous block
+   //  has a bad pointer (either back to an earlier point in the queue or to
+   //  something that isn't a block in the pool).
    //
    //  NOTE: The buffer is locked here because, if trace wraparound occurs,
    //  ====  a trace record's destructor might return a block to the pool.
-   //        Such a block will have a zero orphaned_ count (see EnqBlock),
-   //        which will cause us to believe that the queue is corrupt.
+   //        Such a block will be unmarked (see EnqBlock), which will cause
+   //        us to believe that the queue is corrupt.
    //
    auto buff = Singleton<TraceBuffer>::Instance();
 
    buff->Lock();
    {
+      MutexGuard guard(FreeqLock());
+
+      ReclaimMagazines();
+
+      dyn_->marked_.store(true);
+      dyn_->recovered_ = 0;
+
       for(size_t i = 0; i < currSegments_; ++i)
       {
-         auto seg = blocks_[i];
+         auto marks = marks_[i];
 
-         for(size_t j = 0; j < segSize_; j += segIncr_)
+         for(size_t w = 0; w < MarkWords; ++w)
          {
-            auto b = (ObjectBlock*) &seg[j];
-            ++b->obj.orphaned_;
+            marks[w].store(~uword(0));
          }
       }
 
@@ -404,7 +526,7 @@ void ObjectPool::AuditFreeq()
          //
          //  Before a link (CURR) is followed, the item (queue header or
          //  block) that provided the link is marked as corrupt.  If the
-         //  link is bad, a trap should occur at curr->orphaned_ = 0.
+         //  link is bad, a trap should occur when reading CURR's header.
          //  Thus, if we get past that point in the code, the link should
          //  be sane, and so its owner's "corrupt" flag is cleared before
          //  continuing down the queue.
@@ -435,14 +557,21 @@ void ObjectPool::AuditFreeq()
                   prev->corrupt_ = true;
             }
 
-            //  CURR has not yet been claimed, so it should still be marked as
-            //  orphaned (a value in the range 1 to OrphanThreshold).  If it
-            //  isn't, PREV's link must be corrupt.  PREV might be pointing
-            //  back into the middle of the queue, or it might be a random
-            //  but legal address.
+            //  CURR has not yet been visited, so it should be a block in this
+            //  pool that is still marked.  If it isn't, PREV's link must be
+            //  corrupt.  PREV might be pointing back into the middle of the
+            //  queue, or it might be a random but legal address.
             //
-            badLink = badLink ||
-               ((curr->orphaned_ == 0) || (curr->orphaned_ > OrphanThreshold));
+            size_t i = 0;
+            size_t k = 0;
+
+            if(!badLink)
+            {
+               if(ObjToIndices(curr, i, k))
+                  badLink = ((MarkWord(marks_[i], k).load() & MarkBit(k)) == 0);
+               else
+                  badLink = true;
+            }
 
             //  If a bad link was detected, generate a log and truncate the
             //  queue.
@@ -477,6 +606,7 @@ void ObjectPool::AuditFreeq()
                return;
             }
 
+            MarkWord(marks_[i], k).fetch_and(~MarkBit(k));
             curr->orphaned_ = 0;
             ++count;
 
@@ -517,7 +647,14 @@ void ObjectPool::AuditFreeq()
 
 size_t ObjectPool::AvailCount() const
 {
-   return dyn_->availCount_;
+   auto count = dyn_->availCount_;
+
+   for(auto lane = 0; lane < SchedLane_N; ++lane)
+   {
+      count += dyn_->mags_[lane].count_;
+   }
+
+   return count;
 }
 
 //------------------------------------------------------------------------------
@@ -605,39 +742,51 @@ Pooled* ObjectPool::DeqBlock(size_t size)
 
    stats_->lowExcess_->Update(maxsize - size);
 
-   //  If the free queue is empty, invoke UpdateAlarm, which will also
-   //  allocate another segment.
+   //  Allocate the block from the running thread's magazine if possible.
    //
-   auto empty = false;
+   auto item = DeqMagazine();
 
-   if(dyn_->freeq_.Empty())
+   if(item == nullptr)
    {
-      empty = true;
-      UpdateAlarm();
-      stats_->lowCount_->Update(0);
-   }
+      //  If the free queue is empty, invoke UpdateAlarm, which will also
+      //  allocate another segment.
+      //
+      MutexGuard guard(FreeqLock());
+      auto empty = false;
 
-   auto item = dyn_->freeq_.Deq();
+      if(dyn_->freeq_.Empty())
+      {
+         empty = true;
+         UpdateAlarm();
+         stats_->lowCount_->Update(0);
+      }
 
-   if(item == nullptr)
-   {
-      stats_->failCount_->Incr();
-      throw AllocationException(mem_, size);
-   }
+      item = dyn_->freeq_.Deq();
 
-   --dyn_->availCount_;
-   stats_->allocCount_->Incr();
+      if(item == nullptr)
+      {
+         stats_->failCount_->Incr();
+         throw AllocationException(mem_, size);
+      }
 
-   if(!empty)
-   {
-      stats_->lowCount_->Update(dyn_->availCount_);
+      --dyn_->availCount_;
+      stats_->allocCount_->Incr();
 
-      if(--dyn_->delta_ <= -50)
+      if(!empty)
       {
-         UpdateAlarm();
+         stats_->lowCount_->Update(AvailCount());
+
+         if(--dyn_->delta_ <= -50)
+         {
+            UpdateAlarm();
+         }
       }
    }
 
+   //  If the audit has marked the pool's blocks, this one is not an orphan.
+   //
+   if(dyn_->marked_.load()) Unmark(item);
+
    if(Debug::TraceOn())
    {
       auto buff = Singleton<TraceBuffer>::Instance();
@@ -654,6 +803,37 @@ Pooled* ObjectPool::DeqBlock(size_t size)
 
 //------------------------------------------------------------------------------
 
+Pooled* ObjectPool::DeqMagazine()
+{
+   Debug::ft("ObjectPool.DeqMagazine");
+
+   SchedLane lane;
+
+   if(Restart::GetStage() != Running) return nullptr;
+   if(!Thread::RunningLocked(lane)) return nullptr;
+
+   //  If the audit is reclaiming the magazine's blocks, use the free queue.
+   //
+   auto& mag = dyn_->mags_[lane];
+   if(mag.busy_.exchange(true)) return nullptr;
+
+   if(mag.count_ == 0) RefillMagazine(mag);
+
+   auto item = mag.blocks_.Deq();
+
+   if(item != nullptr)
+   {
+      --mag.count_;
+      stats_->allocCount_->Incr();
+      stats_->lowCount_->Update(AvailCount());
+   }
+
+   mag.busy_.store(false);
+   return item;
+}
+
+//------------------------------------------------------------------------------
+
 void ObjectPool::Display(ostream& stream,
    const string& prefix, const Flags& options) const
 {
@@ -674,8 +854,20 @@ void ObjectPool::Display(ostream& stream,
    stream << prefix << "alarm           : " << strObj(alarm_) << CRLF;
    stream << prefix << "delta           : " << int(dyn_->delta_) << CRLF;
    stream << prefix << "corruptQHead    : " << dyn_->corruptQHead_ << CRLF;
+   stream << prefix << "marked          : " << dyn_->marked_.load() << CRLF;
+   stream << prefix << "recovered       : " << dyn_->recovered_ << CRLF;
 
    auto lead = prefix + spaces(2);
+   stream << prefix << "mags [SchedLane]" << CRLF;
+
+   for(auto lane = 0; lane < SchedLane_N; ++lane)
+   {
+      const auto& mag = dyn_->mags_[lane];
+      stream << lead << strIndex(lane) << "count=" << mag.count_;
+      stream << " busy=" << mag.busy_.load();
+      stream << " stuck=" << int(mag.stuck_) << CRLF;
+   }
+
    stream << prefix << "blocks [segment]" << CRLF;
 
    for(size_t i = 0; i < currSegments_; ++i)
@@ -735,6 +927,34 @@ size_t ObjectPool::DisplayUsed(ostream& stream,
 
 //------------------------------------------------------------------------------
 
+void ObjectPool::DrainMagazine(BlockMagazine& mag, size_t count)
+{
+   Debug::ft("ObjectPool.DrainMagazine");
+
+   MutexGuard guard(FreeqLock());
+
+   size_t moved = 0;
+
+   while(moved < count)
+   {
+      auto item = mag.blocks_.Deq();
+      if(item == nullptr) break;
+      dyn_->freeq_.Enq(*item);
+      ++moved;
+   }
+
+   mag.count_ = (moved < mag.count_ ? mag.count_ - moved : 0);
+   dyn_->availCount_ += moved;
+   dyn_->delta_ += int8_t(moved);
+
+   if(dyn_->delta_ >= 50)
+   {
+      UpdateAlarm();
+   }
+}
+
+//------------------------------------------------------------------------------
+
 fn_name ObjectPool_EnqBlock = "ObjectPool.EnqBlock";
 
 void ObjectPool::EnqBlock(Pooled* obj, bool deleted)
@@ -790,6 +1010,16 @@ void ObjectPool::EnqBlock(Pooled* obj, bool deleted)
    obj->corrupt_ = false;
    obj->logged_ = false;
 
+   //  If the audit has marked the pool's blocks, this one is not an orphan.
+   //
+   if(dyn_->marked_.load()) Unmark(obj);
+
+   //  Return a deleted block to the running thread's magazine if possible.
+   //
+   if(deleted && EnqMagazine(*obj)) return;
+
+   MutexGuard guard(FreeqLock());
+
    if(!dyn_->freeq_.Enq(*obj))
    {
       Debug::SwLog(ObjectPool_EnqBlock,
@@ -812,6 +1042,32 @@ void ObjectPool::EnqBlock(Pooled* obj, bool deleted)
 
 //------------------------------------------------------------------------------
 
+bool ObjectPool::EnqMagazine(Pooled& obj)
+{
+   Debug::ft("ObjectPool.EnqMagazine");
+
+   SchedLane lane;
+
+   if(Restart::GetStage() != Running) return false;
+   if(!Thread::RunningLocked(lane)) return false;
+
+   //  If the audit is reclaiming the magazine's blocks, use the free queue.
+   //
+   auto& mag = dyn_->mags_[lane];
+   if(mag.busy_.exchange(true)) return false;
+
+   if(mag.count_ >= MagazineSize) DrainMagazine(mag, MagazineSize >> 1);
+
+   auto queued = mag.blocks_.Enq(obj);
+   if(queued) ++mag.count_;
+   mag.busy_.store(false);
+
+   if(queued) stats_->freeCount_->Incr();
+   return queued;
+}
+
+//------------------------------------------------------------------------------
+
 void ObjectPool::EnsureAlarm()
 {
    Debug::ft("ObjectPool.EnsureAlarm");
@@ -927,7 +1183,7 @@ bool ObjectPool::IndicesToBid(size_t i, size_t j, PooledObjectId& bid) const
 
 size_t ObjectPool::InUseCount() const
 {
-   return dyn_->totalCount_ - dyn_->availCount_;
+   return dyn_->totalCount_ - AvailCount();
 }
 
 //------------------------------------------------------------------------------
@@ -937,6 +1193,7 @@ size_t ObjectPool::LowAvailCount() const
    return stats_->lowCount_->Curr();
 }
 
+
 //------------------------------------------------------------------------------
 
 ObjectBlock* ObjectPool::Next(PooledObjectId& bid) const
@@ -1048,6 +1305,22 @@ PooledObjectSeqNo ObjectPool::ObjSeq(const Pooled* obj)
 
 //------------------------------------------------------------------------------
 
+bool ObjectPool::ObjToIndices(const Pooled* obj, size_t& i, size_t& k) const
+{
+   auto block = ObjToBlock(obj);
+   if(block == nullptr) return false;
+
+   auto bid = block->header.bid;
+   size_t j = 0;
+   if(!BidToIndices(bid, i, j)) return false;
+   if((ObjectBlock*) &blocks_[i][j] != block) return false;
+
+   k = (bid - 1) & ObjectSecondIndexMask;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
 void ObjectPool::Patch(sel_t selector, void* arguments)
 {
    Protected::Patch(selector, arguments);
@@ -1055,87 +1328,185 @@ void ObjectPool::Patch(sel_t selector, void* arguments)
 
 //------------------------------------------------------------------------------
 
-void ObjectPool::RecoverBlocks()
+void ObjectPool::ReclaimMagazines()
+{
+   Debug::ft("ObjectPool.ReclaimMagazines");
+
+   for(auto lane = 0; lane < SchedLane_N; ++lane)
+   {
+      auto& mag = dyn_->mags_[lane];
+
+      if(!mag.busy_.exchange(true))
+      {
+         DrainMagazine(mag, SIZE_MAX);
+         mag.stuck_ = 0;
+         mag.busy_.store(false);
+         continue;
+      }
+
+      //  The magazine is in use.  Its blocks can stay in it until the next
+      //  audit, but not when they have been unclaimed for so long that they
+      //  are about to be recovered as orphans.  A thread must have trapped
+      //  while using the magazine, so abandon it and let its blocks be
+      //  recovered.
+      //
+      if(++mag.stuck_ >= OrphanThreshold)
+      {
+         mag.blocks_.Init(Pooled::LinkDiff());
+         mag.count_ = 0;
+         mag.stuck_ = 0;
+         mag.busy_.store(false);
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+
+bool ObjectPool::RecoverBlocks(size_t& seg)
 {
    Debug::ft("ObjectPool.RecoverBlocks");
 
    auto pid = Pid();
    auto buff = Singleton<TraceBuffer>::Instance();
-   size_t count = 0;
+   auto last = seg + SweepSegments;
+   if(last > currSegments_) last = currSegments_;
 
-   //  Run through all of the blocks, recovering orphans.
+   //  Sweep the next slice of segments, recovering orphans.  A block that
+   //  is still marked was neither on the free queue nor claimed, so its
+   //  orphan count is incremented.  A word whose bits are all clear can be
+   //  skipped, so only the blocks that are still marked need to be visited.
    //
-   for(size_t i = 0; i < currSegments_; ++i)
+   //  Threads in other scheduler lanes, and all threads between slices, can
+   //  allocate and free blocks during the sweep, which unmarks them.  Each
+   //  bit is therefore cleared atomically before its block is handled, and
+   //  the block is skipped if the bit was already clear.  Clearing the bit
+   //  first means that if this code is reentered after a trap, the block
+   //  that caused it is not revisited until the next audit, when it will
+   //  already be marked corrupt.  A block that has remained unclaimed for
+   //  OrphanThreshold audits is assumed to have no owner that could free
+   //  it while it is being recovered.
+   //
+   for(NO_OP; seg < last; ++seg)
    {
-      auto seg = blocks_[i];
+      auto marks = marks_[seg];
 
-      for(size_t j = 0; j < segSize_; j += segIncr_)
+      for(size_t w = 0; w < MarkWords; ++w)
       {
-         auto b = (ObjectBlock*) &seg[j];
-         auto p = &b->obj;
+         auto bits = marks[w].load();
 
-         if(p->orphaned_ >= OrphanThreshold)
+         while(bits != 0)
          {
-            //  Generate a log if the block is in use (don't bother with
-            //  free queue orphans) and it hasn't been logged yet (which
-            //  can happen if we reenter this code after a trap).
-            //
-            ++count;
+            auto n = find_first_one(bits);
+            auto bit = uword(1) << n;
+            auto k = (w * BITS_PER_WORD) + n;
+            auto b = (ObjectBlock*) &blocks_[seg][k * segIncr_];
+            auto p = &b->obj;
+            bits &= ~bit;
+
+            if((marks[w].fetch_and(~bit) & bit) == 0) continue;
 
-            if(Debug::TraceOn())
+            if(++p->orphaned_ >= OrphanThreshold)
             {
-               if(buff->ToolIsOn(ObjPoolTracer))
+               //  Generate a log if the block is in use (don't bother with
+               //  free queue orphans) and it hasn't been logged yet (which
+               //  can happen if we reenter this code after a trap).
+               //
+               ++dyn_->recovered_;
+
+               if(Debug::TraceOn())
                {
-                  auto rec =
-                     new ObjectPoolTrace(ObjectPoolTrace::Recovered, *p);
-                  buff->Insert(rec);
+                  if(buff->ToolIsOn(ObjPoolTracer))
+                  {
+                     auto rec =
+                        new ObjectPoolTrace(ObjectPoolTrace::Recovered, *p);
+                     buff->Insert(rec);
+                  }
                }
-            }
 
-            if(p->assigned_ && !p->logged_ && (count <= OrphanMaxLogs))
-            {
-               auto log = Log::Create(ObjPoolLogGroup, ObjPoolBlockRecovered);
+               if(p->assigned_ && !p->logged_ &&
+                  (dyn_->recovered_ <= OrphanMaxLogs))
+               {
+                  auto log =
+                     Log::Create(ObjPoolLogGroup, ObjPoolBlockRecovered);
+
+                  if(log != nullptr)
+                  {
+                     *log << Log::Tab << "pool=" << int(pid) << CRLF;
+                     p->logged_ = true;
+                     p->Display(*log, Log::Tab, VerboseOpt);
+                     Log::Submit(log);
+                  }
+               }
 
-               if(log != nullptr)
+               //  When an in-use orphan is found, we mark it corrupt and
+               //  clean it up.  If it is so corrupt that it causes an
+               //  exception during cleanup, this code is reentered and
+               //  encounters the block again.  It will then already be
+               //  marked as corrupt, in which case it will simply be
+               //  returned to the free queue.
+               //
+               if(p->assigned_ && !p->corrupt_)
                {
-                  *log << Log::Tab << "pool=" << int(pid) << CRLF;
-                  p->logged_ = true;
-                  p->Display(*log, Log::Tab, VerboseOpt);
-                  Log::Submit(log);
+                  p->corrupt_ = true;
+                  p->Cleanup();
                }
-            }
 
-            //  When an in-use orphan is found, we mark it corrupt and clean
-            //  it up.  If it is so corrupt that it causes an exception during
-            //  cleanup, this code is reentered and encounters the block again.
-            //  It will then already be marked as corrupt, in which case it
-            //  will simply be returned to the free queue.
-            //
-            if(p->assigned_ && !p->corrupt_)
-            {
-               p->corrupt_ = true;
-               p->Cleanup();
+               b->header.pid = pid;
+               p->link_.next = nullptr;
+               EnqBlock(p, false);
+               stats_->auditCount_->Incr();
             }
-
-            b->header.pid = pid;
-            p->link_.next = nullptr;
-            EnqBlock(p, false);
-            stats_->auditCount_->Incr();
          }
       }
    }
 
-   if(count > 0)
+   if(seg < currSegments_) return false;
+
+   //  All segments have been swept.
+   //
+   dyn_->marked_.store(false);
+
+   if(dyn_->recovered_ > 0)
    {
       auto log = Log::Create(ObjPoolLogGroup, ObjPoolBlocksRecovered);
 
       if(log != nullptr)
       {
          *log << Log::Tab << "pool=" << int(pid);
-         *log << " recovered=" << count;
+         *log << " recovered=" << dyn_->recovered_;
          Log::Submit(log);
       }
    }
+
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void ObjectPool::RefillMagazine(BlockMagazine& mag)
+{
+   Debug::ft("ObjectPool.RefillMagazine");
+
+   MutexGuard guard(FreeqLock());
+
+   size_t moved = 0;
+
+   while(moved < (MagazineSize >> 1))
+   {
+      auto item = dyn_->freeq_.Deq();
+      if(item == nullptr) break;
+      mag.blocks_.Enq(*item);
+      ++moved;
+   }
+
+   mag.count_ += moved;
+   dyn_->availCount_ -= moved;
+   dyn_->delta_ -= int8_t(moved);
+
+   if(dyn_->delta_ <= -50)
+   {
+      UpdateAlarm();
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -1155,7 +1526,12 @@ void ObjectPool::Shutdown(RestartLevel level)
 
    if(Restart::ClearsMemory(mem_))
    {
-      for(size_t i = 0; i < MaxSegments; ++i) blocks_[i] = nullptr;
+      for(size_t i = 0; i < MaxSegments; ++i)
+      {
+         blocks_[i] = nullptr;
+         marks_[i] = nullptr;
+      }
+
       currSegments_ = 0;
       new (dyn_.get()) ObjectPoolDynamic();
    }
@@ -1179,6 +1555,19 @@ void ObjectPool::Startup(RestartLevel level)
 
 //------------------------------------------------------------------------------
 
+void ObjectPool::Unmark(const Pooled* obj)
+{
+   size_t i = 0;
+   size_t k = 0;
+
+   if(ObjToIndices(obj, i, k))
+   {
+      MarkWord(marks_[i], k).fetch_and(~MarkBit(k));
+   }
+}
+
+//------------------------------------------------------------------------------
+
 void ObjectPool::UpdateAlarm()
 {
    Debug::ft("ObjectPool.UpdateAlarm");
@@ -1194,12 +1583,13 @@ void ObjectPool::UpdateAlarm()
    //    o none: more than 1/16th available
    //
    auto status = NoAlarm;
+   auto avail = AvailCount();
 
-   if(dyn_->availCount_ <= (dyn_->totalCount_ >> 6))
+   if(avail <= (dyn_->totalCount_ >> 6))
       status = CriticalAlarm;
-   else if(dyn_->availCount_ <= (dyn_->totalCount_ >> 5))
+   else if(avail <= (dyn_->totalCount_ >> 5))
       status = MajorAlarm;
-   else if(dyn_->availCount_ <= (dyn_->totalCount_ >> 4))
+   else if(avail <= (dyn_->totalCount_ >> 4))
       status = MinorAlarm;
 
    auto log = alarm_->Create(ObjPoolLogGroup, ObjPoolBlocksInUse, status);
@@ -1208,7 +1598,7 @@ void ObjectPool::UpdateAlarm()
    //  When the number of available blocks drops to a dangerous level,
    //  add another segment to the pool.
    //
-   if(dyn_->availCount_ <= (dyn_->totalCount_ >> 7))
+   if(avail <= (dyn_->totalCount_ >> 7))
    {
       RestartLevel level;
       auto size = std::to_string(currSegments_ + 1);
@@ -23,6 +23,7 @@
 #define OBJECTPOOL_H_INCLUDED
 
 #include "Protected.h"
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
@@ -35,6 +36,7 @@
 namespace NodeBase
 {
    class Alarm;
+   struct BlockMagazine;
    struct ObjectBlock;
    struct ObjectPoolDynamic;
    class ObjectPoolStats;
@@ -55,6 +57,7 @@ class ObjectPool : public Protected
 {
    friend class ObjectPoolRegistry;
    friend class ObjectPoolSizeCfg;
+   friend class Pooled;
    friend class Registry<ObjectPool>;
 public:
    //  Deleted to prohibit copying.
@@ -140,7 +143,8 @@ public:
    //
    Pooled* BidToObj(PooledObjectId bid) const;
 
-   //  Returns the total number of blocks on the free queue.
+   //  Returns the total number of available blocks, on the free queue
+   //  and in magazines.
    //
    size_t AvailCount() const;
 
@@ -226,6 +230,11 @@ private:
    //
    static const size_t ObjectSecondIndexMask = ObjectsPerSegment - 1;
 
+   //  The number of words in a segment's mark bitmap, which has one bit
+   //  for each block in the segment.
+   //
+   static const size_t MarkWords = ObjectsPerSegment / BITS_PER_WORD;
+
    //  Creates or expands the object pool so that it contains the target
    //  number of segments.  A pool's size can be increased at run time,
    //  but it can only be decreased during a restart.
@@ -253,6 +262,17 @@ private:
    //
    bool IndicesToBid(size_t i, size_t j, PooledObjectId& bid) const;
 
+   //  Maps OBJ to the index of its segment (I) and its offset within that
+   //  segment (K), using the block identifier saved in its header.  Returns
+   //  false if OBJ does not reference a block in the pool.
+   //
+   bool ObjToIndices(const Pooled* obj, size_t& i, size_t& k) const;
+
+   //  Clears OBJ's bit in its segment's mark bitmap so that the audit will
+   //  not treat it as an orphan.
+   //
+   void Unmark(const Pooled* obj);
+
    //  Ensures that the low availability alarm exists.
    //
    void EnsureAlarm();
@@ -261,15 +281,42 @@ private:
    //
    void UpdateAlarm();
 
-   //  Marks all blocks as orphaned and audits the free queue for sanity,
-   //  unmarking its blocks so that they will not be recovered.
+   //  Marks all blocks as orphaned by setting every bit in each segment's
+   //  mark bitmap, and audits the free queue for sanity, unmarking its
+   //  blocks so that they will not be recovered.
    //
    void AuditFreeq();
 
    //  Recovers orphaned blocks after AuditFreeq and ClaimBlocks have
-   //  marked all in-use and free blocks.
+   //  unmarked all in-use and free blocks.  Sweeps a bounded slice of
+   //  segments, starting at SEG, and updates SEG to the next segment to
+   //  be swept.  Returns true once all segments have been swept.
+   //
+   bool RecoverBlocks(size_t& seg);
+
+   //  Allocates a block from the running thread's magazine.  Returns
+   //  nullptr if the thread cannot use a magazine or if its magazine
+   //  cannot be refilled from the free queue.
+   //
+   Pooled* DeqMagazine();
+
+   //  Returns OBJ's block to the running thread's magazine.  Returns false
+   //  if the thread cannot use a magazine.
+   //
+   bool EnqMagazine(Pooled& obj);
+
+   //  Moves a batch of blocks from the free queue to MAG.
+   //
+   void RefillMagazine(BlockMagazine& mag);
+
+   //  Moves COUNT blocks from MAG to the free queue.
    //
-   void RecoverBlocks();
+   void DrainMagazine(BlockMagazine& mag, size_t count);
+
+   //  Returns the blocks in all magazines to the free queue so that they
+   //  can be audited.  Invoked by AuditFreeq.
+   //
+   void ReclaimMagazines();
 
    //  Returns the offset to pid_.
    //
@@ -318,6 +365,10 @@ private:
    //
    uword* blocks_[MaxSegments];
 
+   //  The mark bitmap for each segment, used by the audit to find orphans.
+   //
+   std::atomic<uword>* marks_[MaxSegments];
+
    //  The alarm raised when the percentage of blocks in use is high.
    //
    Alarm* alarm_;
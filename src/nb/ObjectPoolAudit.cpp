@@ -39,7 +39,8 @@ ObjectPoolAudit::ObjectPoolAudit() :
    Thread(AuditFaction, Singleton<ObjectDaemon>::Instance()),
    interval_(msecs_t(5000)),
    phase_(CheckingFreeq),
-   pid_(NIL_ID)
+   pid_(NIL_ID),
+   seg_(0)
 {
    Debug::ft("ObjectPoolAudit.ctor");
 
@@ -79,6 +80,7 @@ void ObjectPoolAudit::Display(ostream& stream,
    stream << prefix << "interval : " << to_string(interval_) << CRLF;
    stream << prefix << "phase    : " << phase_ << CRLF;
    stream << prefix << "pid      : " << int(pid_) << CRLF;
+   stream << prefix << "seg      : " << seg_ << CRLF;
 }
 
 //------------------------------------------------------------------------------
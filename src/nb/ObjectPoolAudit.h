@@ -58,7 +58,7 @@ private:
    {
       CheckingFreeq,    // marking blocks and checking free queue
       ClaimingBlocks,   // application claiming in-use blocks
-      RecoveringBlocks  // recovering unclaimed blocks
+      RecoveringBlocks  // sweeping segments to recover unclaimed blocks
    };
 
    //  Private because this is a singleton.
@@ -92,6 +92,10 @@ private:
    //  The pool currently being audited.
    //
    id_t pid_;
+
+   //  The next segment to be swept in the pool currently being audited.
+   //
+   size_t seg_;
 };
 }
 #endif
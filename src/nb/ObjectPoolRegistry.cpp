@@ -20,6 +20,7 @@
 //  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "ObjectPoolRegistry.h"
+#include "Dynamic.h"
 #include "StatisticsGroup.h"
 #include "Tool.h"
 #include <iomanip>
@@ -28,6 +29,7 @@
 #include "Algorithms.h"
 #include "CfgParmRegistry.h"
 #include "Debug.h"
+#include "Duration.h"
 #include "Formatters.h"
 #include "FunctionGuard.h"
 #include "NbCliParms.h"
@@ -35,6 +37,7 @@
 #include "ObjectPoolAudit.h"
 #include "Restart.h"
 #include "Singleton.h"
+#include "Statistics.h"
 #include "SysTypes.h"
 #include "ThisThread.h"
 #include "ToolTypes.h"
@@ -61,6 +64,39 @@ class ObjPoolTraceTool : public Tool
 };
 
 //------------------------------------------------------------------------------
+//
+//  Statistics for the object pool audit.
+//
+class ObjectPoolAuditStats : public Dynamic
+{
+public:
+   ObjectPoolAuditStats();
+   ~ObjectPoolAuditStats();
+
+   HistogramPtr     sliceTimes_;
+   HighWatermarkPtr maxSlice_;
+   AccumulatorPtr   totTime_;
+};
+
+//------------------------------------------------------------------------------
+
+ObjectPoolAuditStats::ObjectPoolAuditStats()
+{
+   Debug::ft("ObjectPoolAuditStats.ctor");
+
+   sliceTimes_.reset(new Histogram("audit slice times in usecs", NS_TO_US));
+   maxSlice_.reset(new HighWatermark("longest audit slice (usecs)", NS_TO_US));
+   totTime_.reset(new Accumulator("total audit time (msecs)", NS_TO_MS));
+}
+
+//------------------------------------------------------------------------------
+
+ObjectPoolAuditStats::~ObjectPoolAuditStats()
+{
+   Debug::ftnt("ObjectPoolAuditStats.dtor");
+}
+
+//==============================================================================
 
 class ObjectPoolStatsGroup : public StatisticsGroup
 {
@@ -99,6 +135,8 @@ void ObjectPoolStatsGroup::DisplayStats
 
    if(id == 0)
    {
+      reg->DisplayStats(stream, options);
+
       const auto& pools = reg->Pools();
 
       for(auto p = pools.First(); p != nullptr; pools.Next(p))
@@ -129,6 +167,7 @@ ObjectPoolRegistry::ObjectPoolRegistry()
    Singleton<ObjPoolTraceTool>::Instance();
    pools_.Init(ObjectPool::MaxId, ObjectPool::CellDiff(), MemProtected);
    statsGroup_.reset(new ObjectPoolStatsGroup);
+   stats_.reset(new ObjectPoolAuditStats);
    nullifyObjectDataCfg_.reset(new CfgBoolParm("NullifyObjectData", "F",
       "set to nullify the data after an object's vptr"));
    Singleton<CfgParmRegistry>::Instance()->BindParm(*nullifyObjectDataCfg_);
@@ -172,8 +211,9 @@ void ObjectPoolRegistry::AuditPools() const
 
             if(pool != nullptr)
             {
+               auto start = SteadyTime::Now();
                pool->AuditFreeq();
-               ThisThread::Pause();
+               EndSlice(start);
             }
 
             ++thread->pid_;
@@ -197,8 +237,9 @@ void ObjectPoolRegistry::AuditPools() const
 
             if(pool != nullptr)
             {
+               auto start = SteadyTime::Now();
                pool->ClaimBlocks();
-               ThisThread::Pause();
+               EndSlice(start);
             }
 
             ++thread->pid_;
@@ -212,7 +253,8 @@ void ObjectPoolRegistry::AuditPools() const
          //
          //  For each object pool, recover any block that is still marked.
          //  Such a block is an orphan that is neither on the free queue
-         //  nor in use by an application.
+         //  nor in use by an application.  A large pool is swept in slices,
+         //  pausing after each one.
          //
          while(thread->pid_ <= ObjectPool::MaxId)
          {
@@ -220,15 +262,23 @@ void ObjectPoolRegistry::AuditPools() const
 
             if(pool != nullptr)
             {
-               pool->RecoverBlocks();
-               ThisThread::Pause();
+               auto done = false;
+
+               while(!done)
+               {
+                  auto start = SteadyTime::Now();
+                  done = pool->RecoverBlocks(thread->seg_);
+                  EndSlice(start);
+               }
             }
 
+            thread->seg_ = 0;
             ++thread->pid_;
          }
 
          thread->phase_ = ObjectPoolAudit::CheckingFreeq;
          thread->pid_ = NIL_ID;
+         thread->seg_ = 0;
          return;
 
       default:
@@ -239,6 +289,7 @@ void ObjectPoolRegistry::AuditPools() const
             "unexpected phase", pack2(thread->pid_, thread->phase_));
          thread->phase_ = ObjectPoolAudit::CheckingFreeq;
          thread->pid_ = NIL_ID;
+         thread->seg_ = 0;
          return;
       }
    }
@@ -263,6 +314,8 @@ void ObjectPoolRegistry::Display(ostream& stream,
 
    stream << prefix << "statsGroup        : ";
    stream << strObj(statsGroup_.get()) << CRLF;
+   stream << prefix << "stats             : ";
+   stream << strObj(stats_.get()) << CRLF;
    stream << prefix << "nullifyObjectDataCfg : ";
    stream << strObj(nullifyObjectDataCfg_.get()) << CRLF;
 
@@ -272,6 +325,37 @@ void ObjectPoolRegistry::Display(ostream& stream,
 
 //------------------------------------------------------------------------------
 
+void ObjectPoolRegistry::DisplayStats
+   (ostream& stream, const Flags& options) const
+{
+   Debug::ft("ObjectPoolRegistry.DisplayStats");
+
+   if(stats_ == nullptr) return;
+
+   stats_->sliceTimes_->DisplayStat(stream, options);
+   stats_->maxSlice_->DisplayStat(stream, options);
+   stats_->totTime_->DisplayStat(stream, options);
+}
+
+//------------------------------------------------------------------------------
+
+void ObjectPoolRegistry::EndSlice(const SteadyTime::Point& start) const
+{
+   Debug::ft("ObjectPoolRegistry.EndSlice");
+
+   if(stats_ != nullptr)
+   {
+      nsecs_t elapsed = SteadyTime::Now() - start;
+      stats_->sliceTimes_->Record(elapsed.count());
+      stats_->maxSlice_->Update(elapsed.count());
+      stats_->totTime_->Add(elapsed.count());
+   }
+
+   ThisThread::Pause();
+}
+
+//------------------------------------------------------------------------------
+
 void ObjectPoolRegistry::Patch(sel_t selector, void* arguments)
 {
    Protected::Patch(selector, arguments);
@@ -292,6 +376,7 @@ void ObjectPoolRegistry::Shutdown(RestartLevel level)
 
    FunctionGuard guard(Guard_MemUnprotect);
    Restart::Release(statsGroup_);
+   Restart::Release(stats_);
 }
 
 //------------------------------------------------------------------------------
@@ -306,6 +391,12 @@ void ObjectPoolRegistry::Startup(RestartLevel level)
       statsGroup_.reset(new ObjectPoolStatsGroup);
    }
 
+   if(stats_ == nullptr)
+   {
+      FunctionGuard guard(Guard_MemUnprotect);
+      stats_.reset(new ObjectPoolAuditStats);
+   }
+
    for(auto p = pools_.First(); p != nullptr; pools_.Next(p))
    {
       p->Startup(level);
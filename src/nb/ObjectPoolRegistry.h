@@ -23,13 +23,16 @@
 #define OBJECTPOOLREGISTRY_H_INCLUDED
 
 #include "Protected.h"
+#include <memory>
 #include "CfgBoolParm.h"
 #include "NbTypes.h"
 #include "Registry.h"
+#include "SteadyTime.h"
 
 namespace NodeBase
 {
    class ObjectPool;
+   class ObjectPoolAuditStats;
 }
 
 //------------------------------------------------------------------------------
@@ -60,6 +63,10 @@ public:
    //
    bool NullifyObjectData() const { return nullifyObjectDataCfg_->CurrValue(); }
 
+   //  Displays statistics for the object pool audit.
+   //
+   void DisplayStats(std::ostream& stream, const Flags& options) const;
+
    //  Overridden to display member variables.
    //
    void Display(std::ostream& stream,
@@ -101,6 +108,11 @@ private:
    //
    void AuditPools() const;
 
+   //  Records the time spent in an audit slice that began at START, and
+   //  then pauses the audit so that other threads can run.
+   //
+   void EndSlice(const SteadyTime::Point& start) const;
+
    //  The global registry of object pools.
    //
    Registry<ObjectPool> pools_;
@@ -112,6 +124,10 @@ private:
    //  The statistics group for object pools.
    //
    StatisticsGroupPtr statsGroup_;
+
+   //  The statistics for the object pool audit.
+   //
+   std::unique_ptr<ObjectPoolAuditStats> stats_;
 };
 }
 #endif
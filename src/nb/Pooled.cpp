@@ -57,6 +57,10 @@ void Pooled::Claim()
 
    orphaned_ = 0;
 
+   auto pid = ObjectPool::ObjPid(this);
+   auto pool = Singleton<ObjectPoolRegistry>::Instance()->Pools().At(pid);
+   if(pool != nullptr) pool->Unmark(this);
+
    if(Debug::TraceOn())
    {
       auto buff = Singleton<TraceBuffer>::Instance();
@@ -104,8 +104,8 @@ protected:
    //
    Pooled();
 private:
-   //  Clears the object's orphaned_ field so that the object pool audit
-   //  will not reclaim it.  May be overridden, but the base class version
+   //  Clears the object's orphaned_ field, and unmarks its block, so that
+   //  the object pool audit will not reclaim it.  May be overridden, but the base class version
    //  must be invoked.
    //
    void Claim() override;
@@ -119,8 +119,9 @@ private:
    bool assigned_;
 
    //  Zero for a block on the free queue or that has just been claimed by
-   //  its owner.  Incremented each time through the audit; if it reaches a
-   //  threshold, the block deemed to be orphaned and is recovered.
+   //  its owner.  Incremented each time the audit finds that the block is
+   //  still marked; if it reaches a threshold, the block deemed to be
+   //  orphaned and is recovered.
    //
    uint8_t orphaned_;
 
@@ -26,6 +26,7 @@
 #include "Algorithms.h"
 #include "Debug.h"
 #include "Formatters.h"
+#include "Memory.h"
 #include "Singleton.h"
 #include "StatisticsRegistry.h"
 
@@ -143,10 +144,21 @@ void Statistic::StartInterval(bool first)
 
 //==============================================================================
 
-Counter::Counter(const string& expl, size_t divisor) :
-   Statistic(expl, divisor)
+Counter::Counter(const string& expl, size_t divisor, bool sharded) :
+   Statistic(expl, divisor),
+   shards_(nullptr)
 {
    Debug::ft("Counter.ctor");
+
+   if(!sharded) return;
+
+   auto size = NumShards * sizeof(Shard);
+   shards_ = static_cast<Shard*>(Memory::Alloc(size, MemDynamic));
+
+   for(size_t i = 0; i < NumShards; ++i)
+   {
+      shards_[i].count = 0;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -154,35 +166,103 @@ Counter::Counter(const string& expl, size_t divisor) :
 Counter::~Counter()
 {
    Debug::ftnt("Counter.dtor");
+
+   Memory::Free(shards_, MemDynamic);
+   shards_ = nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+size_t Counter::Curr() const
+{
+   size_t sum = curr_;
+   if(shards_ == nullptr) return sum;
+
+   for(size_t i = 0; i < NumShards; ++i)
+   {
+      sum += shards_[i].count.load(std::memory_order_relaxed);
+   }
+
+   return sum;
+}
+
+//------------------------------------------------------------------------------
+
+void Counter::Display(ostream& stream,
+   const string& prefix, const Flags& options) const
+{
+   Statistic::Display(stream, prefix, options);
+
+   stream << prefix << "shards  : " << shards_ << CRLF;
 }
 
 //------------------------------------------------------------------------------
 
 void Counter::DisplayStat(ostream& stream, const Flags& options) const
 {
-   if(!options.test(DispVerbose) && (Overall() == 0)) return;
+   auto curr = Curr();
+   auto all = total_ + curr;
+
+   if(!options.test(DispVerbose) && (all == 0)) return;
 
    Statistic::DisplayStat(stream, options);
 
    auto incr = divisor_ >> 1;
 
-   stream << setw(10) << (curr_ + incr) / divisor_;
+   stream << setw(10) << (curr + incr) / divisor_;
    stream << setw(10) << (prev_ + incr) / divisor_;
-   stream << setw(12) << (Overall() + incr) / divisor_;
+   stream << setw(12) << (all + incr) / divisor_;
    stream << CRLF;
 }
 
 //------------------------------------------------------------------------------
 
+uint64_t Counter::Overall() const
+{
+   return total_ + Curr();
+}
+
+//------------------------------------------------------------------------------
+
 void Counter::Patch(sel_t selector, void* arguments)
 {
    Statistic::Patch(selector, arguments);
 }
 
+//------------------------------------------------------------------------------
+
+size_t Counter::ShardIndex()
+{
+   //  Assign shards to threads in round-robin order.
+   //
+   static std::atomic_size_t NextShard(0);
+   static thread_local size_t Index =
+      NextShard.fetch_add(1) & (NumShards - 1);
+
+   return Index;
+}
+
+//------------------------------------------------------------------------------
+
+void Counter::StartInterval(bool first)
+{
+   Debug::ft("Counter.StartInterval");
+
+   if(shards_ != nullptr)
+   {
+      for(size_t i = 0; i < NumShards; ++i)
+      {
+         curr_ += shards_[i].count.exchange(0);
+      }
+   }
+
+   Statistic::StartInterval(first);
+}
+
 //==============================================================================
 
-Accumulator::Accumulator(const string& expl, size_t divisor) :
-   Counter(expl, divisor)
+Accumulator::Accumulator(const string& expl, size_t divisor, bool sharded) :
+   Counter(expl, divisor, sharded)
 {
    Debug::ft("Accumulator.ctor");
 }
@@ -196,6 +276,221 @@ Accumulator::~Accumulator()
 
 //==============================================================================
 
+Histogram::Histogram(const string& expl, size_t divisor) :
+   Statistic(expl, divisor)
+{
+   Debug::ft("Histogram.ctor");
+
+   for(size_t i = 0; i < NumBuckets; ++i)
+   {
+      currCounts_[i] = 0;
+      prevCounts_[i] = 0;
+      totalCounts_[i] = 0;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+Histogram::~Histogram()
+{
+   Debug::ftnt("Histogram.dtor");
+}
+
+//------------------------------------------------------------------------------
+
+size_t Histogram::Bucket(size_t value)
+{
+   //  Values below 2 * SubBuckets have their own buckets.  A larger value's
+   //  bucket is determined by its exponent and the SubBits bits that follow
+   //  its most significant bit.
+   //
+   if(value < 2 * SubBuckets) return value;
+
+   uint64_t bits = value;
+   size_t exp = 0;
+
+   for(size_t shift = 32; shift > 0; shift >>= 1)
+   {
+      if((bits >> shift) != 0)
+      {
+         bits >>= shift;
+         exp += shift;
+      }
+   }
+
+   if(exp > MaxExponent) return NumBuckets - 1;
+
+   return ((exp - SubBits + 1) << SubBits) +
+      ((value >> (exp - SubBits)) - SubBuckets);
+}
+
+//------------------------------------------------------------------------------
+
+//  The percentiles displayed by DisplayStat, in tenths of a percent.
+//
+constexpr size_t NumDisplayedPercentiles = 3;
+const size_t DisplayedPermilles[] = { 500, 990, 999 };
+fixed_string DisplayedPercentiles[] = { "p50", "p99", "p99.9" };
+
+void Histogram::DisplayStat(ostream& stream, const Flags& options) const
+{
+   if(!options.test(DispVerbose) && (Overall() == 0)) return;
+
+   Statistic::DisplayStat(stream, options);
+
+   stream << setw(10) << curr_;
+   stream << setw(10) << prev_;
+   stream << setw(12) << Overall();
+   stream << CRLF;
+
+   //  The overall percentiles include the current measurement period.
+   //
+   uint64_t curr[NumBuckets];
+   uint64_t all[NumBuckets];
+
+   GetCurrCounts(curr);
+
+   for(size_t i = 0; i < NumBuckets; ++i)
+   {
+      all[i] = totalCounts_[i] + curr[i];
+   }
+
+   auto incr = divisor_ >> 1;
+
+   for(size_t p = 0; p < NumDisplayedPercentiles; ++p)
+   {
+      string label(DisplayedPercentiles[p]);
+      auto permille = DisplayedPermilles[p];
+      stream << spaces(MaxExplSize + 4 - label.size()) << label;
+
+      auto value = Percentile(curr, permille);
+
+      if(value != SIZE_MAX)
+         stream << setw(10) << (value + incr) / divisor_;
+      else
+         stream << setw(10) << NotUpdated;
+
+      value = Percentile(prevCounts_, permille);
+
+      if(value != SIZE_MAX)
+         stream << setw(10) << (value + incr) / divisor_;
+      else
+         stream << setw(10) << NotUpdated;
+
+      value = Percentile(all, permille);
+
+      if(value != SIZE_MAX)
+         stream << setw(12) << (value + incr) / divisor_;
+      else
+         stream << setw(12) << NotUpdated;
+
+      stream << CRLF;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void Histogram::GetCounts(uint64_t counts[]) const
+{
+   Debug::ft("Histogram.GetCounts");
+
+   GetCurrCounts(counts);
+
+   for(size_t i = 0; i < NumBuckets; ++i)
+   {
+      counts[i] += totalCounts_[i];
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void Histogram::GetCurrCounts(uint64_t counts[]) const
+{
+   for(size_t i = 0; i < NumBuckets; ++i)
+   {
+      counts[i] = currCounts_[i].load();
+   }
+}
+
+//------------------------------------------------------------------------------
+
+size_t Histogram::Limit(size_t bucket)
+{
+   if(bucket < 2 * SubBuckets) return bucket;
+
+   auto exp = (bucket >> SubBits) + SubBits - 1;
+   auto mantissa = (bucket & (SubBuckets - 1)) + SubBuckets;
+   return ((mantissa + 1) << (exp - SubBits)) - 1;
+}
+
+//------------------------------------------------------------------------------
+
+size_t Histogram::Percentile(const uint64_t counts[], size_t permille)
+{
+   uint64_t total = 0;
+
+   for(size_t i = 0; i < NumBuckets; ++i)
+   {
+      total += counts[i];
+   }
+
+   if(total == 0) return SIZE_MAX;
+
+   //  Find the bucket that contains the value whose rank is PERMILLE/1000
+   //  of TOTAL, rounded up.
+   //
+   auto rank = (total * permille + 999) / 1000;
+   if(rank == 0) rank = 1;
+   uint64_t sum = 0;
+
+   for(size_t i = 0; i < NumBuckets; ++i)
+   {
+      sum += counts[i];
+      if(sum >= rank) return Limit(i);
+   }
+
+   return Limit(NumBuckets - 1);
+}
+
+//------------------------------------------------------------------------------
+
+size_t Histogram::Scaled(const uint64_t counts[], size_t permille) const
+{
+   Debug::ft("Histogram.Scaled");
+
+   auto value = Percentile(counts, permille);
+   if(value == SIZE_MAX) return SIZE_MAX;
+   return (value + (divisor_ >> 1)) / divisor_;
+}
+
+//------------------------------------------------------------------------------
+
+void Histogram::StartInterval(bool first)
+{
+   Debug::ft("Histogram.StartInterval");
+
+   for(size_t i = 0; i < NumBuckets; ++i)
+   {
+      auto count = currCounts_[i].exchange(0);
+      prevCounts_[i] = count;
+
+      if(first)
+         totalCounts_[i] = count;
+      else
+         totalCounts_[i] += count;
+   }
+
+   if(first)
+      total_ = curr_.load();
+   else
+      total_ += curr_;
+
+   prev_.store(curr_);
+   curr_ = 0;
+}
+
+//==============================================================================
+
 HighWatermark::HighWatermark(const string& expl, size_t divisor) :
    Statistic(expl, divisor)
 {
@@ -57,7 +57,7 @@ public:
 
    //  Returns the value during the current measurement period.
    //
-   size_t Curr() const { return curr_; }
+   virtual size_t Curr() const { return curr_; }
 
    //  Returns the value over all measurement periods.
    //
@@ -97,7 +97,7 @@ protected:
    //  The divisor used when displaying totals.
    //
    size_t divisor_;
-private:
+
    //  Invoked at regular intervals to start a new measurement period.
    //  If FIRST is true, previous values in total_ are discarded.  The
    //  default version adds curr_ to total_, sets prev_ to curr_, and
@@ -105,6 +105,7 @@ private:
    //  different behavior.
    //
    virtual void StartInterval(bool first);
+private:
 
    //  Returns the offset to mid_.
    //
@@ -121,30 +122,94 @@ private:
 
 //------------------------------------------------------------------------------
 //
-//  Counts how many times an event has occurred.
+//  Counts how many times an event has occurred.  A counter that is updated
+//  very frequently by many threads can be sharded, in which case the count
+//  is kept in shards, each in its own cache line.  Each thread updates one
+//  shard, so threads running on different cores rarely contend for the
+//  same cache line.  The shards are only summed when the count is read and
+//  when a new measurement period starts.  Because the shards occupy about
+//  1KB, a counter is only sharded if its constructor is told to do so.
 //
 class Counter : public Statistic
 {
 public:
    //  Public so that instances can be created as members.
    //
-   explicit Counter(const std::string& expl, size_t divisor = 1);
+   //  If SHARDED is set, the count is kept in shards.
+   //
+   explicit Counter
+      (const std::string& expl, size_t divisor = 1, bool sharded = false);
 
    //  Virtual to allow subclassing.
    //
    virtual ~Counter();
 
-   //  Increments the count and returns it.
+   //  Increments the count.
+   //
+   void Incr() { AddCount(1); }
+
+   //  Overridden to sum the shards.
    //
-   size_t Incr() { return ++curr_; }
+   size_t Curr() const override;
+
+   //  Overridden to include the shards.
+   //
+   uint64_t Overall() const override;
 
    //  Overridden to display the statistic.
    //
    void DisplayStat(std::ostream& stream, const Flags& options) const override;
 
+   //  Overridden to display member variables.
+   //
+   void Display(std::ostream& stream,
+      const std::string& prefix, const Flags& options) const override;
+
    //  Overridden for patching.
    //
    void Patch(sel_t selector, void* arguments) override;
+protected:
+   //  Adds COUNT to curr_ or, if the counter is sharded, to the running
+   //  thread's shard.
+   //
+   void AddCount(size_t count)
+   {
+      if(shards_ == nullptr)
+         curr_ += count;
+      else
+         shards_[ShardIndex()].count.fetch_add
+            (count, std::memory_order_relaxed);
+   }
+private:
+   //> The number of shards.  Must be a power of 2.
+   //
+   static const size_t NumShards = 16;
+
+   //> The size of a cache line.
+   //
+   static const size_t CacheLineSize = 64;
+
+   //  A shard, padded to fill a cache line.  Shards are not aligned on
+   //  cache line boundaries, but each one still occupies its own line.
+   //
+   struct Shard
+   {
+      std::atomic_size_t count;
+      uint8_t pad[CacheLineSize - sizeof(std::atomic_size_t)];
+   };
+
+   //  Returns the shard assigned to the running thread.
+   //
+   static size_t ShardIndex();
+
+   //  Overridden to sum the shards into curr_ before starting a new
+   //  measurement interval.
+   //
+   void StartInterval(bool first) override;
+
+   //  The shards, which are only allocated if the counter is sharded.
+   //
+   Shard* shards_;
 };
 
 //------------------------------------------------------------------------------
@@ -156,15 +221,113 @@ class Accumulator : public Counter
 public:
    //  Public so that instances can be created as members.
    //
-   explicit Accumulator(const std::string& expl, size_t divisor = 1);
+   //  SHARDED is passed to the Counter constructor.
+   //
+   explicit Accumulator
+      (const std::string& expl, size_t divisor = 1, bool sharded = false);
 
    //  Virtual to allow subclassing.
    //
    virtual ~Accumulator();
 
-   //  Updates the total and returns it.
+   //  Updates the total.
+   //
+   void Add(size_t count) { AddCount(count); }
+};
+
+//------------------------------------------------------------------------------
+//
+//  Records the distribution of a value, such as a latency, so that percentiles
+//  can be reported.  Each power of 2 is divided into SubBuckets buckets, so the
+//  histogram uses a fixed amount of memory, and a reported percentile is within
+//  1/SubBuckets of the actual value.  At the end of each measurement period,
+//  its buckets are added to those for all measurement periods.  The standard
+//  Curr, Prev, and All values are the number of values recorded.
+//
+class Histogram : public Statistic
+{
+public:
+   //  Public so that instances can be created as members.
+   //
+   explicit Histogram(const std::string& expl, size_t divisor = 1);
+
+   //  Virtual to allow subclassing.
+   //
+   virtual ~Histogram();
+
+   //  Records VALUE.
+   //
+   void Record(size_t value)
+   {
+      ++curr_;
+      ++currCounts_[Bucket(value)];
+   }
+
+   //  Overridden to display the statistic and its percentiles.
+   //
+   void DisplayStat(std::ostream& stream, const Flags& options) const override;
+
+   //> The number of buckets for each power of 2 (in log2).
+   //
+   static const size_t SubBits = 3;
+
+   //  The number of buckets for each power of 2.
+   //
+   static const size_t SubBuckets = 1 << SubBits;
+
+   //> The largest power of 2 that has its own buckets.  Larger values are
+   //  counted in the last bucket.
+   //
+   static const size_t MaxExponent = 40;
+
+   //  The number of buckets.
+   //
+   static const size_t NumBuckets = (MaxExponent - SubBits + 2) * SubBuckets;
+
+   //  Copies the counts for all measurement periods, including the current
+   //  one, to COUNTS.  A client that subtracts two sets of counts obtains
+   //  the distribution of the values recorded between the two calls.
+   //
+   void GetCounts(uint64_t counts[]) const;
+
+   //  Returns the value that PERMILLE/1000 of the values in COUNTS did not
+   //  exceed, divided by the histogram's divisor.  Returns SIZE_MAX if
+   //  COUNTS is empty.
+   //
+   size_t Scaled(const uint64_t counts[], size_t permille) const;
+private:
+   //  Returns the bucket that counts VALUE.
+   //
+   static size_t Bucket(size_t value);
+
+   //  Returns the largest value counted by BUCKET.
+   //
+   static size_t Limit(size_t bucket);
+
+   //  Returns the value that PERMILLE/1000 of the values in COUNTS did not
+   //  exceed.  Returns SIZE_MAX if COUNTS is empty.
+   //
+   static size_t Percentile(const uint64_t counts[], size_t permille);
+
+   //  Copies currCounts_ to COUNTS.
+   //
+   void GetCurrCounts(uint64_t counts[]) const;
+
+   //  Overridden to start a new measurement interval.
+   //
+   void StartInterval(bool first) override;
+
+   //  The buckets for the current measurement period.
+   //
+   std::atomic_size_t currCounts_[NumBuckets];
+
+   //  The buckets for the previous measurement period.
+   //
+   uint64_t prevCounts_[NumBuckets];
+
+   //  The buckets for all measurement periods.
    //
-   size_t Add(size_t count) { return (curr_ += count); }
+   uint64_t totalCounts_[NumBuckets];
 };
 
 //------------------------------------------------------------------------------
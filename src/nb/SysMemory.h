@@ -53,6 +53,11 @@ namespace SysMemory
    //
    bool Unlock(void* addr, size_t size);
 
+   //  Returns the size of a page, which is the granularity at which Protect
+   //  applies permissions.
+   //
+   size_t PageSize();
+
    //  Applies ATTRS to ADDR[0 to SIZE-1].  Returns 0 on success, else a
    //  system-specific failure code.
    //
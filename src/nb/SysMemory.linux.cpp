@@ -24,6 +24,7 @@
 #include "SysMemory.h"
 #include <errno.h>
 #include <sys/mman.h>
+#include <unistd.h>
 #include "Debug.h"
 
 //------------------------------------------------------------------------------
@@ -114,6 +115,15 @@ bool SysMemory::Lock(void* addr, size_t size)
 
 //------------------------------------------------------------------------------
 
+size_t SysMemory::PageSize()
+{
+   Debug::ft("SysMemory.PageSize");
+
+   return sysconf(_SC_PAGESIZE);
+}
+
+//------------------------------------------------------------------------------
+
 fn_name SysMemory_Protect = "SysMemory.Protect";
 
 int SysMemory::Protect(void* addr, size_t size, MemoryProtection attrs)
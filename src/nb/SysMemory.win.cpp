@@ -116,6 +116,17 @@ bool SysMemory::Lock(void* addr, size_t size)
 
 //------------------------------------------------------------------------------
 
+size_t SysMemory::PageSize()
+{
+   Debug::ft("SysMemory.PageSize");
+
+   SYSTEM_INFO info;
+   GetSystemInfo(&info);
+   return info.dwPageSize;
+}
+
+//------------------------------------------------------------------------------
+
 fn_name SysMemory_Protect = "SysMemory.Protect";
 
 int SysMemory::Protect(void* addr, size_t size, MemoryProtection attrs)
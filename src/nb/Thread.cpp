@@ -721,7 +721,7 @@ void ContextSwitches::DisplaySwitches(ostream& stream) const
          }
       }
 
-      if(locked > 1)
+      if((locked > 1) && !ThreadAdmin::MultiLaneEnabled())
       {
          stream << "  *";
          multilocked = true;
@@ -805,6 +805,12 @@ public:
    //
    uint8_t memUnprots_;
 
+   //  Set if MemProtected must be write-disabled when the thread yields.
+   //  This occurs when MemProtect deferred doing so or when pages were
+   //  write-enabled by MemUnprotect(addr, size).
+   //
+   bool reprotect_;
+
    //  The number of mutexes currently held by the thread.
    //
    uint8_t mutexes_;
@@ -936,6 +942,7 @@ ThreadPriv::ThreadPriv() :
    unpreempts_(1),
    immUnprots_(0),
    memUnprots_(0),
+   reprotect_(false),
    mutexes_(0),
    swlogs_(0),
    entered_(false),
@@ -983,6 +990,7 @@ void ThreadPriv::Display(ostream& stream,
    stream << prefix << "unpreempts : " << int(unpreempts_) << CRLF;
    stream << prefix << "immUnprots : " << int(immUnprots_) << CRLF;
    stream << prefix << "memUnprots : " << int(memUnprots_) << CRLF;
+   stream << prefix << "reprotect  : " << reprotect_ << CRLF;
    stream << prefix << "mutexes    : " << int(mutexes_) << CRLF;
    stream << prefix << "swlogs     : " << int(swlogs_) << CRLF;
    stream << prefix << "entered    : " << entered_ << CRLF;
@@ -1050,10 +1058,10 @@ const SysThread::Priority FactionMap[Faction_N] =
 
 //------------------------------------------------------------------------------
 //
-//  The thread that is running or which has been scheduled to run.
-//  Excludes RootThread and InitThread.
+//  The thread that is running or which has been scheduled to run in each
+//  scheduler lane.  Excludes RootThread and InitThread.
 //
-static std::atomic<Thread*> ActiveThread_ = { nullptr };
+static std::atomic<Thread*> ActiveThreads_[SchedLane_N];
 
 //  The factions that may currently be scheduled.
 //
@@ -1081,12 +1089,21 @@ static nsecs_t TimeUsed_ = nsecs_t(0);
 
 //------------------------------------------------------------------------------
 //
-//  Sets the active thread to nullptr and returns true if it matches
-//  ACTIVE, else returns false.
+//  Sets the active thread in a lane to nullptr and returns true if it
+//  matches ACTIVE, else returns false.  All lanes are checked because
+//  ACTIVE may have changed its faction, and therefore its lane, since
+//  it became active.
 //
 static bool ClearActiveThread(Thread* active)
 {
-   return ActiveThread_.compare_exchange_strong(active, nullptr);
+   for(auto lane = 0; lane < SchedLane_N; ++lane)
+   {
+      auto curr = active;
+      if(ActiveThreads_[lane].compare_exchange_strong(curr, nullptr))
+         return true;
+   }
+
+   return false;
 }
 
 //------------------------------------------------------------------------------
@@ -1210,9 +1227,9 @@ main_t Thread::AbnormalExit(signal_t signal)
 
 //------------------------------------------------------------------------------
 
-Thread* Thread::ActiveThread() NO_FT
+Thread* Thread::ActiveThread(SchedLane lane) NO_FT
 {
-   auto thr = ActiveThread_.load();
+   auto thr = ActiveThreads_[lane].load();
    if(thr == nullptr) return nullptr;
    if(thr->deleting_) return nullptr;
    return thr;
@@ -1282,8 +1299,10 @@ bool Thread::ChangeFaction(Faction faction)
    //  we have scheduled out.  Consequently, a thread's priority does not
    //  change when its faction changes.  If our use of priorities changes,
    //  it may also be necessary to adjust the thread's priority here.
-
-   faction_ = faction;
+   //  If the thread is ready to run, the registry moves it to its new
+   //  faction's ready queue.
+   //
+   Singleton<ThreadRegistry>::Instance()->ChangeFaction(*this, faction);
    return true;
 }
 
@@ -1355,6 +1374,7 @@ void Thread::Display(ostream& stream,
    stream << prefix << "daemon   : " << strObj(daemon_) << CRLF;
    stream << prefix << "tid      : " << tid_ << CRLF;
    stream << prefix << "faction  : " << int(faction_) << CRLF;
+   stream << prefix << "lane     : " << GetLane() << CRLF;
    stream << prefix << "deleting : " << deleting_ << CRLF;
    stream << prefix << "msgq     : " << CRLF;
    msgq_.Display(stream, lead, options);
@@ -1747,26 +1767,33 @@ void Thread::ExtendTime(const msecs_t& time)
 
 //------------------------------------------------------------------------------
 
+bool Thread::FactionEnabled(Faction faction)
+{
+   return FactionsEnabled_.test(faction);
+}
+
+//------------------------------------------------------------------------------
+
 Thread* Thread::FindRunningThread() NO_FT
 {
-   //  The running thread is usually the active thread.  If it isn't,
+   //  The running thread is usually an active thread.  If it isn't,
    //  search the thread registry.
    //
    auto nid = SysThread::RunningThreadId();
-   Thread* thr = nullptr;
-   auto active = ActiveThread();
 
-   if((active != nullptr) && (active->NativeThreadId() == nid))
-   {
-      thr = active;
-   }
-   else
+   for(auto lane = 0; lane < SchedLane_N; ++lane)
    {
-      auto reg = Singleton<ThreadRegistry>::Extant();
-      if(reg != nullptr) thr = reg->FindThread(nid);
+      auto active = ActiveThread(SchedLane(lane));
+
+      if((active != nullptr) && (active->NativeThreadId() == nid))
+      {
+         return active;
+      }
    }
 
-   return thr;
+   auto reg = Singleton<ThreadRegistry>::Extant();
+   if(reg != nullptr) return reg->FindThread(nid);
+   return nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -1786,7 +1813,7 @@ void Thread::FunctionInvoked(fn_name_arg func) NO_FT
       if(!lock.test_and_set())
       {
          if(TraceRunningThread(thr))
-            FunctionTrace::Capture(func);
+            FunctionTrace::Capture(func, thr);
          lock.clear();
       }
    }
@@ -1825,7 +1852,7 @@ void Thread::FunctionInvoked(fn_name_arg func, const std::nothrow_t&) NO_FT
       if(!lock.test_and_set())
       {
          if(TraceRunningThread(thr, std::nothrow))
-            FunctionTrace::Capture(func);
+            FunctionTrace::Capture(func, thr);
          lock.clear();
       }
    }
@@ -1840,6 +1867,21 @@ BlockingReason Thread::GetBlockingReason() const
 
 //------------------------------------------------------------------------------
 
+SchedLane Thread::GetLane() const
+{
+   switch(faction_)
+   {
+   case PayloadFaction:
+   case LoadTestFaction:
+      if(ThreadAdmin::MultiLaneEnabled()) return PayloadLane;
+      break;
+   }
+
+   return ServiceLane;
+}
+
+//------------------------------------------------------------------------------
+
 signal_t Thread::GetSignal() const
 {
    return priv_->signal_;
@@ -1889,10 +1931,15 @@ bool Thread::HandleSignal(signal_t sig, uint32_t code)
    {
       if(!ThreadAdmin::TrapOnRtcTimeout())
       {
-         thr = LockedThread();
-
-         if((thr != nullptr) && (SteadyTime::Now() < thr->priv_->currEnd_))
+         for(auto lane = 0; lane < SchedLane_N; ++lane)
          {
+            thr = LockedThread(SchedLane(lane));
+
+            if((thr != nullptr) && (SteadyTime::Now() >= thr->priv_->currEnd_))
+            {
+               break;
+            }
+
             thr = nullptr;
          }
       }
@@ -2077,9 +2124,19 @@ c_string Thread::Kill()
 
 //------------------------------------------------------------------------------
 
-Thread* Thread::LockedThread()
+size_t Thread::LanesInUse()
+{
+   //  Unless multi-lane scheduling is enabled, all threads are in the
+   //  service lane.
+   //
+   return (ThreadAdmin::MultiLaneEnabled() ? SchedLane_N : 1);
+}
+
+//------------------------------------------------------------------------------
+
+Thread* Thread::LockedThread(SchedLane lane)
 {
-   auto thr = ActiveThread();
+   auto thr = ActiveThread(lane);
    if((thr != nullptr) && thr->IsLocked()) return thr;
    return nullptr;
 }
@@ -2284,7 +2341,14 @@ void Thread::MemProtect()
 
    if(--thr->priv_->memUnprots_ == 0)
    {
-      Memory::Protect(MemProtected);
+      //  Leave the memory unprotected until the thread yields if deferring
+      //  reprotection or if the thread still needs to write to pages that
+      //  it unprotected individually.
+      //
+      if(thr->priv_->reprotect_ || ThreadAdmin::DeferReprotect())
+         thr->priv_->reprotect_ = true;
+      else
+         Memory::Protect(MemProtected);
    }
 }
 
@@ -2317,6 +2381,27 @@ void Thread::MemUnprotect()
 
 //------------------------------------------------------------------------------
 
+void Thread::MemUnprotect(const void* addr, size_t size)
+{
+   Debug::ftnt("Thread.MemUnprotect(addr)");
+
+   if(Restart::GetLevel() >= RestartReload) return;
+
+   auto thr = RunningThread(std::nothrow);
+   if(thr == nullptr) return;
+
+   //  If the thread has already write-enabled all of MemProtected, there
+   //  is nothing to do.  Otherwise write-enable the pages and remember to
+   //  write-protect them when the thread yields.
+   //
+   if(thr->priv_->memUnprots_ > 0) return;
+
+   Memory::UnprotectPages(MemProtected, addr, size);
+   thr->priv_->reprotect_ = true;
+}
+
+//------------------------------------------------------------------------------
+
 uint8_t Thread::MutexCount() const
 {
    return priv_->mutexes_;
@@ -2400,10 +2485,12 @@ void Thread::Preempt()
 {
    Debug::ft("Thread.Preempt");
 
-   //  Set the thread's ready time so that it will later be reselected,
-   //  and lower its priority so that the platform won't schedule it in.
+   //  Set the thread's ready time and put it back on its ready queue so
+   //  that it will later be reselected.  Lower its priority so that the
+   //  platform won't schedule it in.
    //
    priv_->readyTime_ = SteadyTime::Now();
+   Singleton<ThreadRegistry>::Instance()->Enqueue(*this);
    systhrd_->SetPriority(SysThread::LowPriority);
    ThreadAdmin::Incr(ThreadAdmin::Preempts);
 }
@@ -2422,7 +2509,11 @@ void Thread::Proceed()
 
    if(level < RestartReload)
    {
-      if(priv_->memUnprots_ == 0)
+      //  If the thread was preempted before it could reprotect memory, it
+      //  may need to write to pages that it unprotected individually, so
+      //  write-enable all of MemProtected until it yields.
+      //
+      if((priv_->memUnprots_ == 0) && !priv_->reprotect_)
          Memory::Protect(MemProtected);
       else
          Memory::Unprotect(MemProtected);
@@ -2599,14 +2690,16 @@ void Thread::Ready()
 
    if(faction_ >= SystemFaction) return;
 
-   //  Record the time when the thread became ready to run.  If no thread
-   //  is currently active, wake InitThread to schedule this thread in,
-   //  but have it wait to be signalled before it runs.
+   //  Record the time when the thread became ready to run and add it to
+   //  its ready queue.  If no thread is currently active in its lane, wake
+   //  InitThread to schedule it in, but have it wait to be signalled before
+   //  it runs.
    //
    priv_->readyTime_ = SteadyTime::Now();
    priv_->waiting_ = true;
+   Singleton<ThreadRegistry>::Instance()->Enqueue(*this);
 
-   if(ActiveThread() == nullptr)
+   if(ActiveThread(GetLane()) == nullptr)
    {
       Singleton<InitThread>::Instance()->Interrupt(InitThread::Schedule);
    }
@@ -2619,6 +2712,15 @@ void Thread::Ready()
 
 //------------------------------------------------------------------------------
 
+ptrdiff_t Thread::ReadyLinkDiff()
+{
+   uintptr_t local;
+   auto fake = reinterpret_cast<const Thread*>(&local);
+   return ptrdiff(&fake->readyLink_, fake);
+}
+
+//------------------------------------------------------------------------------
+
 bool Thread::Recover()
 {
    Debug::ft("Thread.Recover");
@@ -2655,6 +2757,9 @@ void Thread::ReleaseResources(bool orphaned)
    if(deleting_) return;
    deleting_ = true;
 
+   auto reg = Singleton<ThreadRegistry>::Extant();
+   if(reg != nullptr) reg->Exqueue(*this);
+
    //  Void the thread's message queue.  It may have trapped because of
    //  a corrupt message queue, so let the object pool audit recover any
    //  messages queued against it.
@@ -2776,6 +2881,17 @@ void Thread::RtcTimeout()
 
 //------------------------------------------------------------------------------
 
+bool Thread::RunningLocked(SchedLane& lane) NO_FT
+{
+   auto thr = RunningThread(std::nothrow);
+   if((thr == nullptr) || (thr->priv_ == nullptr)) return false;
+   if(!thr->priv_->locked_ || (thr->faction_ >= SystemFaction)) return false;
+   lane = thr->GetLane();
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
 Thread* Thread::RunningThread() NO_FT
 {
    auto thr = FindRunningThread();
@@ -2819,9 +2935,7 @@ void Thread::Schedule()
    //
    if(faction_ >= SystemFaction) return;
 
-   auto active = this;
-
-   if(!ActiveThread_.compare_exchange_strong(active, nullptr))
+   if(!ClearActiveThread(this))
    {
       //  This occurs when a preemptable thread suspends or invokes
       //  MakeUnpreemptable.  The active thread is an unpreemptable
@@ -2830,8 +2944,8 @@ void Thread::Schedule()
       return;
    }
 
-   //  No unpreemptable thread is running.  Wake InitThread to schedule
-   //  the next thread.
+   //  No unpreemptable thread is running in this thread's lane.  Wake
+   //  InitThread to schedule the next thread.
    //
    Singleton<InitThread>::Instance()->Interrupt(InitThread::Schedule);
 }
@@ -3332,6 +3446,18 @@ void Thread::Suspend()
       priv_->warned_ = false;
    }
 
+   //  The thread is yielding, so reprotect memory that it left unprotected.
+   //
+   if(priv_->reprotect_)
+   {
+      priv_->reprotect_ = false;
+
+      if((priv_->memUnprots_ == 0) && (Restart::GetLevel() < RestartReload))
+      {
+         Memory::Protect(MemProtected);
+      }
+   }
+
    LogContextSwitch();
    priv_->currEnd_ = SteadyTime::Now();
    Schedule();
@@ -3339,11 +3465,28 @@ void Thread::Suspend()
 
 //------------------------------------------------------------------------------
 
-Thread* Thread::SwitchContext()
+bool Thread::SwitchContext()
 {
    Debug::ft("Thread.SwitchContext");
 
-   auto curr = ActiveThread();
+   auto lanes = LanesInUse();
+   auto found = false;
+
+   for(size_t lane = 0; lane < lanes; ++lane)
+   {
+      if(SwitchLane(SchedLane(lane)) != nullptr) found = true;
+   }
+
+   return found;
+}
+
+//------------------------------------------------------------------------------
+
+Thread* Thread::SwitchLane(SchedLane lane)
+{
+   Debug::ft("Thread.SwitchLane");
+
+   auto curr = ActiveThread(lane);
 
    if((curr != nullptr) && curr->IsLocked())
    {
@@ -3366,7 +3509,7 @@ Thread* Thread::SwitchContext()
    //  Select the next thread to run.  If one is found, preempt any running
    //  thread (which cannot be locked) and signal the next one to resume.
    //
-   auto next = Singleton<ThreadRegistry>::Instance()->Select();
+   auto next = Singleton<ThreadRegistry>::Instance()->Select(lane);
 
    if(next != nullptr)
    {
@@ -3376,11 +3519,13 @@ Thread* Thread::SwitchContext()
          return curr;
       }
 
-      if(!ActiveThread_.compare_exchange_strong(curr, next))
+      if(!ActiveThreads_[lane].compare_exchange_strong(curr, next))
       {
          //  CURR is no longer the active thread, even though it was when
-         //  this function was entered.
+         //  this function was entered.  Return NEXT to the front of its
+         //  ready queue so that it will be selected next time.
          //
+         Singleton<ThreadRegistry>::Instance()->Enqueue(*next, true);
          ThreadAdmin::Incr(ThreadAdmin::Retractions);
          return curr;
       }
@@ -3571,6 +3716,7 @@ Thread::TrapAction Thread::TrapHandler(const Exception* ex,
       //
       priv_->immUnprots_ = 0;
       priv_->memUnprots_ = 0;
+      priv_->reprotect_ = false;
 
       //  The first time in, save the signal.  After that, we're dealing
       //  with a trap during trap recovery:
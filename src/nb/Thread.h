@@ -24,6 +24,7 @@
 
 #include "Permanent.h"
 #include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <exception>
 #include <iosfwd>
@@ -65,6 +66,7 @@ class Thread : public Permanent
    friend class SchedCommand;
    friend class Mutex;
    friend class ThreadRegistry;
+   template<class T> friend class Q1Way;
 public:
    //  Deleted to prohibit copying.
    //
@@ -107,6 +109,13 @@ public:
    //
    static void ExitBlockingOperation(fn_name_arg func);
 
+   //  Write-enables only the pages of MemProtected that contain ADDR[0 to
+   //  SIZE-1].  This is cheaper than MemUnprotect when modifying a few bytes.
+   //  The pages remain writable until the thread yields, so this function
+   //  has no conjugate.
+   //
+   static void MemUnprotect(const void* addr, size_t size);
+
    //  Returns the reason, if any, that the thread is blocked.
    //
    BlockingReason GetBlockingReason() const;
@@ -157,6 +166,12 @@ public:
    static Thread* RunningThread();
    static Thread* RunningThread(const std::nothrow_t&);
 
+   //  Returns true if the running thread is an application thread that was
+   //  scheduled in to run unpreemptably.  It is then the only such thread
+   //  running in its scheduler lane, which is returned in LANE.
+   //
+   static bool RunningLocked(SchedLane& lane);
+
    //  Returns the thread's identifier within ThreadRegistry.
    //
    ThreadId Tid() const { return tid_; }
@@ -169,6 +184,10 @@ public:
    //
    Faction GetFaction() const { return faction_; }
 
+   //  Returns the thread's scheduler lane, which depends on its faction.
+   //
+   SchedLane GetLane() const;
+
    //  Changes the thread to FACTION.  Returns true on success.
    //
    bool ChangeFaction(Faction faction);
@@ -402,7 +421,9 @@ private:
    //
    static void MemUnprotect();
 
-   //  Write-disables MemProtected.  Must be invoked via FunctionGuard.
+   //  Write-disables MemProtected.  Must be invoked via FunctionGuard.  If
+   //  ThreadAdmin::DeferReprotect is set, MemProtected is not write-disabled
+   //  until the thread yields.
    //
    static void MemProtect();
 
@@ -430,11 +451,12 @@ private:
    //
    void Reset(FlagId fid);
 
-   //  Invoked by a thread when it is ready to run.
+   //  Invoked by a thread when it is ready to run.  Adds the thread to
+   //  the ready queue for its faction.
    //
    void Ready();
 
-   //  Preempts a running thread.
+   //  Preempts a running thread and returns it to its ready queue.
    //
    void Preempt();
 
@@ -446,12 +468,21 @@ private:
    //
    void Schedule();
 
-   //  Schedules another thread after a thread yields or blocks, or
-   //  after a preemptable thread has run for its allotted time.
-   //  Returns the scheduled thread.  Returns nullptr if no thread
-   //  is running or ready.
+   //  Returns the number of scheduler lanes currently in use.
+   //
+   static size_t LanesInUse();
+
+   //  Invokes SwitchLane on each scheduler lane that is in use.  Returns
+   //  false if no thread is running or ready in any of those lanes.
    //
-   static Thread* SwitchContext();
+   static bool SwitchContext();
+
+   //  Schedules another thread in LANE after a thread yields or blocks,
+   //  or after a preemptable thread has run for its allotted time.
+   //  Returns the scheduled thread.  Returns nullptr if no thread in
+   //  LANE is running or ready.
+   //
+   static Thread* SwitchLane(SchedLane lane);
 
    //  Invoked to signal the thread to run.
    //
@@ -475,18 +506,26 @@ private:
    //
    bool IsTraceable() const;
 
-   //  Returns the active thread.
+   //  Returns the active thread in LANE.
    //
-   static Thread* ActiveThread();
+   static Thread* ActiveThread(SchedLane lane);
 
-   //  Returns the active thread if it is running unpreemptably.
+   //  Returns the active thread in LANE if it is running unpreemptably.
    //
-   static Thread* LockedThread();
+   static Thread* LockedThread(SchedLane lane);
 
    //  Returns true if the thread can be scheduled to run.
    //
    bool CanBeScheduled() const;
 
+   //  Returns true if threads in FACTION can currently be scheduled.
+   //
+   static bool FactionEnabled(Faction faction);
+
+   //  Returns the offset to readyLink_.
+   //
+   static ptrdiff_t ReadyLinkDiff();
+
    //  Returns the thread's daemon.
    //
    Daemon* GetDaemon() const { return daemon_; }
@@ -697,6 +736,10 @@ private:
    //
    Q1Way<MsgBuffer> msgq_;
 
+   //  The link for the ready queue of the thread's faction.
+   //
+   Q1Link readyLink_;
+
    //  Per-thread data that is not required in the header.
    //
    std::unique_ptr<ThreadPriv> priv_;
@@ -72,6 +72,9 @@ public:
    CounterPtr reentries_;
    CounterPtr reselects_;
    CounterPtr retractions_;
+   CounterPtr readies_;
+   CounterPtr selections_;
+   CounterPtr inspections_;
    CounterPtr traps_;
    CounterPtr recoveries_;
    CounterPtr recreations_;
@@ -79,6 +82,8 @@ public:
    CounterPtr kills_;
    CounterPtr unknowns_;
    CounterPtr unreleased_;
+   CounterPtr protections_;
+   AccumulatorPtr protectedKBs_;
 };
 
 //  Statistics group for threads.
@@ -103,6 +108,17 @@ protected:
    void SetCurr() override;
 };
 
+//  Configuration parameter to enable multi-lane scheduling.
+//
+class MultiLaneEnabledCfg : public CfgBoolParm
+{
+public:
+   MultiLaneEnabledCfg();
+   ~MultiLaneEnabledCfg();
+private:
+   RestartLevel RestartRequired() const override;
+};
+
 //==============================================================================
 
 ThreadsStats::ThreadsStats()
@@ -120,6 +136,9 @@ ThreadsStats::ThreadsStats()
    reentries_.reset(new Counter("scheduling interrupt when thread locked"));
    reselects_.reset(new Counter("selected to run again"));
    retractions_.reset(new Counter("race condition between selected threads"));
+   readies_.reset(new Counter("added to ready queue"));
+   selections_.reset(new Counter("ready queue searches"));
+   inspections_.reset(new Counter("ready queue entries inspected"));
    traps_.reset(new Counter("traps"));
    recoveries_.reset(new Counter("trap recoveries"));
    recreations_.reset(new Counter("re-creations"));
@@ -127,6 +146,9 @@ ThreadsStats::ThreadsStats()
    kills_.reset(new Counter("kills"));
    unknowns_.reset(new Counter("running thread not found"));
    unreleased_.reset(new Counter("locks recovered by kernel"));
+   protections_.reset(new Counter("memory protection changes"));
+   protectedKBs_.reset
+      (new Accumulator("kBs of memory protection changed", kBs));
 }
 
 //------------------------------------------------------------------------------
@@ -204,6 +226,34 @@ void BreakEnabledCfg::SetCurr()
 
 //==============================================================================
 
+MultiLaneEnabledCfg::MultiLaneEnabledCfg() : CfgBoolParm("MultiLaneEnabled",
+   "F", "set to run payload threads in their own scheduler lane")
+{
+   Debug::ft("MultiLaneEnabledCfg.ctor");
+}
+
+//------------------------------------------------------------------------------
+
+MultiLaneEnabledCfg::~MultiLaneEnabledCfg()
+{
+   Debug::ftnt("MultiLaneEnabledCfg.dtor");
+}
+
+//------------------------------------------------------------------------------
+
+RestartLevel MultiLaneEnabledCfg::RestartRequired() const
+{
+   Debug::ft("MultiLaneEnabledCfg.RestartRequired");
+
+   //  Changing a thread's lane while it is active would corrupt the record
+   //  of which thread is active in each lane.  Application threads exit
+   //  during a restart, so that is when the change can safely take effect.
+   //
+   return (NextValue() != CurrValue() ? RestartWarm : RestartNone);
+}
+
+//==============================================================================
+
 static ThreadAdmin* AccessAdminData()
 {
    //  Late during the shutdown phase of a reload restart, protected memory is
@@ -256,6 +306,15 @@ ThreadAdmin::ThreadAdmin()
    breakEnabled_.reset(new BreakEnabledCfg);
    creg->BindParm(*breakEnabled_);
 
+#ifdef MULTI_LANE
+   multiLaneEnabled_.reset(new MultiLaneEnabledCfg);
+   creg->BindParm(*multiLaneEnabled_);
+#endif
+
+   deferReprotect_.reset(new CfgBoolParm("DeferReprotect",
+      "F", "set to reprotect memory when a thread yields"));
+   creg->BindParm(*deferReprotect_);
+
    trapLimit_.reset(new CfgIntParm("TrapLimit",
       "4", 2, 10, "trap count that kills/recreates thread"));
    creg->BindParm(*trapLimit_);
@@ -300,6 +359,28 @@ bool ThreadAdmin::BreakEnabled()
 
 //------------------------------------------------------------------------------
 
+void ThreadAdmin::CountProtection(size_t bytes)
+{
+   auto admin = AccessAdminData();
+
+   if(admin == nullptr) return;
+   if(admin->stats_ == nullptr) return;
+   if(Restart::GetStage() != Running) return;
+
+   admin->stats_->protections_->Incr();
+   admin->stats_->protectedKBs_->Add(bytes);
+}
+
+//------------------------------------------------------------------------------
+
+bool ThreadAdmin::DeferReprotect()
+{
+   auto self = AccessAdminData();
+   return (self != nullptr ? self->deferReprotect_->CurrValue() : false);
+}
+
+//------------------------------------------------------------------------------
+
 void ThreadAdmin::Display(ostream& stream,
    const string& prefix, const Flags& options) const
 {
@@ -321,6 +402,10 @@ void ThreadAdmin::Display(ostream& stream,
    stream << strObj(rtcInterval_.get()) << CRLF;
    stream << prefix << "breakEnabled         : ";
    stream << strObj(breakEnabled_.get()) << CRLF;
+   stream << prefix << "multiLaneEnabled     : ";
+   stream << strObj(multiLaneEnabled_.get()) << CRLF;
+   stream << prefix << "deferReprotect       : ";
+   stream << strObj(deferReprotect_.get()) << CRLF;
    stream << prefix << "trapLimit            : ";
    stream << strObj(trapLimit_.get()) << CRLF;
    stream << prefix << "trapInterval         : ";
@@ -354,6 +439,9 @@ void ThreadAdmin::DisplayStats(ostream& stream, const Flags& options) const
       stats_->reentries_->DisplayStat(stream, options);
       stats_->reselects_->DisplayStat(stream, options);
       stats_->retractions_->DisplayStat(stream, options);
+      stats_->readies_->DisplayStat(stream, options);
+      stats_->selections_->DisplayStat(stream, options);
+      stats_->inspections_->DisplayStat(stream, options);
       stats_->traps_->DisplayStat(stream, options);
       stats_->recoveries_->DisplayStat(stream, options);
       stats_->recreations_->DisplayStat(stream, options);
@@ -361,6 +449,8 @@ void ThreadAdmin::DisplayStats(ostream& stream, const Flags& options) const
       stats_->kills_->DisplayStat(stream, options);
       stats_->unknowns_->DisplayStat(stream, options);
       stats_->unreleased_->DisplayStat(stream, options);
+      stats_->protections_->DisplayStat(stream, options);
+      stats_->protectedKBs_->DisplayStat(stream, options);
    }
 }
 
@@ -403,6 +493,15 @@ void ThreadAdmin::Incr(Register r)
    case Retractions:
       admin->stats_->retractions_->Incr();
       break;
+   case Readies:
+      admin->stats_->readies_->Incr();
+      break;
+   case Selections:
+      admin->stats_->selections_->Incr();
+      break;
+   case Inspections:
+      admin->stats_->inspections_->Incr();
+      break;
    case Creations:
       admin->stats_->creations_->Incr();
       break;
@@ -447,6 +546,18 @@ msecs_t ThreadAdmin::InitTimeout()
 
 //------------------------------------------------------------------------------
 
+bool ThreadAdmin::MultiLaneEnabled()
+{
+#ifdef MULTI_LANE
+   auto self = AccessAdminData();
+   return (self != nullptr ? self->multiLaneEnabled_->CurrValue() : false);
+#else
+   return false;
+#endif
+}
+
+//------------------------------------------------------------------------------
+
 void ThreadAdmin::Patch(sel_t selector, void* arguments)
 {
    Protected::Patch(selector, arguments);
@@ -91,6 +91,23 @@ public:
    //
    static bool BreakEnabled();
 
+   //  Returns true if multi-lane scheduling is enabled, which allows threads
+   //  in different scheduler lanes (see SchedLane) to run unpreemptably at the
+   //  same time.  Only ObjectPool free queues are protected against threads
+   //  in different lanes.  Message queues, statistics, and application data
+   //  are not, so multi-lane scheduling is compiled out (and this returns
+   //  false) unless MULTI_LANE is #defined.
+   //
+   static bool MultiLaneEnabled();
+
+   //  Returns true if a thread that no longer needs to write to protected
+   //  memory should leave it unprotected until the thread yields.  This
+   //  avoids the cost of reprotecting and unprotecting the memory when the
+   //  thread modifies it repeatedly, at the risk of not trapping a stray
+   //  write that occurs before the thread yields.
+   //
+   static bool DeferReprotect();
+
    //  Returns a shift factor (for use in a << N expression) that
    //  is used to adjust the above timeouts based on overheads such
    //  as running a debug build or enabling trace tools.
@@ -130,6 +147,9 @@ public:
       Reentries,    // asked to schedule but locked thread exists
       Reselects,    // active thread selected to run again
       Retractions,  // another thread became active before the selected thread
+      Readies,      // thread added to a ready queue
+      Selections,   // ready queues searched for a thread to run
+      Inspections,  // ready queue entries inspected during a search
       Interrupts,   // thread interrupts
       Traps,        // traps (signals and exceptions)
       Recoveries,   // trap recoveries
@@ -144,6 +164,10 @@ public:
    //
    static void Incr(Register r);
 
+   //  Records a change to the memory protection of BYTES.
+   //
+   static void CountProtection(size_t bytes);
+
    //  Displays statistics.
    //
    void DisplayStats(std::ostream& stream, const Flags& options) const;
@@ -187,6 +211,8 @@ private:
    CfgIntParmPtr  rtcLimit_;
    CfgIntParmPtr  rtcInterval_;
    CfgBoolParmPtr breakEnabled_;
+   CfgBoolParmPtr multiLaneEnabled_;
+   CfgBoolParmPtr deferReprotect_;
    CfgIntParmPtr  trapLimit_;
    CfgIntParmPtr  trapInterval_;
    CfgFlagParmPtr checkStack_;
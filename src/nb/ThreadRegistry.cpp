@@ -129,11 +129,18 @@ void ThreadStatsGroup::DisplayStats
 //
 static Mutex ThreadsLock_("ThreadRegistryLock");
 
-//  The thread at which to start searching for the thread to be
-//  scheduled in.  Scheduling is currently round-robin but will
-//  eventually be changed to support proportional scheduling.
+//  Critical section lock for the ready queues.  This is separate from
+//  ThreadsLock_ so that selecting a thread does not contend with updates
+//  to the registry itself.
 //
-static SysThreadId NextSysThreadId_ = 0;
+static Mutex ReadyLock_("ThreadReadyLock");
+
+//  The faction at which to start searching for the thread to be scheduled
+//  in, in each scheduler lane.  Scheduling is currently round-robin across
+//  factions, and FIFO within each faction, but will eventually be changed
+//  to support proportional scheduling.
+//
+static int NextFactions_[SchedLane_N] = { 0 };
 
 //------------------------------------------------------------------------------
 
@@ -141,6 +148,11 @@ ThreadRegistry::ThreadRegistry() : nextTid_(1)
 {
    Debug::ft("ThreadRegistry.ctor");
 
+   for(auto f = 0; f < Faction_N; ++f)
+   {
+      readyq_[f].Init(Thread::ReadyLinkDiff());
+   }
+
    statsGroup_.reset(new ThreadStatsGroup);
 }
 
@@ -157,6 +169,35 @@ ThreadRegistry::~ThreadRegistry()
 
 //------------------------------------------------------------------------------
 
+void ThreadRegistry::ChangeFaction(Thread& thread, Faction faction)
+{
+   Debug::ft("ThreadRegistry.ChangeFaction");
+
+   //  Hold the lock while checking whether the thread is queued, so that it
+   //  cannot be selected or queued until it is in its new faction's queue.
+   //
+   MutexGuard guard(&ReadyLock_);
+
+   auto prev = thread.faction_;
+   auto ready = ((prev < SystemFaction) && thread.readyLink_.IsQueued());
+
+   if(ready)
+   {
+      readyq_[prev].Exq(thread);
+      if(readyq_[prev].Empty()) readyFactions_.reset(prev);
+   }
+
+   thread.faction_ = faction;
+
+   if(ready && (faction < SystemFaction))
+   {
+      readyq_[faction].Enq(thread);
+      readyFactions_.set(faction);
+   }
+}
+
+//------------------------------------------------------------------------------
+
 void ThreadRegistry::ClaimBlocks()
 {
    Debug::ft("ThreadRegistry.ClaimBlocks");
@@ -258,9 +299,11 @@ void ThreadRegistry::Display(ostream& stream,
 {
    Permanent::Display(stream, prefix, options);
 
-   stream << prefix << "statsGroup : ";
+   stream << prefix << "statsGroup    : ";
    stream << strObj(statsGroup_.get()) << CRLF;
-   stream << prefix << "nextTid    : " << nextTid_ << CRLF;
+   stream << prefix << "nextTid       : " << nextTid_ << CRLF;
+   stream << prefix << "readyFactions : ";
+   stream << readyFactions_.to_string() << CRLF;
 
    stream << prefix << "threads [ThreadId]" << CRLF;
    auto threads = GetThreads();
@@ -287,6 +330,26 @@ void ThreadRegistry::Display(ostream& stream,
 
 //------------------------------------------------------------------------------
 
+void ThreadRegistry::Enqueue(Thread& thread, bool front)
+{
+   Debug::ft("ThreadRegistry.Enqueue");
+
+   auto faction = thread.GetFaction();
+   if(faction >= SystemFaction) return;
+
+   MutexGuard guard(&ReadyLock_);
+
+   auto added = (front ?
+      readyq_[faction].Henq(thread) : readyq_[faction].Enq(thread));
+   if(!added) return;
+   readyFactions_.set(faction);
+   guard.Release();
+
+   ThreadAdmin::Incr(ThreadAdmin::Readies);
+}
+
+//------------------------------------------------------------------------------
+
 void ThreadRegistry::EraseThreadId(ThreadId tid)
 {
    Debug::ft("ThreadRegistry.EraseThreadId");
@@ -314,6 +377,21 @@ void ThreadRegistry::EraseThreadId(ThreadId tid)
 
 //------------------------------------------------------------------------------
 
+void ThreadRegistry::Exqueue(Thread& thread)
+{
+   Debug::ft("ThreadRegistry.Exqueue");
+
+   auto faction = thread.GetFaction();
+   if(faction >= SystemFaction) return;
+
+   MutexGuard guard(&ReadyLock_);
+
+   readyq_[faction].Exq(thread);
+   if(readyq_[faction].Empty()) readyFactions_.reset(faction);
+}
+
+//------------------------------------------------------------------------------
+
 void ThreadRegistry::Exiting(SysThreadId nid)
 {
    Debug::ft("ThreadRegistry.Exiting");
@@ -520,72 +598,46 @@ std::set<Thread*> ThreadRegistry::Restarting(RestartLevel level) const
 
 //------------------------------------------------------------------------------
 
-Thread* ThreadRegistry::Select() const
+Thread* ThreadRegistry::Select(SchedLane lane)
 {
    Debug::ft("ThreadRegistry.Select");
 
-   //  Cycle through all threads, beginning with the one identified by
-   //  NextSysThreadId_, to find the next one that can be scheduled.
+   //  Cycle through the factions, beginning with NextFactions_[LANE], to
+   //  find the next one in LANE that is enabled and that has a thread
+   //  ready to run.  A thread that is no longer ready is removed from its
+   //  queue; it will be requeued when it next invokes Thread::Ready.  The
+   //  cost of this search does not depend on the number of threads.
    //
-   MutexGuard guard(&ThreadsLock_);
+   MutexGuard guard(&ReadyLock_);
 
-   auto t = threads_.find(NextSysThreadId_);
-   if(t == threads_.end()) t = threads_.begin();
-   Thread* next = nullptr;
+   ThreadAdmin::Incr(ThreadAdmin::Selections);
 
-   for(NO_OP; t != threads_.end(); ++t)
+   for(auto i = 0; i < Faction_N; ++i)
    {
-      auto thread = t->second.thread_;
-      if(thread == nullptr) continue;
+      auto f = (NextFactions_[lane] + i) % Faction_N;
+      if(!readyFactions_.test(f)) continue;
+      if(!Thread::FactionEnabled(Faction(f))) continue;
 
-      if(thread->CanBeScheduled())
-      {
-         next = thread;
-         break;
-      }
-   }
+      auto& readyq = readyq_[f];
 
-   if(next == nullptr)
-   {
-      for(t = threads_.begin(); t != threads_.end(); ++t)
+      for(auto thread = readyq.First(); thread != nullptr;
+         thread = readyq.First())
       {
-         auto thread = t->second.thread_;
-         if(thread == nullptr) continue;
+         ThreadAdmin::Incr(ThreadAdmin::Inspections);
+         if(thread->GetLane() != lane) break;
 
-         if(thread->CanBeScheduled())
-         {
-            next = thread;
-            break;
-         }
-      }
-   }
-
-   //  If a thread was found, start the next search with the thread
-   //  that follows it.
-   //
-   if(next != nullptr)
-   {
-      auto entry = threads_.find(next->NativeThreadId());
+         readyq.Deq();
+         if(readyq.Empty()) readyFactions_.reset(f);
 
-      while(true)
-      {
-         ++entry;
-
-         if(entry == threads_.end())
+         if(thread->CanBeScheduled())
          {
-            NextSysThreadId_ = 0;
-            break;
+            NextFactions_[lane] = (f + 1) % Faction_N;
+            return thread;
          }
-
-         auto thread = entry->second.thread_;
-         if(thread == nullptr) continue;
-
-         NextSysThreadId_ = thread->NativeThreadId();
-         break;
       }
    }
 
-   return next;
+   return nullptr;
 }
 
 //------------------------------------------------------------------------------
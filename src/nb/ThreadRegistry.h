@@ -29,6 +29,7 @@
 #include <utility>
 #include <vector>
 #include "NbTypes.h"
+#include "Q1Way.h"
 #include "SysDecls.h"
 #include "SysTypes.h"
 
@@ -197,9 +198,24 @@ private:
    //
    void Exiting(SysThreadId nid);
 
-   //  Selects the next thread to run.
+   //  Sets THREAD's faction to FACTION.  If THREAD is ready to run, it is
+   //  moved to the ready queue for FACTION.
    //
-   Thread* Select() const;
+   void ChangeFaction(Thread& thread, Faction faction);
+
+   //  Adds THREAD to the ready queue for its faction.  If FRONT is set,
+   //  THREAD goes to the front of the queue instead of the back.
+   //
+   void Enqueue(Thread& thread, bool front = false);
+
+   //  Removes THREAD from the ready queue for its faction.
+   //
+   void Exqueue(Thread& thread);
+
+   //  Selects the next thread to run in LANE by removing it from its
+   //  ready queue.
+   //
+   Thread* Select(SchedLane lane);
 
    //  Informs all threads that a restart is occurring.  Returns the
    //  threads that will exit instead of sleeping.
@@ -231,6 +247,15 @@ private:
    //
    ThreadId nextTid_;
 
+   //  The threads that are ready to run, with a FIFO queue for each
+   //  faction.
+   //
+   Q1Way<Thread> readyq_[Faction_N];
+
+   //  The factions whose ready queues are not empty.
+   //
+   FactionFlags readyFactions_;
+
    //  The statistics group for per-thread statistics.
    //
    StatisticsGroupPtr statsGroup_;
@@ -70,6 +70,16 @@ TimedRecord::TimedRecord(FlagId owner) :
 
 //------------------------------------------------------------------------------
 
+TimedRecord::TimedRecord
+   (FlagId owner, SysThreadId nid, const SystemTime::Point& time) :
+   TraceRecord(owner),
+   nid_(nid),
+   time_(time)
+{
+}
+
+//------------------------------------------------------------------------------
+
 bool TimedRecord::Display(ostream& stream, const string& opts)
 {
    if(!SystemTime::IsValid(time_)) return false;
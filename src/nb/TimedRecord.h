@@ -70,6 +70,11 @@ protected:
    //  because this class is virtual.
    //
    explicit TimedRecord(FlagId owner);
+
+   //  The same as the above, but for a record that captured an event on
+   //  the thread identified by NID at TIME.
+   //
+   TimedRecord(FlagId owner, SysThreadId nid, const SystemTime::Point& time);
 private:
    //  The thread that was running when the function was invoked.
    //
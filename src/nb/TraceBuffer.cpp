@@ -27,10 +27,12 @@
 #include <new>
 #include <ratio>
 #include <sstream>
+#include <vector>
 #include "Debug.h"
 #include "Element.h"
 #include "Formatters.h"
 #include "FunctionName.h"
+#include "FunctionRing.h"
 #include "FunctionTrace.h"
 #include "InitFlags.h"
 #include "Memory.h"
@@ -39,6 +41,8 @@
 #include "Singleton.h"
 #include "SysThread.h"
 #include "ThisThread.h"
+#include "Thread.h"
+#include "TimedRecord.h"
 #include "Tool.h"
 #include "ToolRegistry.h"
 #include "TraceDump.h"
@@ -102,6 +106,7 @@ fixed_string TraceBuffer::NoneSelected = "none";
 
 fixed_string StartOfTrace = "START OF TRACE";
 fixed_string BlockedStr = "Functions not captured because buffer was locked: ";
+fixed_string RingLossStr = "Functions not captured because a ring was full: ";
 fixed_string BuffFullStr =
    "The buffer is full. The latter part of the trace was lost.";
 fixed_string BuffOvflStr =
@@ -112,6 +117,8 @@ fixed_string BuffOvflStr =
 TraceBuffer::TraceBuffer() :
    buff_(nullptr),
    funcs_(nullptr),
+   rings_(nullptr),
+   ringLosses_(0),
    size_(0),
    bnext_(0),
    fnext_(0),
@@ -125,6 +132,11 @@ TraceBuffer::TraceBuffer() :
    AllocBuffers(MinSize);
    invocations_.reset(new InvocationsTable);
 
+   auto size = (Thread::MaxId + 1) * sizeof(FunctionRing*);
+   rings_ = (FunctionRing**)
+      Memory::Alloc(size, MemPermanent, std::nothrow);
+   if(rings_ != nullptr) memset(rings_, 0, size);
+
    //  Create NbTracer here.  It used to be done in Thread::CalcStatus, but it
    //  now uses Singleton::Extant, instead of Singleton::Instance, to avoid the
    //  potentially throwing new operator in the latter.  This caused NbTracer
@@ -156,6 +168,8 @@ TraceBuffer::~TraceBuffer()
    buff_ = nullptr;
    Memory::Free(funcs_, MemPermanent);
    funcs_ = nullptr;
+   Memory::Free(rings_, MemPermanent);
+   rings_ = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -263,6 +277,39 @@ uint32_t TraceBuffer::AllocSlot()
 
 //------------------------------------------------------------------------------
 
+void TraceBuffer::CaptureInRing
+   (const Thread& thr, fn_name_arg func, fn_depth depth)
+{
+   //  A thread's ring is created the first time it invokes a function
+   //  during a compact trace.  If its ThreadId is reused by a new thread
+   //  while tracing is on, the ring is reassigned to that thread and the
+   //  previous thread's entries are lost.
+   //
+   if(rings_ == nullptr) return;
+
+   auto tid = thr.Tid();
+   if(tid > Thread::MaxId) return;
+
+   auto nid = thr.NativeThreadId();
+   auto ring = rings_[tid];
+
+   if(ring == nullptr)
+   {
+      ring = FunctionRing::Create(nid);
+      if(ring == nullptr) return;
+      rings_[tid] = ring;
+   }
+   else if(ring->Nid() != nid)
+   {
+      ringLosses_ += ring->Count() + ring->Lost();
+      ring->Reset(nid);
+   }
+
+   ring->Capture(func, depth, wrap_);
+}
+
+//------------------------------------------------------------------------------
+
 void TraceBuffer::ClaimBlocks()
 {
    Debug::ft("TraceBuffer.ClaimBlocks");
@@ -322,11 +369,21 @@ TraceRc TraceBuffer::Clear()
    }
    Unlock();
 
+   if(rings_ != nullptr)
+   {
+      for(size_t tid = 0; tid <= Thread::MaxId; ++tid)
+      {
+         FunctionRing::Destroy(rings_[tid]);
+         rings_[tid] = nullptr;
+      }
+   }
+
    bnext_ = 0;
    fnext_ = 0;
    ovfl_ = false;
    softLocks_ = 0;
    blocks_ = 0;
+   ringLosses_ = 0;
    invocations_->clear();
    processed_ = false;
    return TraceOk;
@@ -350,6 +407,7 @@ void TraceBuffer::DisplayStart(ostream& stream) const
 
    stream << StartOfTrace << strTimePlace() << CRLF << CRLF;
    if(blocks_ > 0) stream << BlockedStr << blocks_ << CRLF;
+   if(ringLosses_ > 0) stream << RingLossStr << ringLosses_ << CRLF;
 
    if(ovfl_)
    {
@@ -359,7 +417,7 @@ void TraceBuffer::DisplayStart(ostream& stream) const
          stream << BuffFullStr << CRLF;
    }
 
-   if((blocks_ > 0) || ovfl_) stream << CRLF;
+   if((blocks_ > 0) || (ringLosses_ > 0) || ovfl_) stream << CRLF;
 }
 
 //------------------------------------------------------------------------------
@@ -385,7 +443,16 @@ TraceRc TraceBuffer::DisplayTrace(ostream* stream, const string& opts)
 
 bool TraceBuffer::Empty() const
 {
-   return (bnext_ == 0);
+   if(bnext_ != 0) return false;
+   if(rings_ == nullptr) return true;
+
+   for(size_t tid = 0; tid <= Thread::MaxId; ++tid)
+   {
+      auto ring = rings_[tid];
+      if((ring != nullptr) && (ring->Count() > 0)) return false;
+   }
+
+   return true;
 }
 
 //------------------------------------------------------------------------------
@@ -490,6 +557,201 @@ void TraceBuffer::Lock()
    softLocks_.fetch_add(1);
 }
 
+//------------------------------------------------------------------------------
+//
+//  The lists of invocations that were recorded in each thread's FunctionRing.
+//
+typedef std::vector<std::vector<FunctionRing::Entry>> RingLists;
+
+//  Restores the heap property after HEAP[I] has changed.  HEAP contains the
+//  indices of the lists in LISTS that still have entries, ordered so that
+//  HEAP[0] identifies the list whose next entry (at POS) is the earliest.
+//
+static void SiftDown(std::vector<size_t>& heap, size_t i,
+   const RingLists& lists, const std::vector<size_t>& pos)
+{
+   Debug::ft("NodeBase.SiftDown");
+
+   auto size = heap.size();
+
+   while(true)
+   {
+      auto least = i;
+      auto left = (2 * i) + 1;
+      auto right = left + 1;
+
+      if(left < size)
+      {
+         auto l = heap[left];
+         auto m = heap[least];
+         if(lists[l][pos[l]].time < lists[m][pos[m]].time) least = left;
+      }
+
+      if(right < size)
+      {
+         auto r = heap[right];
+         auto m = heap[least];
+         if(lists[r][pos[r]].time < lists[m][pos[m]].time) least = right;
+      }
+
+      if(least == i) return;
+
+      auto temp = heap[i];
+      heap[i] = heap[least];
+      heap[least] = temp;
+      i = least;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+
+void TraceBuffer::MergeRings()
+{
+   Debug::ft("TraceBuffer.MergeRings");
+
+   //  The rings can only be merged when threads are not adding to them.
+   //
+   if(Debug::TraceOn()) return;
+   if((rings_ == nullptr) || (buff_ == nullptr)) return;
+
+   //  Expand each ring into a list of invocations, in chronological order,
+   //  and empty the ring.
+   //
+   RingLists lists;
+   std::vector<SysThreadId> nids;
+   size_t count = 0;
+
+   for(size_t tid = 0; tid <= Thread::MaxId; ++tid)
+   {
+      auto ring = rings_[tid];
+      if(ring == nullptr) continue;
+      ringLosses_ += ring->Lost();
+
+      if(ring->Count() > 0)
+      {
+         lists.push_back(std::vector<FunctionRing::Entry>());
+         nids.push_back(ring->Nid());
+         FunctionTrace::ExpandRing(*ring, lists.back());
+         count += lists.back().size();
+      }
+
+      ring->Reset(ring->Nid());
+   }
+
+   if(count == 0) return;
+
+   Lock();
+   {
+      //  Remove the records that are already in the buffer.  They are
+      //  in chronological order.  A record that is not a TimedRecord (a
+      //  BufferTrace) takes the time of the record that precedes it.
+      //
+      std::vector<TraceRecord*> recs;
+      std::vector<SystemTime::Point> times;
+      auto first = (wrap_ && ovfl_ ? bnext_ & (size_ - 1) : 0);
+      auto last = (ovfl_ ? size_ : bnext_.load());
+      auto time = startTime_;
+
+      for(size_t i = 0; i < last; ++i)
+      {
+         auto slot = (first + i) & (size_ - 1);
+         auto rec = buff_[slot];
+         if(rec == nullptr) continue;
+         buff_[slot] = nullptr;
+         if(rec->slot_ == TraceRecord::InvalidSlot) continue;
+         if(rec->owner_ != ToolBuffer)
+            time = static_cast<const TimedRecord*>(rec)->GetTime();
+         recs.push_back(rec);
+         times.push_back(time);
+      }
+
+      //  If the merged records will not fit, the oldest ones are discarded
+      //  when wraparound is enabled, else the newest ones.  Only the ring
+      //  entries that will be kept are converted to FunctionTrace records,
+      //  and the space for them is reserved in funcs_ all at once.
+      //
+      auto total = recs.size() + count;
+      auto drop = (total > size_ ? total - size_ : 0);
+      uint32_t reserve = (count < size_ ? count : size_);
+      auto base = fnext_.fetch_add(reserve);
+      uint32_t funcs = 0;
+      uint32_t next = 0;
+
+      //  Merge the existing records with the ring entries by repeatedly
+      //  taking the earliest entry at the head of any ring's list.  HEAP
+      //  orders the lists by the time of their next entries.
+      //
+      std::vector<size_t> pos;
+      std::vector<size_t> heap;
+      size_t r = 0;
+
+      for(size_t i = 0; i < lists.size(); ++i)
+      {
+         pos.push_back(0);
+         heap.push_back(i);
+      }
+
+      for(auto i = heap.size() / 2; i > 0; --i)
+      {
+         SiftDown(heap, i - 1, lists, pos);
+      }
+
+      for(size_t n = 0; n < total; ++n)
+      {
+         TraceRecord* rec = nullptr;
+         size_t l = 0;
+         if(!heap.empty()) l = heap[0];
+
+         if((r < recs.size()) &&
+            (heap.empty() || (times[r] <= lists[l][pos[l]].time)))
+         {
+            rec = recs[r++];
+         }
+
+         auto keep = (wrap_ ? (n >= drop) : (n < size_));
+
+         if(rec != nullptr)
+         {
+            if(keep)
+            {
+               rec->slot_ = next;
+               buff_[next++] = rec;
+            }
+            else
+            {
+               delete rec;
+            }
+
+            continue;
+         }
+
+         const auto& entry = lists[l][pos[l]++];
+
+         if(keep)
+         {
+            auto slot = (base + funcs++) & (size_ - 1);
+            rec = new (&funcs_[slot]) FunctionTrace
+               (entry.func, entry.depth, nids[l], entry.time);
+            rec->slot_ = next;
+            buff_[next++] = rec;
+         }
+
+         if(pos[l] >= lists[l].size())
+         {
+            heap[0] = heap.back();
+            heap.pop_back();
+         }
+
+         if(!heap.empty()) SiftDown(heap, 0, lists, pos);
+      }
+
+      bnext_ = next;
+      ovfl_ = (drop > 0);
+   }
+   Unlock();
+}
+
 //------------------------------------------------------------------------------
 
 void TraceBuffer::MoveAbove(TraceRecord* second, const TraceRecord* first) const
@@ -595,6 +857,7 @@ void TraceBuffer::Query(ostream& stream) const
    stream << indent << "size     : " << size_ << CRLF;
    stream << indent << "entries  : " << entries << CRLF;
    stream << indent << "blocked  : " << blocks_ << CRLF;
+   stream << indent << "ringLost : " << ringLosses_ << CRLF;
    stream << indent << "wraparound enabled : " << (wrap_ ? "Y" : "N") << CRLF;
    if(ovfl_) stream << (wrap_ ? BuffOvflStr : BuffFullStr) << CRLF;
 }
@@ -771,6 +1034,7 @@ void TraceBuffer::StopTracing()
 
    SetTool(ToolBuffer, false);
    Debug::FcFlags_.reset(Debug::TracingActive);
+   MergeRings();
 }
 
 //------------------------------------------------------------------------------
@@ -38,8 +38,10 @@
 
 namespace NodeBase
 {
-   class TraceRecord;
+   class FunctionRing;
    class FunctionTrace;
+   class Thread;
+   class TraceRecord;
 }
 
 //------------------------------------------------------------------------------
@@ -164,6 +166,17 @@ public:
    //
    void* AddFunction();
 
+   //  Records an invocation of FUNC, at DEPTH, in the FunctionRing for THR.
+   //  Used when the function trace's scope is FunctionTrace::Compact.
+   //
+   void CaptureInRing(const Thread& thr, fn_name_arg func, fn_depth depth);
+
+   //  Converts the entries in each thread's FunctionRing to FunctionTrace
+   //  records and merges them, in chronological order, with the records
+   //  already in the buffer.  Does nothing while tracing is on.
+   //
+   void MergeRings();
+
    //  Moves SECOND to the slot that precedes FIRST.
    //
    void MoveAbove(TraceRecord* second, const TraceRecord* first) const;
@@ -286,6 +299,15 @@ private:
    //
    FunctionTrace* funcs_;
 
+   //  The FunctionRing for each thread, indexed by ThreadId.
+   //
+   FunctionRing** rings_;
+
+   //  The number of function invocations that were lost because a thread's
+   //  FunctionRing was full or was reassigned to another thread.
+   //
+   size_t ringLosses_;
+
    //  The current size of buff_ and funcs_.
    //
    uint32_t size_;
@@ -183,6 +183,7 @@ TraceRc FunctionProfiler::Generate(ostream& stream, Sort sort)
       break;
 
    case FunctionTrace::FullTrace:
+   case FunctionTrace::Compact:
       //
       //  Extract function calls occurring on the threads to be included in the
       //  report (thread=0 or a thread that no longer exists is of interest and
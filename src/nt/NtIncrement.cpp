@@ -458,10 +458,14 @@ fixed_string FuncScopeFullTraceTextExpl = "full trace of invocations";
 fixed_string FuncScopeCountsOnlyTextStr = "counts";
 fixed_string FuncScopeCountsOnlyTextExpl = "count invocations per function";
 
+fixed_string FuncScopeCompactTextStr = "compact";
+fixed_string FuncScopeCompactTextExpl = "full trace using per-thread rings";
+
 fixed_string FuncScopeExpl = "how to trace function invocations";
 
 constexpr id_t FuncScopeFullTraceIndex = 1;
 constexpr id_t FuncScopeCountsOnlyIndex = 2;
+constexpr id_t FuncScopeCompactIndex = 3;
 
 FuncScopeParm::FuncScopeParm() : CliTextParm(FuncScopeExpl)
 {
@@ -469,6 +473,8 @@ FuncScopeParm::FuncScopeParm() : CliTextParm(FuncScopeExpl)
       FuncScopeFullTraceTextStr), FuncScopeFullTraceIndex);
    BindText(*new CliText(FuncScopeCountsOnlyTextExpl,
       FuncScopeCountsOnlyTextStr), FuncScopeCountsOnlyIndex);
+   BindText(*new CliText(FuncScopeCompactTextExpl,
+      FuncScopeCompactTextStr), FuncScopeCompactIndex);
 }
 
 fixed_string ScopeTextStr = "scope";
@@ -509,6 +515,9 @@ word NtSetCommand::ProcessSubcommand(CliThread& cli, id_t index) const
    case FuncScopeCountsOnlyIndex:
       rc = FunctionTrace::SetScope(FunctionTrace::CountsOnly);
       break;
+   case FuncScopeCompactIndex:
+      rc = FunctionTrace::SetScope(FunctionTrace::Compact);
+      break;
    default:
       return cli.Report(scope, SystemErrorExpl);
    }
@@ -39,7 +39,7 @@ NtModule::NtModule() : Module("nt")
 
    //  Create the modules required by NodeTools.
    //
-   Singleton<NbModule>::Instance();
+   Requires(*Singleton<NbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
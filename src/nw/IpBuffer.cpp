@@ -170,6 +170,21 @@ IpBuffer* IpBuffer::Clone() const
 
 //------------------------------------------------------------------------------
 
+bool IpBuffer::Defer(bool external)
+{
+   Debug::ft("IpBuffer.Defer");
+
+   if(buff_ == nullptr) return false;
+
+   auto socket = FindSocket();
+   if((socket == nullptr) || (socket->Protocol() != IpUdp)) return false;
+
+   external_ = external;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
 void IpBuffer::Display(ostream& stream,
    const string& prefix, const Flags& options) const
 {
@@ -191,6 +206,59 @@ void IpBuffer::Display(ostream& stream,
 
 //------------------------------------------------------------------------------
 
+fn_name IpBuffer_FindSocket = "IpBuffer.FindSocket";
+
+SysSocket* IpBuffer::FindSocket() const
+{
+   Debug::ft(IpBuffer_FindSocket);
+
+   //  If there is a dedicated socket for the destination, use it.  If not,
+   //  find the IP service associated with the sender and see if it shares
+   //  the I/O thread's primary socket (e.g. for UDP).
+   //
+   SysSocket* socket = rxAddr_.GetSocket();
+   if(socket != nullptr) return socket;
+
+   auto txPort = txAddr_.GetPort();
+   auto txProto = txAddr_.GetProtocol();
+   auto reg = Singleton<IpPortRegistry>::Instance();
+   auto ipPort = reg->GetPort(txPort, txProto);
+
+   if(ipPort == nullptr)
+   {
+      Debug::SwLog(IpBuffer_FindSocket, "port not found", txPort);
+      return nullptr;
+   }
+
+   auto svc = ipPort->GetService();
+
+   if(svc == nullptr)
+   {
+      Debug::SwLog(IpBuffer_FindSocket, "service not found", txPort);
+      return nullptr;
+   }
+
+   if(!svc->HasSharedSocket())
+   {
+      Debug::SwLog(IpBuffer_FindSocket, "no shared socket", txPort);
+      return nullptr;
+   }
+
+   socket = ipPort->GetSocket();
+
+   if(socket == nullptr)
+   {
+      if(Restart::GetStage() != ShuttingDown)
+      {
+         Debug::SwLog(IpBuffer_FindSocket, "socket not found", txPort);
+      }
+   }
+
+   return socket;
+}
+
+//------------------------------------------------------------------------------
+
 TraceStatus IpBuffer::GetStatus() const
 {
    return Singleton<NwTracer>::Instance()->BuffStatus(*this, dir_);
@@ -288,52 +356,8 @@ bool IpBuffer::Send(bool external)
       return false;
    }
 
-   //  If there is a dedicated socket for the destination, send the message
-   //  over it.  If not, find the IP service associated with the sender and
-   //  see if it shares the I/O thread's primary socket (e.g. for UDP).
-   //
-   SysSocket* socket = rxAddr_.GetSocket();
-
-   if(socket == nullptr)
-   {
-      auto txPort = txAddr_.GetPort();
-      auto txProto = txAddr_.GetProtocol();
-      auto reg = Singleton<IpPortRegistry>::Instance();
-      auto ipPort = reg->GetPort(txPort, txProto);
-
-      if(ipPort == nullptr)
-      {
-         Debug::SwLog(IpBuffer_Send, "port not found", txPort);
-         return false;
-      }
-
-      auto svc = ipPort->GetService();
-
-      if(svc == nullptr)
-      {
-         Debug::SwLog(IpBuffer_Send, "service not found", txPort);
-         return false;
-      }
-
-      if(!svc->HasSharedSocket())
-      {
-         Debug::SwLog(IpBuffer_Send, "no shared socket", txPort);
-         return false;
-      }
-
-      socket = ipPort->GetSocket();
-
-      if(socket == nullptr)
-      {
-         if(Restart::GetStage() != ShuttingDown)
-         {
-            Debug::SwLog(IpBuffer_Send, "socket not found", txPort);
-         }
-
-         return false;
-      }
-   }
-
+   auto socket = FindSocket();
+   if(socket == nullptr) return false;
    return (socket->SendBuff(*this) != SysSocket::SendFailed);
 }
 }
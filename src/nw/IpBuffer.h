@@ -147,6 +147,18 @@ public:
    //
    bool Send(bool external);
 
+   //  Prepares to add the message to a UdpSendBatch instead of sending it
+   //  immediately.  EXTERNAL is used as in Send.  Returns false if the
+   //  message will not be sent over a UDP socket, in which case it must be
+   //  sent using Send.
+   //
+   bool Defer(bool external);
+
+   //  Returns the socket over which the message will be sent.  Generates a
+   //  log and returns nullptr if there is no such socket.
+   //
+   SysSocket* FindSocket() const;
+
    //  Invoked when an incoming buffer is discarded.
    //
    void InvalidDiscarded() const;
@@ -40,6 +40,7 @@
 #include "Restart.h"
 #include "Singleton.h"
 #include "Statistics.h"
+#include "Thread.h"
 
 using namespace NodeBase;
 using std::ostream;
@@ -81,8 +82,13 @@ IpPortStats::IpPortStats()
    maxRecvs_.reset(new HighWatermark("most receives before yielding"));
    discards_.reset(new Counter("messages discarded by input handler"));
    rejects_.reset(new Counter("ingress work rejected by input handler"));
-   sends_.reset(new Counter("send operations"));
-   bytesSent_.reset(new Accumulator("bytes sent"));
+
+   //  Every thread that sends a message over this port updates the next two
+   //  statistics, so they are sharded.  Only the port's I/O thread updates
+   //  those for receiving.
+   //
+   sends_.reset(new Counter("send operations", 1, true));
+   bytesSent_.reset(new Accumulator("bytes sent", 1, true));
    maxBytesSent_.reset(new HighWatermark("most bytes sent"));
    overflows_.reset(new Counter("connection rejected: socket array full"));
 }
@@ -365,7 +371,7 @@ bool IpPort::SetSocket(SysSocket* socket)
    //
    if(socket == nullptr)
    {
-      FunctionGuard guard(Guard_MemUnprotect);
+      Thread::MemUnprotect(&socket_, sizeof(socket_));
       socket_ = nullptr;
       return true;
    }
@@ -391,7 +397,7 @@ bool IpPort::SetSocket(SysSocket* socket)
       Debug::SwLog(IpPort_SetSocket, "socket already exists", port_);
    }
 
-   FunctionGuard guard(Guard_MemUnprotect);
+   Thread::MemUnprotect(&socket_, sizeof(socket_));
    socket_ = socket;
    return true;
 }
@@ -408,7 +414,7 @@ void IpPort::SetThread(IoThread* thread)
    //
    if(thread == nullptr)
    {
-      FunctionGuard guard(Guard_MemUnprotect);
+      Thread::MemUnprotect(&thread_, sizeof(thread_));
       thread_ = nullptr;
       return;
    }
@@ -420,7 +426,7 @@ void IpPort::SetThread(IoThread* thread)
       Debug::SwLog(IpPort_SetThread, "I/O thread already exists", port_);
    }
 
-   FunctionGuard guard(Guard_MemUnprotect);
+   Thread::MemUnprotect(&thread_, sizeof(thread_));
    thread_ = thread;
 }
 
@@ -181,6 +181,9 @@ IpPortRegistry::IpPortRegistry() :
    portq_.Init(IpPort::LinkDiff());
    localAddrCfg_.reset(new LocalAddrCfg);
    Singleton<CfgParmRegistry>::Instance()->BindParm(*localAddrCfg_);
+   pollSetsCfg_.reset(new CfgBoolParm("TcpPollSetsEnabled", "T",
+      "set for TCP I/O threads to use epoll instead of poll"));
+   Singleton<CfgParmRegistry>::Instance()->BindParm(*pollSetsCfg_);
    statsGroup_.reset(new IpPortStatsGroup);
 }
 
@@ -273,6 +276,8 @@ void IpPortRegistry::Display(ostream& stream,
    stream << prefix << "localAddr    : " << localAddr_.to_str() << CRLF;
    stream << prefix << "localState   : " << localState_ << CRLF;
    stream << prefix << "localAddrCfg : " << strObj(localAddrCfg_.get()) << CRLF;
+   stream << prefix << "pollSetsCfg  : ";
+   stream << strObj(pollSetsCfg_.get()) << CRLF;
    stream << prefix << "statsGroup   : " << strObj(statsGroup_.get()) << CRLF;
    stream << prefix << "portq : " << CRLF;
    portq_.Display(stream, prefix + spaces(2), options);
@@ -551,4 +556,13 @@ bool IpPortRegistry::UseIPv6()
    if(reg == nullptr) return SysIpL2Addr::SupportsIPv6();
    return reg->ipv6Enabled_;
 }
+
+//------------------------------------------------------------------------------
+
+bool IpPortRegistry::UsePollSets()
+{
+   auto reg = Singleton<IpPortRegistry>::Extant();
+   if(reg == nullptr) return false;
+   return reg->pollSetsCfg_->CurrValue();
+}
 }
@@ -24,6 +24,7 @@
 
 #include "Protected.h"
 #include <iosfwd>
+#include "CfgBoolParm.h"
 #include "NbTypes.h"
 #include "NwTypes.h"
 #include "Q1Way.h"
@@ -63,6 +64,11 @@ public:
    //
    static bool UseIPv6();
 
+   //  Returns true if TCP I/O threads should register their sockets in a
+   //  poll set (see SysTcpSocket::CreatePollSet) instead of polling them.
+   //
+   static bool UsePollSets();
+
    //  Returns the IpPort registered against PORT and PROTOCOL.  If PROTOCOL
    //  is IpAny, the first IpPort registered against PORT is returned.
    //
@@ -158,6 +164,10 @@ private:
    //
    std::unique_ptr<LocalAddrCfg> localAddrCfg_;
 
+   //  Configuration parameter for enabling TCP poll sets.
+   //
+   NodeBase::CfgBoolParmPtr pollSetsCfg_;
+
    //  Information about each IP port that receives messages.
    //
    NodeBase::Q1Way<IpPort> portq_;
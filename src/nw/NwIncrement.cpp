@@ -30,6 +30,7 @@
 #include <string>
 #include <vector>
 #include "CliBoolParm.h"
+#include "CliIntParm.h"
 #include "CliThread.h"
 #include "Debug.h"
 #include "Duration.h"
@@ -47,6 +48,7 @@
 #include "Registry.h"
 #include "Singleton.h"
 #include "SysIpL3Addr.h"
+#include "SysTcpSocket.h"
 #include "ThisThread.h"
 #include "Tool.h"
 #include "ToolTypes.h"
@@ -225,6 +227,11 @@ class NameToAddrText : public CliText
 public: NameToAddrText();
 };
 
+class PollCompareText : public CliText
+{
+public: PollCompareText();
+};
+
 class IpAction : public CliTextParm
 {
 public: IpAction();
@@ -272,12 +279,29 @@ NameToAddrText::NameToAddrText() :
    BindParm(*new ServiceNameOptParm);
 }
 
+fixed_string PollCompareTextStr = "pollcompare";
+fixed_string PollCompareTextExpl =
+   "compares the cost of Poll and Wait for TCP sockets";
+
+fixed_string PollMaxExpl = "maximum number of sockets";
+fixed_string PollReadyExpl = "number of sockets with events";
+fixed_string PollRoundsExpl = "number of operations to average";
+
+PollCompareText::PollCompareText() :
+   CliText(PollCompareTextExpl, PollCompareTextStr)
+{
+   BindParm(*new CliIntParm(PollMaxExpl, 1, 8192));
+   BindParm(*new CliIntParm(PollReadyExpl, 0, 8192));
+   BindParm(*new CliIntParm(PollRoundsExpl, 1, 100000));
+}
+
 constexpr id_t LocalNameIndex = 1;
 constexpr id_t UsesIPv6Index = 2;
 constexpr id_t LocalAddrIndex = 3;
 constexpr id_t LocalAddrsIndex = 4;
 constexpr id_t NameToAddrIndex = 5;
 constexpr id_t AddrToNameIndex = 6;
+constexpr id_t PollCompareIndex = 7;
 
 fixed_string IpActionExpl = "function to execute...";
 
@@ -291,6 +315,7 @@ IpAction::IpAction() : CliTextParm(IpActionExpl)
    BindText(*new NameToAddrText, NameToAddrIndex);
    BindText(*new IpAddrParm
       (AddrToNameTextExpl, AddrToNameTextStr), AddrToNameIndex);
+   BindText(*new PollCompareText, PollCompareIndex);
 }
 
 fixed_string IpStr = "ip";
@@ -309,6 +334,7 @@ word IpCommand::ProcessCommand(CliThread& cli) const
 
    id_t index;
    auto retest = false;
+   word max, ready, rounds;
    string name, service;
    SysIpL3Addr host;
    IpProtocol proto;
@@ -380,6 +406,14 @@ word IpCommand::ProcessCommand(CliThread& cli) const
       *cli.obuf << CRLF;
       break;
 
+   case PollCompareIndex:
+      if(!GetIntParm(max, cli)) return -1;
+      if(!GetIntParm(ready, cli)) return -1;
+      if(!GetIntParm(rounds, cli)) return -1;
+      if(!cli.EndOfInput()) return -1;
+      SysTcpSocket::ComparePolling(*cli.obuf, max, ready, rounds);
+      break;
+
    default:
       Debug::SwLog(IpCommand_ProcessCommand, UnexpectedIndex, index);
       return cli.Report(index, SystemErrorExpl);
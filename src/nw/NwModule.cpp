@@ -46,7 +46,7 @@ NwModule::NwModule() : Module()
 
    //  Create the modules required by NetworkBase.
    //
-   Singleton<NbModule>::Instance();
+   Requires(*Singleton<NbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
@@ -149,6 +149,13 @@ typedef NodeBase::word nwerr_t;
 
 constexpr int INVALID_SOCKET = -1;  // matches both Windows and Linux
 
+//  Identifies a set of sockets whose events can be awaited without passing
+//  the sockets on each wait (see SysTcpSocket::CreatePollSet).
+//
+typedef NodeBase::word pollset_t;
+
+constexpr pollset_t NilPollSet = -1;
+
 //  Forward declarations.
 //
 class InputHandler;
@@ -50,6 +50,8 @@ SysTcpSocket::SysTcpSocket(ipport_t port,
    disconnecting_(false),
    iotActive_(false),
    appState_(Initial),
+   pollSet_(NilPollSet),
+   index_(0),
    icMsg_(nullptr)
 {
    Debug::ft("SysTcpSocket.ctor");
@@ -69,6 +71,8 @@ SysTcpSocket::SysTcpSocket(SysSocket_t socket, ipport_t port) :
    disconnecting_(false),
    iotActive_(false),
    appState_(Initial),
+   pollSet_(NilPollSet),
+   index_(0),
    icMsg_(nullptr)
 {
    Debug::ft("SysTcpSocket.ctor(wrap)");
@@ -159,6 +163,7 @@ bool SysTcpSocket::Deregister()
    //
    TraceEvent(NwTrace::Deregister, state_);
    iotActive_ = false;
+   ExitPollSet();
 
    if((appState_ == Released) || ((appState_ == Initial) && (state_ == Idle)))
    {
@@ -182,6 +187,7 @@ void SysTcpSocket::Dispatch()
    TraceEvent(NwTrace::Dispatch, state_);
    state_ = Connected;
    inFlags_.reset(PollWrite);
+   UpdatePollSet();
 
    //  Send our queued outgoing messages.  If a message cannot be sent,
    //  requeue it; this is an error unless the socket blocked.
@@ -214,6 +220,8 @@ void SysTcpSocket::Display(ostream& stream,
    stream << prefix << "iotActive     : " << iotActive_ << CRLF;
    stream << prefix << "appState      : " << int(appState_) << CRLF;
    stream << prefix << "inFlags       : " << inFlags_.to_string() << CRLF;
+   stream << prefix << "pollSet       : " << pollSet_ << CRLF;
+   stream << prefix << "index         : " << index_ << CRLF;
    stream << prefix << "outFlags      : " << outFlags_.to_string() << CRLF;
    stream << prefix << "icMsg         : " << icMsg_ << CRLF;
    stream << prefix << "ogMsgq        : " << CRLF;
@@ -237,6 +245,7 @@ void SysTcpSocket::Purge()
 
    TraceEvent(NwTrace::Purge, state_);
    iotActive_ = false;
+   ExitPollSet();
    appState_ = Released;
    delete this;
 }
@@ -267,7 +276,13 @@ SysSocket::SendRc SysTcpSocket::QueueBuff(IpBuffer* buff, bool henq)
       ogMsgq_.Enq(*buff);
 
    buff->SetQueued();
-   inFlags_.set(PollWrite);
+
+   if(!inFlags_.test(PollWrite))
+   {
+      inFlags_.set(PollWrite);
+      UpdatePollSet();
+   }
+
    return SendQueued;
 }
 
@@ -324,6 +339,7 @@ SysSocket::SendRc SysTcpSocket::SendBuff(IpBuffer& buff)
       {
          state_ = Connecting;
          inFlags_.set(PollWrite);
+         UpdatePollSet();
       }
       else
       {
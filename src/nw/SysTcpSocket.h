@@ -109,11 +109,55 @@ public:
    static NodeBase::word Poll(SysTcpSocket* sockets[],
       size_t size, const NodeBase::msecs_t& timeout);
 
+   //  Creates a set of sockets for use with Wait.  Returns NilPollSet if
+   //  the platform does not support such a set, in which case Poll must be
+   //  used instead.  On failure, returns NilPollSet after generating a log.
+   //
+   static pollset_t CreatePollSet();
+
+   //  Closes POLLSET, which was returned by CreatePollSet.
+   //
+   static void ClosePollSet(pollset_t pollSet);
+
+   //  Adds the socket to POLLSET, which reports the events requested by the
+   //  socket's InFlags until the socket is deregistered.  Returns false on
+   //  failure, after generating a log.
+   //
+   bool EnterPollSet(pollset_t pollSet);
+
+   //  Waits for events on the sockets in POLLSET.  TIMEOUT specifies how
+   //  long to wait.  Updates the OutFlags of each socket on which an event
+   //  has occurred and puts it in READY, which can hold SIZE sockets.
+   //  Returns the number of sockets in READY.  Unlike Poll, the cost of
+   //  this function depends on the number of sockets with events, not the
+   //  number of sockets in POLLSET.  On failure, returns -1 after
+   //  generating a log.
+   //
+   static NodeBase::word Wait(pollset_t pollSet, SysTcpSocket* ready[],
+      size_t size, const NodeBase::msecs_t& timeout);
+
+   //  Displays, in STREAM, the time needed to poll from 1 to MAX sockets,
+   //  doubling the number of sockets each time, using both Poll and Wait.
+   //  READY sockets have pending events, and each measurement is averaged
+   //  over ROUNDS operations.
+   //
+   static void ComparePolling
+      (std::ostream& stream, size_t max, size_t ready, size_t rounds);
+
    //  Returns the flags that reported the socket's status after invoking
    //  Poll.  Any of the flags could have been set.
    //
    PollFlags* OutFlags() { return &outFlags_; }
 
+   //  Records INDEX as the socket's position in its I/O thread's array of
+   //  sockets, so that the thread can find it without a search.
+   //
+   void SetIndex(size_t index) { index_ = index; }
+
+   //  Returns the socket's position in its I/O thread's array of sockets.
+   //
+   size_t Index() const { return index_; }
+
    //  Invoked on a socket that had called Listen to create a socket for
    //  accepting a new connection.  Sets remAddr to the peer address that
    //  is communicating with the new socket.  Clears PollRead and returns
@@ -255,6 +299,15 @@ private:
    //
    SendRc QueueBuff(IpBuffer* buff, bool henq = false);
 
+   //  Updates the events requested from the socket's poll set after its
+   //  InFlags have changed.
+   //
+   void UpdatePollSet();
+
+   //  Removes the socket from its poll set.
+   //
+   void ExitPollSet();
+
    //  The socket's state.
    //
    State state_ : 8;
@@ -275,6 +328,15 @@ private:
    //
    PollFlags inFlags_;
 
+   //  The set of sockets that reports the socket's events to its I/O
+   //  thread, if the thread uses Wait instead of Poll.
+   //
+   pollset_t pollSet_;
+
+   //  The socket's position in its I/O thread's array of sockets.
+   //
+   size_t index_;
+
    //  Flags that report the socket's status after invoking Poll.
    //
    PollFlags outFlags_;
@@ -23,25 +23,71 @@
 
 #include "SysTcpSocket.h"
 #include <chrono>
+#include <cstdint>
 #include <errno.h>
+#include <iomanip>
 #include <memory>
 #include <netinet/in.h>
+#include <ostream>
 #include <ratio>
+#include <sys/epoll.h>
 #include <sys/poll.h>
 #include <sys/socket.h>
+#include <unistd.h>
+#include <vector>
 #include "Debug.h"
 #include "IpPortRegistry.h"
 #include "NwLogs.h"
 #include "NwTrace.h"
+#include "SteadyTime.h"
 #include "SysIpL3Addr.h"
 #include "TcpIpService.h"
 
 using namespace NodeBase;
+using std::ostream;
+using std::setw;
 
 //------------------------------------------------------------------------------
 
 namespace NetworkBase
 {
+//  The maximum number of events reported by each invocation of Wait.
+//
+constexpr size_t MaxWaitEvents = 256;
+
+//  Returns the epoll events that correspond to INFLAGS.
+//
+static uint32_t InFlagsToEvents(const PollFlags& inFlags)
+{
+   Debug::ft("NetworkBase.InFlagsToEvents");
+
+   uint32_t events = 0;
+
+   if(inFlags.test(PollWrite)) events |= EPOLLOUT;
+   if(inFlags.test(PollRead)) events |= EPOLLIN;
+   if(inFlags.test(PollReadOob)) events |= EPOLLPRI;
+   return events;
+}
+
+//------------------------------------------------------------------------------
+//
+//  Sets OUTFLAGS to the flags that correspond to the epoll EVENTS.
+//
+static void EventsToOutFlags(uint32_t events, PollFlags& outFlags)
+{
+   Debug::ft("NetworkBase.EventsToOutFlags");
+
+   outFlags.reset();
+
+   if((events & EPOLLERR) != 0) outFlags.set(PollError);
+   if((events & EPOLLHUP) != 0) outFlags.set(PollHungUp);
+   if((events & EPOLLOUT) != 0) outFlags.set(PollWrite);
+   if((events & EPOLLIN) != 0) outFlags.set(PollRead);
+   if((events & EPOLLPRI) != 0) outFlags.set(PollReadOob);
+}
+
+//==============================================================================
+
 SysTcpSocketPtr SysTcpSocket::Accept(SysIpL3Addr& remAddr)
 {
    Debug::ft("SysTcpSocket.Accept");
@@ -93,6 +139,130 @@ SysTcpSocketPtr SysTcpSocket::Accept(SysIpL3Addr& remAddr)
 
 //------------------------------------------------------------------------------
 
+void SysTcpSocket::ClosePollSet(pollset_t pollSet)
+{
+   Debug::ft("SysTcpSocket.ClosePollSet");
+
+   if(pollSet != NilPollSet) close(pollSet);
+}
+
+//------------------------------------------------------------------------------
+
+void SysTcpSocket::ComparePolling
+   (ostream& stream, size_t max, size_t ready, size_t rounds)
+{
+   Debug::ft("SysTcpSocket.ComparePolling");
+
+   //  Each socket is one end of a connected pair, and the peer of each of
+   //  the first READY sockets sends a byte so that it has a pending event.
+   //  Unix domain pairs are used so that the measurement does not consume
+   //  IP ports: the cost of polling does not depend on the address family.
+   //
+   std::vector<int> sockets;
+   std::vector<int> peers;
+   auto pollSet = epoll_create1(EPOLL_CLOEXEC);
+
+   if(pollSet < 0)
+   {
+      stream << "epoll_create1 failed: errval=" << errno << CRLF;
+      return;
+   }
+
+   stream << setw(8) << "Sockets" << setw(14) << "Poll nsecs";
+   stream << setw(14) << "Wait nsecs" << CRLF;
+
+   for(size_t size = 1; size <= max; size <<= 1)
+   {
+      while(sockets.size() < size)
+      {
+         int pair[2];
+
+         if(socketpair(AF_UNIX, SOCK_STREAM, 0, pair) != 0)
+         {
+            stream << "socketpair failed: errval=" << errno << CRLF;
+            max = 0;
+            break;
+         }
+
+         epoll_event event;
+         event.events = EPOLLIN;
+         event.data.u64 = sockets.size();
+         sockets.push_back(pair[0]);
+         peers.push_back(pair[1]);
+
+         if(epoll_ctl(pollSet, EPOLL_CTL_ADD, pair[0], &event) != 0)
+         {
+            stream << "epoll_ctl failed: errval=" << errno << CRLF;
+            max = 0;
+            break;
+         }
+
+         if((sockets.size() <= ready) && (send(pair[1], "x", 1, 0) != 1))
+         {
+            stream << "send failed: errval=" << errno << CRLF;
+            max = 0;
+            break;
+         }
+      }
+
+      if((max == 0) || (sockets.size() < size)) break;
+
+      //  Like Poll, build a pollfd array for each operation and then scan
+      //  it for events.
+      //
+      size_t found = 0;
+      auto start = SteadyTime::Now();
+
+      for(size_t n = 0; n < rounds; ++n)
+      {
+         std::unique_ptr<pollfd[]> list(new pollfd[size]);
+
+         for(size_t i = 0; i < size; ++i)
+         {
+            list[i].fd = sockets[i];
+            list[i].events = POLLRDNORM;
+         }
+
+         poll(list.get(), size, 0);
+
+         for(size_t i = 0; i < size; ++i)
+         {
+            if(list[i].revents != 0) ++found;
+         }
+      }
+
+      auto polled = SteadyTime::Now();
+
+      for(size_t n = 0; n < rounds; ++n)
+      {
+         epoll_event events[MaxWaitEvents];
+         auto count = epoll_wait(pollSet, events, MaxWaitEvents, 0);
+
+         for(auto i = 0; i < count; ++i)
+         {
+            if(events[i].events != 0) ++found;
+         }
+      }
+
+      auto waited = SteadyTime::Now();
+      nsecs_t pollTime = polled - start;
+      nsecs_t waitTime = waited - polled;
+      stream << setw(8) << size;
+      stream << setw(14) << (pollTime.count() / rounds);
+      stream << setw(14) << (waitTime.count() / rounds) << CRLF;
+   }
+
+   for(size_t i = 0; i < sockets.size(); ++i)
+   {
+      close(sockets[i]);
+      close(peers[i]);
+   }
+
+   close(pollSet);
+}
+
+//------------------------------------------------------------------------------
+
 word SysTcpSocket::Connect(const SysIpL3Addr& remAddr)
 {
    Debug::ft("SysTcpSocket.Connect");
@@ -132,6 +302,23 @@ word SysTcpSocket::Connect(const SysIpL3Addr& remAddr)
 
 //------------------------------------------------------------------------------
 
+pollset_t SysTcpSocket::CreatePollSet()
+{
+   Debug::ft("SysTcpSocket.CreatePollSet");
+
+   auto pollSet = epoll_create1(EPOLL_CLOEXEC);
+
+   if(pollSet < 0)
+   {
+      OutputNwLog(NetworkSocketError, "epoll_create1", errno);
+      return NilPollSet;
+   }
+
+   return pollSet;
+}
+
+//------------------------------------------------------------------------------
+
 void SysTcpSocket::Disconnect()
 {
    Debug::ft("SysTcpSocket.Disconnect");
@@ -158,6 +345,49 @@ void SysTcpSocket::Disconnect()
 
 //------------------------------------------------------------------------------
 
+bool SysTcpSocket::EnterPollSet(pollset_t pollSet)
+{
+   Debug::ft("SysTcpSocket.EnterPollSet");
+
+   //  The socket's events are reported until it is removed from the set.
+   //  They are level-triggered, so an event that is not fully handled is
+   //  reported again by the next Wait, just as it would be by Poll.
+   //
+   epoll_event event;
+   event.events = InFlagsToEvents(inFlags_);
+   event.data.ptr = this;
+
+   if(epoll_ctl(pollSet, EPOLL_CTL_ADD, Socket(), &event) != 0)
+   {
+      OutputLog(NetworkSocketError, "epoll_ctl/ADD", errno);
+      return false;
+   }
+
+   pollSet_ = pollSet;
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void SysTcpSocket::ExitPollSet()
+{
+   Debug::ft("SysTcpSocket.ExitPollSet");
+
+   if(pollSet_ == NilPollSet) return;
+
+   //  If the socket has already been closed, it was removed from the set
+   //  automatically.
+   //
+   if(IsValid() && (epoll_ctl(pollSet_, EPOLL_CTL_DEL, Socket(), nullptr) != 0))
+   {
+      if(errno != ENOENT) OutputLog(NetworkSocketError, "epoll_ctl/DEL", errno);
+   }
+
+   pollSet_ = NilPollSet;
+}
+
+//------------------------------------------------------------------------------
+
 fn_name SysTcpSocket_Listen = "SysTcpSocket.Listen";
 
 word SysTcpSocket::Listen(size_t backlog)
@@ -452,5 +682,57 @@ SysSocket::AllocRc SysTcpSocket::SetService
 
    return AllocOk;
 }
+
+//------------------------------------------------------------------------------
+
+void SysTcpSocket::UpdatePollSet()
+{
+   Debug::ft("SysTcpSocket.UpdatePollSet");
+
+   if(pollSet_ == NilPollSet) return;
+
+   epoll_event event;
+   event.events = InFlagsToEvents(inFlags_);
+   event.data.ptr = this;
+
+   if(epoll_ctl(pollSet_, EPOLL_CTL_MOD, Socket(), &event) != 0)
+   {
+      OutputLog(NetworkSocketError, "epoll_ctl/MOD", errno);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+word SysTcpSocket::Wait(pollset_t pollSet,
+   SysTcpSocket* ready[], size_t size, const msecs_t& timeout)
+{
+   Debug::ft("SysTcpSocket.Wait");
+
+   if(size == 0) return 0;
+   if(size > MaxWaitEvents) size = MaxWaitEvents;
+   int delay = (timeout != TIMEOUT_NEVER ? timeout.count() : -1);
+
+   epoll_event events[MaxWaitEvents];
+   auto count = epoll_wait(pollSet, events, size, delay);
+
+   if(count < 0)
+   {
+      if(errno == EINTR) return 0;
+      OutputNwLog(NetworkSocketError, "epoll_wait", errno);
+      return -1;
+   }
+
+   //  Only the sockets with events are updated.  The invoker must not rely
+   //  on the OutFlags of other sockets, which still report earlier events.
+   //
+   for(auto i = 0; i < count; ++i)
+   {
+      auto socket = static_cast<SysTcpSocket*>(events[i].data.ptr);
+      EventsToOutFlags(events[i].events, socket->outFlags_);
+      ready[i] = socket;
+   }
+
+   return count;
+}
 }
 #endif
@@ -24,6 +24,7 @@
 #include "SysTcpSocket.h"
 #include <chrono>
 #include <memory>
+#include <ostream>
 #include <ratio>
 #include <WinSock2.h>
 #include <WS2tcpip.h>
@@ -35,6 +36,7 @@
 #include "TcpIpService.h"
 
 using namespace NodeBase;
+using std::ostream;
 
 //------------------------------------------------------------------------------
 
@@ -91,6 +93,23 @@ SysTcpSocketPtr SysTcpSocket::Accept(SysIpL3Addr& remAddr)
 
 //------------------------------------------------------------------------------
 
+void SysTcpSocket::ClosePollSet(pollset_t pollSet)
+{
+   Debug::ft("SysTcpSocket.ClosePollSet");
+}
+
+//------------------------------------------------------------------------------
+
+void SysTcpSocket::ComparePolling
+   (ostream& stream, size_t max, size_t ready, size_t rounds)
+{
+   Debug::ft("SysTcpSocket.ComparePolling");
+
+   stream << "Poll sets are not supported on this platform." << CRLF;
+}
+
+//------------------------------------------------------------------------------
+
 word SysTcpSocket::Connect(const SysIpL3Addr& remAddr)
 {
    Debug::ft("SysTcpSocket.Connect");
@@ -132,6 +151,18 @@ word SysTcpSocket::Connect(const SysIpL3Addr& remAddr)
 
 //------------------------------------------------------------------------------
 
+pollset_t SysTcpSocket::CreatePollSet()
+{
+   Debug::ft("SysTcpSocket.CreatePollSet");
+
+   //  Windows does not provide an equivalent of epoll for sockets, so
+   //  TcpIoThread uses Poll.
+   //
+   return NilPollSet;
+}
+
+//------------------------------------------------------------------------------
+
 void SysTcpSocket::Disconnect()
 {
    Debug::ft("SysTcpSocket.Disconnect");
@@ -160,6 +191,24 @@ void SysTcpSocket::Disconnect()
 
 //------------------------------------------------------------------------------
 
+bool SysTcpSocket::EnterPollSet(pollset_t pollSet)
+{
+   Debug::ft("SysTcpSocket.EnterPollSet");
+
+   return false;
+}
+
+//------------------------------------------------------------------------------
+
+void SysTcpSocket::ExitPollSet()
+{
+   Debug::ft("SysTcpSocket.ExitPollSet");
+
+   pollSet_ = NilPollSet;
+}
+
+//------------------------------------------------------------------------------
+
 fn_name SysTcpSocket_Listen = "SysTcpSocket.Listen";
 
 word SysTcpSocket::Listen(size_t backlog)
@@ -455,5 +504,22 @@ SysSocket::AllocRc SysTcpSocket::SetService
 
    return AllocOk;
 }
+
+//------------------------------------------------------------------------------
+
+void SysTcpSocket::UpdatePollSet()
+{
+   Debug::ft("SysTcpSocket.UpdatePollSet");
+}
+
+//------------------------------------------------------------------------------
+
+word SysTcpSocket::Wait(pollset_t pollSet,
+   SysTcpSocket* ready[], size_t size, const msecs_t& timeout)
+{
+   Debug::ft("SysTcpSocket.Wait");
+
+   return -1;
+}
 }
 #endif
@@ -101,6 +101,79 @@ SysSocket::SendRc SysUdpSocket::SendBuff(IpBuffer& buff)
 
 //------------------------------------------------------------------------------
 
+fn_name SysUdpSocket_SendBuffs = "SysUdpSocket.SendBuffs";
+
+size_t SysUdpSocket::SendBuffs(IpBuffer* buffs[], size_t count)
+{
+   Debug::ft(SysUdpSocket_SendBuffs);
+
+   if(count > MaxBatch)
+   {
+      Debug::SwLog(SysUdpSocket_SendBuffs, "count too large", count);
+      count = MaxBatch;
+   }
+
+   auto reg = Singleton<IpPortRegistry>::Instance();
+   const byte_t* data[MaxBatch];
+   size_t sizes[MaxBatch];
+   const SysIpL3Addr* peers[MaxBatch];
+   IpPort* ports[MaxBatch];
+   IpBuffer* batch[MaxBatch];
+   word sent[MaxBatch];
+   size_t n = 0;
+
+   //  Convert each message to network order, as SendBuff does, and omit any
+   //  that are too large.
+   //
+   for(size_t i = 0; i < count; ++i)
+   {
+      auto buff = buffs[i];
+      byte_t* src = nullptr;
+      auto size = buff->OutgoingBytes(src);
+
+      if(size > MaxUdpSize_)
+      {
+         Debug::SwLog(SysUdpSocket_SendBuffs, "size too large", size);
+         continue;
+      }
+
+      auto port = reg->GetPort(buff->TxAddr().GetPort());
+
+      if(port == nullptr)
+      {
+         Debug::SwLog(SysUdpSocket_SendBuffs,
+            "port not found", buff->TxAddr().GetPort());
+         continue;
+      }
+
+      data[n] = port->GetHandler()->HostToNetwork(*buff, src, size);
+      sizes[n] = size;
+      peers[n] = &buff->RxAddr();
+      ports[n] = port;
+      batch[n] = buff;
+      ++n;
+   }
+
+   if(n == 0) return 0;
+
+   auto total = SendToBatch(data, sizes, peers, n, sent);
+
+   for(size_t i = 0; i < n; ++i)
+   {
+      if(total < 0) sent[i] = -1;
+      TracePeer(NwTrace::SendTo, ports[i]->GetPort(), *peers[i], sent[i]);
+
+      if(sent[i] <= 0)
+         OutputLog(NetworkSocketError, "sendto", batch[i]);
+      else
+         ports[i]->BytesSent(sizes[i]);
+   }
+
+   return (total < 0 ? 0 : total);
+}
+
+//------------------------------------------------------------------------------
+
 void SysUdpSocket::SendToSelf(ipport_t port)
 {
    Debug::ft("SysUdpSocket.SendToSelf");
@@ -41,6 +41,10 @@ namespace NetworkBase
 class SysUdpSocket : public SysSocket
 {
 public:
+   //> The maximum number of messages received or sent in one batch.
+   //
+   static const size_t MaxBatch = 16;
+
    //  Returns the maximum size of a UDP message (in bytes).
    //
    //  NOTE: This is obtained from getsockopt when the first UDP socket
@@ -65,6 +69,16 @@ public:
    NodeBase::word RecvFrom
       (NodeBase::byte_t* buff, size_t size, SysIpL3Addr& remAddr);
 
+   //  Reads up to COUNT messages into BUFF, whose slots for messages are
+   //  SysSocket::MaxMsgSize bytes apart.  Up to SIZE bytes are read into
+   //  each slot.  Updates SIZES and remAddrs with the length and source of
+   //  each message.  Returns the number of messages read, after blocking
+   //  only until the first one arrives.  On failure, generates a log and
+   //  returns -1.
+   //
+   NodeBase::word RecvFromBatch(NodeBase::byte_t* buff, size_t size,
+      size_t count, NodeBase::word sizes[], SysIpL3Addr remAddrs[]);
+
    //  Makes the socket non-blocking and sends DATA, of length SIZE, to the
    //  destination specified by remAddr.  Returns the number of bytes sent.
    //  On failure, returns -2 if a log has been generated, or -1 if the
@@ -73,6 +87,13 @@ public:
    NodeBase::word SendTo
       (const NodeBase::byte_t* data, size_t size, const SysIpL3Addr& remAddr);
 
+   //  Sends the COUNT messages in BUFFS, all of which use this socket, with
+   //  as few system calls as possible.  Each message is traced and included
+   //  in its port's statistics.  Returns the number of messages sent, after
+   //  generating a log for each one that could not be sent.
+   //
+   size_t SendBuffs(IpBuffer* buffs[], size_t count);
+
    //  Sends a message to the socket to unblock an I/O thread in RecvFrom.
    //
    void SendToSelf(ipport_t port);
@@ -94,6 +115,15 @@ public:
    //
    SendRc SendBuff(IpBuffer& buff) override;
 private:
+   //  Makes the socket non-blocking and sends the COUNT messages described
+   //  by DATA, SIZES, and remAddrs.  Updates SENT with the number of bytes
+   //  sent for each message, or -1 if it was not sent.  Returns the number
+   //  of messages sent, or -1 if the invoker should generate a log.
+   //
+   NodeBase::word SendToBatch(const NodeBase::byte_t* data[],
+      const size_t sizes[], const SysIpL3Addr* remAddrs[],
+      size_t count, NodeBase::word sent[]);
+
    //  The maximum size of a UDP message.
    //
    static size_t MaxUdpSize_;
@@ -25,6 +25,7 @@
 #include <errno.h>
 #include <netinet/in.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include "Debug.h"
 #include "IpPortRegistry.h"
 #include "NwLogs.h"
@@ -127,6 +128,111 @@ word SysUdpSocket::RecvFrom(byte_t* buff, size_t size, SysIpL3Addr& remAddr)
 
 //------------------------------------------------------------------------------
 
+fn_name SysUdpSocket_RecvFromBatch = "SysUdpSocket.RecvFromBatch";
+
+word SysUdpSocket::RecvFromBatch(byte_t* buff, size_t size,
+   size_t count, word sizes[], SysIpL3Addr remAddrs[])
+{
+   Debug::ft(SysUdpSocket_RecvFromBatch);
+
+   if(buff == nullptr)
+   {
+      Debug::SwLog(SysUdpSocket_RecvFromBatch, "invalid buffer", 0);
+      return -1;
+   }
+
+   if((size == 0) || (size > MaxMsgSize))
+   {
+      Debug::SwLog(SysUdpSocket_RecvFromBatch, "invalid size", size);
+      return -1;
+   }
+
+   if((count == 0) || (count > MaxBatch))
+   {
+      Debug::SwLog(SysUdpSocket_RecvFromBatch, "invalid count", count);
+      return -1;
+   }
+
+   //  Each message gets its own slot in BUFF and its own peer address.
+   //  A sockaddr_in6 is large enough to hold an IPv4 address as well.
+   //
+   mmsghdr msgs[MaxBatch];
+   iovec iovs[MaxBatch];
+   sockaddr_in6 peers[MaxBatch];
+
+   auto ipv6 = IpPortRegistry::UseIPv6();
+   socklen_t peersize = (ipv6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in));
+
+   for(size_t i = 0; i < count; ++i)
+   {
+      iovs[i].iov_base = buff + (i * MaxMsgSize);
+      iovs[i].iov_len = size;
+      msgs[i].msg_hdr.msg_name = &peers[i];
+      msgs[i].msg_hdr.msg_namelen = peersize;
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_control = nullptr;
+      msgs[i].msg_hdr.msg_controllen = 0;
+      msgs[i].msg_hdr.msg_flags = 0;
+      msgs[i].msg_len = 0;
+   }
+
+   //  MSG_WAITFORONE only blocks until the first message arrives, after
+   //  which the read returns whatever other messages are already queued.
+   //
+   auto rcvd = recvmmsg(Socket(), msgs, count, MSG_WAITFORONE, nullptr);
+
+   if(rcvd < 0)
+   {
+      switch(errno)
+      {
+      case EWOULDBLOCK:
+         //
+         //  There is nothing on the socket, but it hasn't yet been made
+         //  blocking.
+         //
+         break;
+      case EINTR:
+         //
+         //  Don't log this during a restart, when an I/O thread's socket
+         //  is released so that the thread can exit.
+         //
+         if(Restart::GetLevel() >= RestartCold)
+         {
+            break;
+         }
+         [[fallthrough]];
+      default:
+         OutputLog(NetworkSocketError, "recvmmsg", errno);
+      }
+
+      return -1;
+   }
+
+   NetworkIsUp();
+
+   for(auto i = 0; i < rcvd; ++i)
+   {
+      sizes[i] = msgs[i].msg_len;
+
+      if(ipv6)
+      {
+         remAddrs[i].NetworkToHost
+            (peers[i].sin6_addr.s6_addr16, peers[i].sin6_port);
+      }
+      else
+      {
+         auto ipv4peer = reinterpret_cast<const sockaddr_in*>(&peers[i]);
+         remAddrs[i].NetworkToHost
+            (ipv4peer->sin_addr.s_addr, ipv4peer->sin_port);
+      }
+   }
+
+   return rcvd;
+}
+
+//------------------------------------------------------------------------------
+
 fn_name SysUdpSocket_SendTo = "SysUdpSocket.SendTo";
 
 word SysUdpSocket::SendTo
@@ -183,5 +289,83 @@ word SysUdpSocket::SendTo
    NetworkIsUp();
    return sent;
 }
+
+//------------------------------------------------------------------------------
+
+word SysUdpSocket::SendToBatch(const byte_t* data[], const size_t sizes[],
+   const SysIpL3Addr* remAddrs[], size_t count, word sent[])
+{
+   Debug::ft("SysUdpSocket.SendToBatch");
+
+   for(size_t i = 0; i < count; ++i) sent[i] = -1;
+
+   if(!SetBlocking(false)) return GetError();
+
+   mmsghdr msgs[MaxBatch];
+   iovec iovs[MaxBatch];
+   sockaddr_in6 peers[MaxBatch];
+
+   auto ipv6 = IpPortRegistry::UseIPv6();
+   socklen_t peersize = (ipv6 ? sizeof(sockaddr_in6) : sizeof(sockaddr_in));
+
+   for(size_t i = 0; i < count; ++i)
+   {
+      if(ipv6)
+      {
+         auto& ipv6peer = peers[i];
+         ipv6peer.sin6_family = AF_INET6;
+         remAddrs[i]->HostToNetwork
+            (ipv6peer.sin6_addr.s6_addr16, ipv6peer.sin6_port);
+         ipv6peer.sin6_flowinfo = 0;
+         ipv6peer.sin6_scope_id = 0;
+      }
+      else
+      {
+         auto ipv4peer = reinterpret_cast<sockaddr_in*>(&peers[i]);
+         ipv4peer->sin_family = AF_INET;
+         remAddrs[i]->HostToNetwork
+            (ipv4peer->sin_addr.s_addr, ipv4peer->sin_port);
+      }
+
+      iovs[i].iov_base = const_cast<byte_t*>(data[i]);
+      iovs[i].iov_len = sizes[i];
+      msgs[i].msg_hdr.msg_name = &peers[i];
+      msgs[i].msg_hdr.msg_namelen = peersize;
+      msgs[i].msg_hdr.msg_iov = &iovs[i];
+      msgs[i].msg_hdr.msg_iovlen = 1;
+      msgs[i].msg_hdr.msg_control = nullptr;
+      msgs[i].msg_hdr.msg_controllen = 0;
+      msgs[i].msg_hdr.msg_flags = 0;
+      msgs[i].msg_len = 0;
+   }
+
+   //  sendmmsg can return after sending only some of the messages, so keep
+   //  going until all have been sent or an error occurs.
+   //
+   size_t total = 0;
+
+   while(total < count)
+   {
+      auto rc = sendmmsg(Socket(), msgs + total, count - total, 0);
+
+      if(rc <= 0)
+      {
+         if(rc < 0) SetError(errno);
+         break;
+      }
+
+      size_t done = rc;
+
+      for(auto i = total; i < total + done; ++i)
+      {
+         sent[i] = msgs[i].msg_len;
+      }
+
+      total += done;
+   }
+
+   if(total > 0) NetworkIsUp();
+   return total;
+}
 }
 #endif
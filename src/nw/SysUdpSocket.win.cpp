@@ -148,6 +148,23 @@ word SysUdpSocket::RecvFrom(byte_t* buff, size_t size, SysIpL3Addr& remAddr)
 
 //------------------------------------------------------------------------------
 
+word SysUdpSocket::RecvFromBatch(byte_t* buff, size_t size,
+   size_t count, word sizes[], SysIpL3Addr remAddrs[])
+{
+   Debug::ft("SysUdpSocket.RecvFromBatch");
+
+   //  Windows has no equivalent to recvmmsg, so read one message.
+   //
+   if(count == 0) return 0;
+
+   auto rcvd = RecvFrom(buff, size, remAddrs[0]);
+   if(rcvd < 0) return -1;
+   sizes[0] = rcvd;
+   return 1;
+}
+
+//------------------------------------------------------------------------------
+
 fn_name SysUdpSocket_SendTo = "SysUdpSocket.SendTo";
 
 word SysUdpSocket::SendTo
@@ -205,5 +222,25 @@ word SysUdpSocket::SendTo
    NetworkIsUp();
    return sent;
 }
+
+//------------------------------------------------------------------------------
+
+word SysUdpSocket::SendToBatch(const byte_t* data[], const size_t sizes[],
+   const SysIpL3Addr* remAddrs[], size_t count, word sent[])
+{
+   Debug::ft("SysUdpSocket.SendToBatch");
+
+   //  Windows has no equivalent to sendmmsg, so send each message.
+   //
+   word total = 0;
+
+   for(size_t i = 0; i < count; ++i)
+   {
+      sent[i] = SendTo(data[i], sizes[i], *remAddrs[i]);
+      if(sent[i] > 0) ++total;
+   }
+
+   return total;
+}
 }
 #endif
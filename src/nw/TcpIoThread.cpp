@@ -100,7 +100,10 @@ TcpIoThread::TcpIoThread(Daemon* daemon,
    IoThread(daemon, service, port),
    listen_(true),
    ready_(0),
-   curr_(0)
+   curr_(0),
+   pollSet_(NilPollSet),
+   readyCount_(0),
+   sweepTime_(SteadyTime::Now())
 {
    Debug::ft(TcpIoThread_ctor);
 
@@ -142,6 +145,12 @@ TcpIoThread::TcpIoThread(Daemon* daemon,
    //
    sockets_.Init(fdSize);
    sockets_.Reserve(fdSize);
+
+   //  Use a poll set if possible, so that the cost of each wakeup depends
+   //  on the number of sockets with events rather than on the number of
+   //  sockets.
+   //
+   if(IpPortRegistry::UsePollSets()) pollSet_ = SysTcpSocket::CreatePollSet();
    SetInitialized();
 }
 
@@ -232,6 +241,9 @@ bool TcpIoThread::AllocateListener()
    if(socket->Listen(svc->MaxBacklog()) != 0)
       return ipPort_->RaiseAlarm(socket->GetError());
 
+   if(!EnterPollSet(socket.get()))
+      return ipPort_->RaiseAlarm(-1);
+
    socket->TracePort(NwTrace::Listen, port_, svc->MaxBacklog());
 
    if(!ipPort_->SetSocket(socket.get()))
@@ -253,6 +265,7 @@ bool TcpIoThread::AllocateListener()
       sockets_.PushBack(listener);
    else
       sockets_.Replace(0, listener);
+   listener->SetIndex(0);
    return true;
 }
 
@@ -277,15 +290,17 @@ void TcpIoThread::Display(ostream& stream,
 {
    IoThread::Display(stream, prefix, options);
 
-   stream << prefix << "listen : " << listen_ << CRLF;
-   stream << prefix << "curr   : " << curr_ << CRLF;
-   stream << prefix << "ready  : " << ready_ << CRLF;
-   stream << prefix << "size   : " << sockets_.Size() << CRLF;
+   stream << prefix << "listen     : " << listen_ << CRLF;
+   stream << prefix << "curr       : " << curr_ << CRLF;
+   stream << prefix << "ready      : " << ready_ << CRLF;
+   stream << prefix << "size       : " << sockets_.Size() << CRLF;
+   stream << prefix << "pollSet    : " << pollSet_ << CRLF;
+   stream << prefix << "readyCount : " << readyCount_ << CRLF;
 
    if(!options.test(DispVerbose)) return;
 
    auto lead = prefix + spaces(2);
-   stream << prefix << "sockets  : " << CRLF;
+   stream << prefix << "sockets    : " << CRLF;
 
    for(size_t i = 0; i < sockets_.Size(); ++i)
    {
@@ -333,7 +348,9 @@ bool TcpIoThread::EnsureListener()
       //  it unless it has failed.
       //
       if(ListenerHasFailed(registrant)) return AllocateListener();
+      if(!EnterPollSet(registrant)) return AllocateListener();
       sockets_.PushBack(registrant);
+      registrant->SetIndex(sockets_.Size() - 1);
       return true;
    }
 
@@ -374,12 +391,21 @@ void TcpIoThread::Enter()
 
       if(ready_ < 0)
       {
-         auto listener = Listener();
-         listener->OutputLog(NetworkSocketError, "poll", listener->GetError());
+         //  SysTcpSocket::Wait has already generated a log.
+         //
+         if(pollSet_ == NilPollSet)
+         {
+            auto listener = Listener();
+            listener->OutputLog
+               (NetworkSocketError, "poll", listener->GetError());
+         }
+
          Pause(msecs_t(20));
          continue;
       }
 
+      size_t count = ready_;
+
       //  If the listener has a pending event, adjust the ready count so
       //  that servicing of application sockets will stop as soon as the
       //  last application socket with a pending event has been handled.
@@ -397,10 +423,17 @@ void TcpIoThread::Enter()
       //
       self_ = IpPortRegistry::LocalAddr();
 
-      for(curr_ = first; curr_ < sockets_.Size(); ++curr_)
+      if(pollSet_ != NilPollSet)
       {
-         ServiceSocket();
-         ConditionalPause(83);
+         ServiceReadySockets(count);
+      }
+      else
+      {
+         for(curr_ = first; curr_ < sockets_.Size(); ++curr_)
+         {
+            ServiceSocket();
+            ConditionalPause(83);
+         }
       }
 
       //  Service connection requests on the listener.
@@ -423,6 +456,38 @@ void TcpIoThread::Enter()
 
 //------------------------------------------------------------------------------
 
+bool TcpIoThread::EnterPollSet(SysTcpSocket* socket) const
+{
+   Debug::ft("TcpIoThread.EnterPollSet");
+
+   //  A socket also polls for PollWrite when it queues an outgoing message.
+   //
+   socket->InFlags()->set(PollRead);
+   if(pollSet_ == NilPollSet) return true;
+   return socket->EnterPollSet(pollSet_);
+}
+
+//------------------------------------------------------------------------------
+
+void TcpIoThread::EraseReleasedSockets()
+{
+   Debug::ft("TcpIoThread.EraseReleasedSockets");
+
+   size_t first = (listen_ ? 1 : 0);
+
+   for(auto i = first; i < sockets_.Size(); ++i)
+   {
+      if(sockets_[i]->GetAppState() == SysTcpSocket::Released)
+      {
+         EraseSocket(i);
+      }
+   }
+
+   sweepTime_ = SteadyTime::Now();
+}
+
+//------------------------------------------------------------------------------
+
 fn_name TcpIoThread_EraseSocket = "TcpIoThread.EraseSocket";
 
 void TcpIoThread::EraseSocket(size_t& index)
@@ -441,8 +506,14 @@ void TcpIoThread::EraseSocket(size_t& index)
    //
    auto socket = sockets_[index];
    sockets_.Erase(index);
+   if(index < sockets_.Size()) sockets_[index]->SetIndex(index);
    --index;
 
+   for(size_t i = 0; i < readyCount_; ++i)
+   {
+      if(readySockets_[i] == socket) readySockets_[i] = nullptr;
+   }
+
    auto handler = ipPort_->GetHandler();
    auto deleted = false;
 
@@ -462,6 +533,20 @@ void TcpIoThread::EraseSocket(size_t& index)
 
 //------------------------------------------------------------------------------
 
+void TcpIoThread::EraseSocket(const SysTcpSocket* socket)
+{
+   Debug::ft("TcpIoThread.EraseSocket(socket)");
+
+   auto i = socket->Index();
+
+   if((i < sockets_.Size()) && (sockets_[i] == socket))
+   {
+      EraseSocket(i);
+   }
+}
+
+//------------------------------------------------------------------------------
+
 bool TcpIoThread::InsertSocket(SysSocket* socket)
 {
    Debug::ft("TcpIoThread.InsertSocket");
@@ -471,20 +556,26 @@ bool TcpIoThread::InsertSocket(SysSocket* socket)
    auto interrupt = sockets_.Empty();
    auto sock = static_cast<SysTcpSocket*>(socket);
 
-   if(sockets_.PushBack(sock))
+   if(!sockets_.PushBack(sock))
    {
-      //  If the thread had no sockets, it is sleeping forever
-      //  and must be woken up to service its new socket.
-      //
-      auto flags = sock->InFlags();
-      flags->set(PollRead);
-      sock->Register();
-      if(interrupt) Interrupt(ResumeExecution);
-      return true;
+      ipPort_->PollArrayOverflow();
+      return false;
    }
 
-   ipPort_->PollArrayOverflow();
-   return false;
+   sock->SetIndex(sockets_.Size() - 1);
+
+   if(!EnterPollSet(sock))
+   {
+      sockets_.Erase(sockets_.Size() - 1);
+      return false;
+   }
+
+   //  If the thread had no sockets, it is sleeping forever
+   //  and must be woken up to service its new socket.
+   //
+   sock->Register();
+   if(interrupt) Interrupt(ResumeExecution);
+   return true;
 }
 
 //------------------------------------------------------------------------------
@@ -521,6 +612,7 @@ word TcpIoThread::PollSockets()
       auto listener = Listener();
       listener->SetBlocking(true);
       listener->InFlags()->set(PollRead);
+      listener->OutFlags()->reset();
    }
 
    //  Record the number of sockets on which messages were read since
@@ -536,7 +628,15 @@ word TcpIoThread::PollSockets()
    //
    EnterBlockingOperation(BlockedOnNetwork, TcpIoThread_Enter);
    {
-      ready = SysTcpSocket::Poll(sockets, size, msecs_t(2000));
+      if(pollSet_ != NilPollSet)
+      {
+         ready = SysTcpSocket::Wait
+            (pollSet_, readySockets_, MaxEvents, msecs_t(2000));
+      }
+      else
+      {
+         ready = SysTcpSocket::Poll(sockets, size, msecs_t(2000));
+      }
    }
    ExitBlockingOperation(TcpIoThread_Enter);
 
@@ -565,28 +665,24 @@ void TcpIoThread::ReleaseResources()
    }
 
    if(ipPort_ != nullptr) ipPort_->SetSocket(nullptr);
+
+   SysTcpSocket::ClosePollSet(pollSet_);
+   pollSet_ = NilPollSet;
 }
 
 //------------------------------------------------------------------------------
 
-void TcpIoThread::ServiceSocket()
+bool TcpIoThread::ServiceEvents(SysTcpSocket* socket)
 {
-   Debug::ft("TcpIoThread.ServiceSocket");
+   Debug::ft("TcpIoThread.ServiceEvents");
 
-   auto socket = sockets_[curr_];
-   if(socket == nullptr) return;
-
-   //  Return if this socket has neither reported an event nor
-   //  been released by the application.
+   //  Erase the socket if it has been released by the application.
+   //  Otherwise return if it has not reported an event.
    //
-   if(socket->GetAppState() == SysTcpSocket::Released)
-   {
-      EraseSocket(curr_);
-      return;
-   }
+   if(socket->GetAppState() == SysTcpSocket::Released) return false;
 
    auto flags = socket->OutFlags();
-   if(flags->none()) return;
+   if(flags->none()) return true;
 
    --ready_;
 
@@ -595,8 +691,7 @@ void TcpIoThread::ServiceSocket()
    if(flags->test(PollHungUp) || flags->test(PollError) ||
       flags->test(PollInvalid))
    {
-      EraseSocket(curr_);
-      return;
+      return false;
    }
 
    //  If the socket is writeable, tell it to send queued messages.
@@ -606,7 +701,7 @@ void TcpIoThread::ServiceSocket()
    //  If the socket has an incoming message, read it.  On failure,
    //  release the socket.
    //
-   if(!flags->test(PollRead)) return;
+   if(!flags->test(PollRead)) return true;
 
    time_ = SteadyTime::Now();
 
@@ -619,8 +714,7 @@ void TcpIoThread::ServiceSocket()
          socket->OutputLog(NetworkSocketError, "recv", socket->GetError());
       }
 
-      EraseSocket(curr_);
-      return;
+      return false;
    }
 
    ++recvs_;
@@ -634,11 +728,55 @@ void TcpIoThread::ServiceSocket()
    if(!socket->RemAddr(txAddr_))
    {
       socket->OutputLog(NetworkSocketError, "getpeername", socket->GetError());
-      return;
+      return true;
    }
 
    rxAddr_ = SysIpL3Addr(self_, port_, IpTcp, socket);
    InvokeHandler(*ipPort_, buffer_, rcvd);
+   return true;
+}
+
+//------------------------------------------------------------------------------
+
+void TcpIoThread::ServiceReadySockets(size_t count)
+{
+   Debug::ft("TcpIoThread.ServiceReadySockets");
+
+   //  Only the sockets that reported events need to be serviced.  The
+   //  listener is serviced separately.
+   //
+   auto listener = (listen_ ? Listener() : nullptr);
+   readyCount_ = count;
+
+   for(size_t i = 0; i < count; ++i)
+   {
+      auto socket = readySockets_[i];
+      if((socket == nullptr) || (socket == listener)) continue;
+      if(!ServiceEvents(socket)) EraseSocket(socket);
+      ConditionalPause(83);
+   }
+
+   readyCount_ = 0;
+
+   //  A socket that the application released only reports an event when
+   //  its peer disconnects, so also look for released sockets, but only
+   //  as often as a Poll that timed out would have found them.
+   //
+   if(SteadyTime::Now() - sweepTime_ >= msecs_t(2000))
+   {
+      EraseReleasedSockets();
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void TcpIoThread::ServiceSocket()
+{
+   Debug::ft("TcpIoThread.ServiceSocket");
+
+   auto socket = sockets_[curr_];
+   if(socket == nullptr) return;
+   if(!ServiceEvents(socket)) EraseSocket(curr_);
 }
 
 //------------------------------------------------------------------------------
@@ -27,6 +27,7 @@
 #include "Allocators.h"
 #include "Array.h"
 #include "NwTypes.h"
+#include "SteadyTime.h"
 #include "SysTypes.h"
 
 namespace NetworkBase
@@ -74,6 +75,11 @@ protected:
    //
    void Unblock() override;
 private:
+   //  The maximum number of sockets with events that are serviced after
+   //  waiting on the poll set.
+   //
+   static const size_t MaxEvents = 256;
+
    //  Returns the listener socket.
    //
    SysTcpSocket* Listener() const;
@@ -88,8 +94,14 @@ private:
    //
    bool AllocateListener();
 
+   //  Prepares SOCKET to report incoming messages.  If the thread uses
+   //  a poll set, also adds SOCKET to it.  Returns false on failure.
+   //
+   bool EnterPollSet(SysTcpSocket* socket) const;
+
    //  Polls the sockets until at least one of them reports an event or
-   //  an error occurs.  Returns the result of SysTcpSocket::Poll.
+   //  an error occurs.  Returns the result of SysTcpSocket::Poll or, if
+   //  the thread uses a poll set, SysTcpSocket::Wait.
    //
    NodeBase::word PollSockets();
 
@@ -97,6 +109,16 @@ private:
    //
    void ServiceSocket();
 
+   //  Services the first COUNT sockets in readySockets_, which reported
+   //  events when the thread waited on its poll set.
+   //
+   void ServiceReadySockets(size_t count);
+
+   //  Services the events reported by SOCKET.  Returns false if the socket
+   //  should be erased.
+   //
+   bool ServiceEvents(SysTcpSocket* socket);
+
    //  Invoked to accept a connection.  Clears the PollRead flag if no
    //  connection request was pending.  Returns true if a connection was
    //  accepted.
@@ -106,9 +128,22 @@ private:
    //  Removes sockets_[index] from the list of sockets.  If it contains a
    //  valid socket, that socket is released.  Because the last socket moves
    //  into the vacated slot, INDEX (used for iteration) is decremented.
+   //  If the socket is also in readySockets_, its entry is cleared so that
+   //  it will not be serviced after it has been deleted.
    //
    void EraseSocket(size_t& index);
 
+   //  Removes SOCKET from the list of sockets.  The socket records its
+   //  index in the list, so no search is required.
+   //
+   void EraseSocket(const SysTcpSocket* socket);
+
+   //  Removes sockets that applications have released.  When the thread
+   //  uses a poll set, this is done periodically, because such a socket
+   //  only reports an event after its peer disconnects.
+   //
+   void EraseReleasedSockets();
+
    //  Releases resources when exiting or cleaning up the thread.
    //
    void ReleaseResources();
@@ -144,6 +179,23 @@ private:
    //  The socket currently being serviced (used to index sockets_).
    //
    size_t curr_;
+
+   //  The set of sockets that reports events, if one is used instead of
+   //  polling every socket.
+   //
+   pollset_t pollSet_;
+
+   //  The sockets that reported events when waiting on pollSet_.
+   //
+   SysTcpSocket* readySockets_[MaxEvents];
+
+   //  The number of entries in readySockets_ that are being serviced.
+   //
+   size_t readyCount_;
+
+   //  When EraseReleasedSockets was last invoked.
+   //
+   NodeBase::SteadyTime::Point sweepTime_;
 };
 }
 #endif
@@ -21,11 +21,14 @@
 //
 #include "UdpIoThread.h"
 #include <chrono>
+#include <ostream>
 #include <ratio>
+#include <string>
 #include "Debug.h"
 #include "Duration.h"
 #include "IpPort.h"
 #include "IpPortRegistry.h"
+#include "Memory.h"
 #include "NbTypes.h"
 #include "NwTrace.h"
 #include "Singleton.h"
@@ -36,6 +39,8 @@
 #include "UdpIpService.h"
 
 using namespace NodeBase;
+using std::ostream;
+using std::string;
 
 //------------------------------------------------------------------------------
 
@@ -43,11 +48,17 @@ namespace NetworkBase
 {
 fn_name UdpIoThread_ctor = "UdpIoThread.ctor";
 
-UdpIoThread::UdpIoThread(Daemon* daemon,
-   const UdpIpService* service, ipport_t port) : IoThread(daemon, service, port)
+UdpIoThread::UdpIoThread(Daemon* daemon, const UdpIpService* service,
+   ipport_t port) : IoThread(daemon, service, port),
+   batch_(nullptr)
 {
    Debug::ft(UdpIoThread_ctor);
 
+   for(size_t i = 0; i < SysUdpSocket::MaxBatch; ++i)
+   {
+      sizes_[i] = 0;
+   }
+
    ipPort_ = Singleton<IpPortRegistry>::Instance()->GetPort(port_, IpUdp);
 
    if(ipPort_ != nullptr)
@@ -55,6 +66,8 @@ UdpIoThread::UdpIoThread(Daemon* daemon,
    else
       Debug::SwLog(UdpIoThread_ctor, "port not configured", port_);
 
+   auto size = SysUdpSocket::MaxBatch * SysSocket::MaxMsgSize;
+   batch_ = (byte_t*) Memory::Alloc(size, MemDynamic);
    SetInitialized();
 }
 
@@ -65,6 +78,9 @@ UdpIoThread::~UdpIoThread()
    Debug::ftnt("UdpIoThread.dtor");
 
    ReleaseResources();
+
+   Memory::Free(batch_, MemDynamic);
+   batch_ = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -76,13 +92,23 @@ c_string UdpIoThread::AbbrName() const
 
 //------------------------------------------------------------------------------
 
+void UdpIoThread::Display(ostream& stream,
+   const string& prefix, const Flags& options) const
+{
+   IoThread::Display(stream, prefix, options);
+
+   stream << prefix << "batch  : " << batch_ << CRLF;
+}
+
+//------------------------------------------------------------------------------
+
 fn_name UdpIoThread_Enter = "UdpIoThread.Enter";
 
 void UdpIoThread::Enter()
 {
    Debug::ft(UdpIoThread_Enter);
 
-   word rcvd = 0;
+   word count = 0;
 
    //  Exit if an IP port is not assigned to this thread.
    //
@@ -139,6 +165,9 @@ void UdpIoThread::Enter()
       //
       ConditionalPause(87);
 
+      //  Read as many messages as are waiting, up to a batch, in one call.
+      //  Block only if the socket is empty.
+      //
       if(socket->Empty())
       {
          ipPort_->RecvsInSequence(recvs_);
@@ -146,40 +175,46 @@ void UdpIoThread::Enter()
 
          EnterBlockingOperation(BlockedOnNetwork, UdpIoThread_Enter);
          {
-            rcvd =
-               socket->RecvFrom(buffer_, SysUdpSocket::MaxUdpSize(), txAddr_);
+            count = socket->RecvFromBatch(batch_, SysUdpSocket::MaxUdpSize(),
+               SysUdpSocket::MaxBatch, sizes_, peers_);
          }
          ExitBlockingOperation(UdpIoThread_Enter);
 
-         socket->TracePeer(NwTrace::RecvFrom, port_, txAddr_, rcvd);
          recvs_ = 0;
       }
       else
       {
          socket->SetBlocking(false);
-         rcvd = socket->RecvFrom(buffer_, SysUdpSocket::MaxUdpSize(), txAddr_);
-         socket->TracePeer(NwTrace::RecvFrom, port_, txAddr_, rcvd);
+         count = socket->RecvFromBatch(batch_, SysUdpSocket::MaxUdpSize(),
+            SysUdpSocket::MaxBatch, sizes_, peers_);
       }
 
-      ++recvs_;
       time_ = SteadyTime::Now();
 
-      if(rcvd < 0)
+      if(count <= 0)
       {
          //  Take a short break and hope the problem goes away.  WSAEWOULDBLOCK
          //  is a chronic occurrence on Windows, which is curious because the
          //  code above tries to make the socket blocking when it has no more
          //  mesaages waiting.
          //
+         socket->TracePeer(NwTrace::RecvFrom, port_, txAddr_, -1);
          Pause(msecs_t(20));
          recvs_ = 0;
          continue;
       }
 
-      //  Pass the message to the input handler.
+      //  Pass each message to the input handler in turn.
       //
-      ipPort_->BytesRcvd(rcvd);
-      InvokeHandler(*ipPort_, buffer_, rcvd);
+      for(word i = 0; i < count; ++i)
+      {
+         auto rcvd = sizes_[i];
+         txAddr_ = peers_[i];
+         socket->TracePeer(NwTrace::RecvFrom, port_, txAddr_, rcvd);
+         ++recvs_;
+         ipPort_->BytesRcvd(rcvd);
+         InvokeHandler(*ipPort_, batch_ + (i * SysSocket::MaxMsgSize), rcvd);
+      }
    }
 }
 
@@ -23,7 +23,11 @@
 #define UDPIOTHREAD_H_INCLUDED
 
 #include "IoThread.h"
+#include "NbTypes.h"
 #include "NwTypes.h"
+#include "SysIpL3Addr.h"
+#include "SysTypes.h"
+#include "SysUdpSocket.h"
 
 namespace NetworkBase
 {
@@ -45,6 +49,11 @@ public:
    UdpIoThread
       (NodeBase::Daemon* daemon, const UdpIpService* service, ipport_t port);
 
+   //  Overridden to display member variables.
+   //
+   void Display(std::ostream& stream,
+      const std::string& prefix, const NodeBase::Flags& options) const override;
+
    //  Overridden for patching.
    //
    void Patch(sel_t selector, void* arguments) override;
@@ -68,6 +77,19 @@ private:
    //  Overridden to receive UDP messages on PORT.
    //
    void Enter() override;
+
+   //  The buffer for receiving a batch of messages.  Each message has its
+   //  own slot, and the slots are SysSocket::MaxMsgSize bytes apart.
+   //
+   NodeBase::byte_t* batch_;
+
+   //  The size of each message in the current batch.
+   //
+   NodeBase::word sizes_[SysUdpSocket::MaxBatch];
+
+   //  The source of each message in the current batch.
+   //
+   SysIpL3Addr peers_[SysUdpSocket::MaxBatch];
 };
 }
 #endif
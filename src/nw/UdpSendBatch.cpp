@@ -0,0 +1,130 @@
+//==============================================================================
+//
+//  UdpSendBatch.cpp
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "UdpSendBatch.h"
+#include "Debug.h"
+#include "IpBuffer.h"
+#include "SysSocket.h"
+#include "SysTypes.h"
+
+using namespace NodeBase;
+
+//------------------------------------------------------------------------------
+
+namespace NetworkBase
+{
+UdpSendBatch::UdpSendBatch() : count_(0)
+{
+   Debug::ft("UdpSendBatch.ctor");
+
+   for(size_t i = 0; i < SysUdpSocket::MaxBatch; ++i)
+   {
+      buffs_[i] = nullptr;
+   }
+}
+
+//------------------------------------------------------------------------------
+
+UdpSendBatch::~UdpSendBatch()
+{
+   Debug::ftnt("UdpSendBatch.dtor");
+
+   Purge();
+}
+
+//------------------------------------------------------------------------------
+
+void UdpSendBatch::Add(IpBuffer* buff)
+{
+   Debug::ft("UdpSendBatch.Add");
+
+   if(buff == nullptr) return;
+   if(count_ >= SysUdpSocket::MaxBatch) Flush();
+
+   buffs_[count_] = buff;
+   ++count_;
+}
+
+//------------------------------------------------------------------------------
+
+fn_name UdpSendBatch_Flush = "UdpSendBatch.Flush";
+
+size_t UdpSendBatch::Flush()
+{
+   Debug::ft(UdpSendBatch_Flush);
+
+   if(count_ == 0) return 0;
+
+   //  Find each message's socket now rather than when it was added, in
+   //  case the socket has since been replaced.  Then send all messages
+   //  that share the first message's socket, and repeat for the messages
+   //  that remain.
+   //
+   SysSocket* sockets[SysUdpSocket::MaxBatch];
+
+   for(size_t i = 0; i < count_; ++i)
+   {
+      sockets[i] = buffs_[i]->FindSocket();
+   }
+
+   IpBuffer* group[SysUdpSocket::MaxBatch];
+   size_t sent = 0;
+
+   for(size_t i = 0; i < count_; ++i)
+   {
+      auto socket = sockets[i];
+      if(socket == nullptr) continue;
+
+      size_t n = 0;
+
+      for(auto j = i; j < count_; ++j)
+      {
+         if(sockets[j] == socket)
+         {
+            group[n++] = buffs_[j];
+            sockets[j] = nullptr;
+         }
+      }
+
+      sent += static_cast<SysUdpSocket*>(socket)->SendBuffs(group, n);
+   }
+
+   auto failed = count_ - sent;
+   if(failed > 0) Debug::SwLog(UdpSendBatch_Flush, "send failed", failed);
+   Purge();
+   return failed;
+}
+
+//------------------------------------------------------------------------------
+
+void UdpSendBatch::Purge()
+{
+   Debug::ftnt("UdpSendBatch.Purge");
+
+   for(size_t i = 0; i < count_; ++i)
+   {
+      delete buffs_[i];
+      buffs_[i] = nullptr;
+   }
+
+   count_ = 0;
+}
+}
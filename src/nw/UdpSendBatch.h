@@ -0,0 +1,88 @@
+//==============================================================================
+//
+//  UdpSendBatch.h
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef UDPSENDBATCH_H_INCLUDED
+#define UDPSENDBATCH_H_INCLUDED
+
+#include <cstddef>
+#include "NwTypes.h"
+#include "SysUdpSocket.h"
+
+//------------------------------------------------------------------------------
+
+namespace NetworkBase
+{
+//  Holds outgoing UDP messages so that those which share a socket can be
+//  sent together, using one system call, when the batch is flushed.  The
+//  batch takes ownership of each message that is added to it, so a message
+//  must be flushed before the sender sends anything that should not overtake
+//  it.
+//
+class UdpSendBatch
+{
+public:
+   //  Creates an empty batch.
+   //
+   UdpSendBatch();
+
+   //  Deletes any messages that were not sent.
+   //
+   ~UdpSendBatch();
+
+   //  Deleted to prohibit copying.
+   //
+   UdpSendBatch(const UdpSendBatch& that) = delete;
+
+   //  Deleted to prohibit copy assignment.
+   //
+   UdpSendBatch& operator=(const UdpSendBatch& that) = delete;
+
+   //  Adds BUFF, which IpBuffer::Defer has prepared, to the batch, which
+   //  takes ownership of it.  The batch is first flushed if it is full.
+   //
+   void Add(IpBuffer* buff);
+
+   //  Sends all messages in the batch.  Messages that share a socket are
+   //  sent together, in the order in which they were added.  Because the
+   //  sender was told that each message was sent when it was deferred, a
+   //  log is generated if any message could not be sent.  Returns the
+   //  number of messages that could not be sent.
+   //
+   size_t Flush();
+
+   //  Deletes all messages in the batch without sending them.
+   //
+   void Purge();
+
+   //  Returns the number of messages in the batch.
+   //
+   size_t Count() const { return count_; }
+private:
+   //  The messages in the batch.
+   //
+   IpBuffer* buffs_[SysUdpSocket::MaxBatch];
+
+   //  The number of messages in the batch.
+   //
+   size_t count_;
+};
+}
+#endif
@@ -39,8 +39,8 @@ OnModule::OnModule() : Module("on")
 
    //  Create the modules required by OperationsNode.
    //
-   Singleton<CnModule>::Instance();
-   Singleton<PbModule>::Instance();
+   Requires(*Singleton<CnModule>::Instance());
+   Requires(*Singleton<PbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
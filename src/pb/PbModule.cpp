@@ -54,7 +54,7 @@ PbModule::PbModule() : Module()
 
    //  Create the modules required by PotsBase.
    //
-   Singleton<CbModule>::Instance();
+   Requires(*Singleton<CbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
@@ -27,8 +27,10 @@
 #include "Log.h"
 #include "MsgHeader.h"
 #include "NbAppIds.h"
+#include "PotsDnIndex.h"
 #include "PotsLogs.h"
 #include "PotsProfile.h"
+#include "Singleton.h"
 #include "Switch.h"
 
 using std::ostream;
@@ -71,6 +73,9 @@ PotsCircuit::~PotsCircuit()
    Debug::ftnt("PotsCircuit.dtor");
 
    StateCount_[state_]--;
+
+   auto index = Singleton<PotsDnIndex>::Extant();
+   if(index != nullptr) index->Remove(profile_->GetDN());
 }
 
 //------------------------------------------------------------------------------
@@ -430,6 +435,12 @@ void PotsCircuit::SetState(State state)
 {
    Debug::ft("PotsCircuit.SetState");
 
+   if((state == Idle) != (state_ == Idle))
+   {
+      auto index = Singleton<PotsDnIndex>::Extant();
+      if(index != nullptr) index->SetIdle(profile_->GetDN(), state == Idle);
+   }
+
    StateCount_[state_]--;
    state_ = state;
    StateCount_[state_]++;
@@ -26,6 +26,7 @@
 
 namespace PotsBase
 {
+fixed_string AllocationFailed       = "Memory could not be allocated.";
 fixed_string AlreadyRegistered      = "That DN is already registered.";
 fixed_string AlreadySubscribed      = "That feature is already subscribed.";
 fixed_string DefaultTimeoutWarning  = "WARNING: Default timeout used.";
@@ -33,6 +33,7 @@ namespace PotsBase
 {
 //  Strings used by commands in the POTS increment.
 //
+extern fixed_string AllocationFailed;
 extern fixed_string AlreadyRegistered;
 extern fixed_string AlreadySubscribed;
 extern fixed_string DefaultTimeoutWarning;
@@ -0,0 +1,183 @@
+//==============================================================================
+//
+//  PotsDnIndex.cpp
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#include "PotsDnIndex.h"
+#include <ostream>
+#include <string>
+#include "Algorithms.h"
+#include "Debug.h"
+#include "Memory.h"
+#include "SysTypes.h"
+
+using std::ostream;
+using std::string;
+
+//------------------------------------------------------------------------------
+
+namespace PotsBase
+{
+//  The number of entries in each of the index's arrays.
+//
+constexpr uint32_t IndexSize = Address::LastDN - Address::FirstDN + 2;
+
+//------------------------------------------------------------------------------
+
+PotsDnIndex::PotsDnIndex() :
+   dns_(nullptr),
+   positions_(nullptr),
+   size_(0),
+   idle_(0)
+{
+   Debug::ft("PotsDnIndex.ctor");
+
+   dns_ = (Address::DN*)
+      Memory::Alloc(sizeof(Address::DN) * IndexSize, MemDynamic);
+   positions_ = (uint32_t*)
+      Memory::Alloc(sizeof(uint32_t) * IndexSize, MemDynamic);
+
+   for(uint32_t i = 0; i < IndexSize; ++i) positions_[i] = NilPosition;
+}
+
+//------------------------------------------------------------------------------
+
+PotsDnIndex::~PotsDnIndex()
+{
+   Debug::ftnt("PotsDnIndex.dtor");
+
+   Memory::Free(positions_, MemDynamic);
+   positions_ = nullptr;
+   Memory::Free(dns_, MemDynamic);
+   dns_ = nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+void PotsDnIndex::Add(Address::DN dn, bool idle)
+{
+   Debug::ft("PotsDnIndex.Add");
+
+   if(!Address::IsValidDN(dn)) return;
+   if(positions_[Address::DNToIndex(dn)] != NilPosition) return;
+
+   //  Add DN as a busy DN, and then move it into the idle region if
+   //  its circuit is idle.
+   //
+   dns_[size_] = dn;
+   positions_[Address::DNToIndex(dn)] = size_;
+   ++size_;
+
+   if(idle) SetIdle(dn, true);
+}
+
+//------------------------------------------------------------------------------
+
+void PotsDnIndex::Display(ostream& stream,
+   const string& prefix, const Flags& options) const
+{
+   Dynamic::Display(stream, prefix, options);
+
+   stream << prefix << "dns       : " << dns_ << CRLF;
+   stream << prefix << "positions : " << positions_ << CRLF;
+   stream << prefix << "size      : " << size_ << CRLF;
+   stream << prefix << "idle      : " << idle_ << CRLF;
+}
+
+//------------------------------------------------------------------------------
+
+Address::DN PotsDnIndex::RandomBusy() const
+{
+   Debug::ft("PotsDnIndex.RandomBusy");
+
+   if(idle_ >= size_) return Address::NilDN;
+   return dns_[rand(idle_, size_ - 1)];
+}
+
+//------------------------------------------------------------------------------
+
+Address::DN PotsDnIndex::RandomIdle() const
+{
+   Debug::ft("PotsDnIndex.RandomIdle");
+
+   if(idle_ == 0) return Address::NilDN;
+   return dns_[rand(0, idle_ - 1)];
+}
+
+//------------------------------------------------------------------------------
+
+void PotsDnIndex::Remove(Address::DN dn)
+{
+   Debug::ftnt("PotsDnIndex.Remove");
+
+   if(!Address::IsValidDN(dn)) return;
+   auto pos = positions_[Address::DNToIndex(dn)];
+   if(pos == NilPosition) return;
+
+   //  Make DN busy, so that it follows all idle DNs, and then move it
+   //  to the end of the array before removing it.
+   //
+   SetIdle(dn, false);
+   pos = positions_[Address::DNToIndex(dn)];
+   Swap(pos, size_ - 1);
+   --size_;
+   positions_[Address::DNToIndex(dn)] = NilPosition;
+}
+
+//------------------------------------------------------------------------------
+
+void PotsDnIndex::SetIdle(Address::DN dn, bool idle)
+{
+   Debug::ftnt("PotsDnIndex.SetIdle");
+
+   if(!Address::IsValidDN(dn)) return;
+   auto pos = positions_[Address::DNToIndex(dn)];
+   if(pos == NilPosition) return;
+
+   //  An idle DN moves to the end of the idle region, and a busy DN
+   //  moves to the start of the busy region.
+   //
+   if(idle)
+   {
+      if(pos < idle_) return;
+      Swap(pos, idle_);
+      ++idle_;
+   }
+   else
+   {
+      if(pos >= idle_) return;
+      --idle_;
+      Swap(pos, idle_);
+   }
+}
+
+//------------------------------------------------------------------------------
+
+void PotsDnIndex::Swap(uint32_t i, uint32_t j)
+{
+   if(i == j) return;
+
+   auto dn1 = dns_[i];
+   auto dn2 = dns_[j];
+   dns_[i] = dn2;
+   dns_[j] = dn1;
+   positions_[Address::DNToIndex(dn1)] = j;
+   positions_[Address::DNToIndex(dn2)] = i;
+}
+}
@@ -0,0 +1,125 @@
+//==============================================================================
+//
+//  PotsDnIndex.h
+//
+//  Copyright (C) 2013-2025  Greg Utas
+//
+//  This file is part of the Robust Services Core (RSC).
+//
+//  RSC is free software: you can redistribute it and/or modify it under the
+//  terms of the Lesser GNU General Public License as published by the Free
+//  Software Foundation, either version 3 of the License, or (at your option)
+//  any later version.
+//
+//  RSC is distributed in the hope that it will be useful, but WITHOUT ANY
+//  WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+//  FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+//  details.
+//
+//  You should have received a copy of the Lesser GNU General Public License
+//  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef POTSDNINDEX_H_INCLUDED
+#define POTSDNINDEX_H_INCLUDED
+
+#include "Dynamic.h"
+#include <cstddef>
+#include <cstdint>
+#include "BcAddress.h"
+#include "NbTypes.h"
+
+using namespace NodeBase;
+using namespace CallBase;
+
+//------------------------------------------------------------------------------
+
+namespace PotsBase
+{
+//  Tracks whether the circuits for a set of DNs are idle, so that a DN with
+//  an idle or busy circuit can be chosen at random in constant time.  The
+//  DNs are kept in an array, with idle DNs preceding busy ones.  PotsCircuit
+//  updates the index when a circuit for one of its DNs enters or leaves the
+//  Idle state.  Used by the traffic generator.
+//
+class PotsDnIndex : public Dynamic
+{
+   friend class Singleton<PotsDnIndex>;
+public:
+   //  Deleted to prohibit copying.
+   //
+   PotsDnIndex(const PotsDnIndex& that) = delete;
+
+   //  Deleted to prohibit copy assignment.
+   //
+   PotsDnIndex& operator=(const PotsDnIndex& that) = delete;
+
+   //  Adds DN to the index.  IDLE is set if its circuit is idle.
+   //
+   void Add(Address::DN dn, bool idle);
+
+   //  Removes DN from the index.
+   //
+   void Remove(Address::DN dn);
+
+   //  Updates the status of DN, if it is in the index.
+   //
+   void SetIdle(Address::DN dn, bool idle);
+
+   //  Returns a random DN whose circuit is idle.  Returns NilDN if
+   //  there is no such DN.
+   //
+   Address::DN RandomIdle() const;
+
+   //  Returns a random DN whose circuit is not idle.  Returns NilDN if
+   //  there is no such DN.
+   //
+   Address::DN RandomBusy() const;
+
+   //  Returns the number of DNs in the index.
+   //
+   size_t Size() const { return size_; }
+
+   //  Returns the number of DNs whose circuits are idle.
+   //
+   size_t IdleCount() const { return idle_; }
+
+   //  Overridden to display member variables.
+   //
+   void Display(std::ostream& stream,
+      const std::string& prefix, const Flags& options) const override;
+private:
+   //  Private because this is a singleton.
+   //
+   PotsDnIndex();
+
+   //  Private because this is a singleton.
+   //
+   ~PotsDnIndex();
+
+   //  Swaps the DNs at positions I and J in dns_.
+   //
+   void Swap(uint32_t i, uint32_t j);
+
+   //  The value in positions_ for a DN that is not in the index.
+   //
+   static const uint32_t NilPosition = UINT32_MAX;
+
+   //  The DNs in the index.  The first idle_ entries are DNs whose circuits
+   //  are idle, and the remaining entries (up to size_) are busy DNs.
+   //
+   Address::DN* dns_;
+
+   //  Each DN's position in dns_, indexed by Address::DNToIndex.
+   //
+   uint32_t* positions_;
+
+   //  The number of DNs in the index.
+   //
+   uint32_t size_;
+
+   //  The number of DNs whose circuits are idle.
+   //
+   uint32_t idle_;
+};
+}
+#endif
@@ -398,6 +398,45 @@ word MepsCommand::ProcessCommand(CliThread& cli) const
    return count;
 }
 
+//------------------------------------------------------------------------------
+//
+//  The PROVISION command.
+//
+class ProvisionCommand : public CliCommand
+{
+public:
+   ProvisionCommand();
+private:
+   word ProcessCommand(CliThread& cli) const override;
+};
+
+fixed_string ProvisionFileExpl = "read DNs from <str>.txt";
+
+fixed_string ProvisionStr = "provision";
+fixed_string ProvisionExpl = "Adds the DNs listed in a file.";
+
+ProvisionCommand::ProvisionCommand() : CliCommand(ProvisionStr, ProvisionExpl)
+{
+   BindParm(*new CliTextParm(ProvisionFileExpl, false, 0));
+}
+
+word ProvisionCommand::ProcessCommand(CliThread& cli) const
+{
+   Debug::ft("ProvisionCommand.ProcessCommand");
+
+   std::string name;
+   std::string expl;
+   size_t count;
+
+   if(!GetString(name, cli)) return -1;
+   if(!cli.EndOfInput()) return -1;
+
+   auto reg = Singleton<PotsProfileRegistry>::Instance();
+   auto rc = reg->LoadProfiles(name, count, expl);
+   *cli.obuf << spaces(2) << "DNs added: " << count << CRLF;
+   return cli.Report(rc, expl);
+}
+
 //------------------------------------------------------------------------------
 //
 //  The REGISTER command.
@@ -712,6 +751,7 @@ PotsIncrement::PotsIncrement() : CliIncrement(PotsText, PotsExpl)
    BindCommand(*new CodesCommand);
    BindCommand(*new FeaturesCommand);
    BindCommand(*new RegisterCommand);
+   BindCommand(*new ProvisionCommand);
    BindCommand(*new DeregisterCommand);
    BindCommand(*new SubscribeCommand);
    BindCommand(*new ActivateCommand);
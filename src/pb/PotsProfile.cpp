@@ -20,8 +20,7 @@
 //  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "PotsProfile.h"
-#include <bitset>
-#include <cstdint>
+#include <new>
 #include <sstream>
 #include <string>
 #include "Algorithms.h"
@@ -29,6 +28,7 @@
 #include "Debug.h"
 #include "Formatters.h"
 #include "FunctionGuard.h"
+#include "Memory.h"
 #include "MsgPort.h"
 #include "NbTypes.h"
 #include "PotsCliParms.h"
@@ -49,15 +49,17 @@ using std::string;
 
 namespace PotsBase
 {
-PotsProfile::PotsProfile(DN dn)
+PotsProfile::PotsProfile(DN dn) :
+   dn_(dn),
+   features_(0),
+   featureTable_(nullptr),
+   featureCap_(0)
 {
    Debug::ft("PotsProfile.ctor");
 
-   //  Set the profile's identifier to its DN, create a circuit for it,
-   //  initialize its queue of subscribed features, and add it to the
-   //  POTS profile registry.
+   //  Create a circuit for the profile, initialize its queue of subscribed
+   //  features, and add it to the POTS profile registry.
    //
-   dn_.SetId(Address::DNToIndex(dn));
    circuit_.reset(new PotsCircuit(*this));
    featureq_.Init(PotsFeatureProfile::LinkDiff());
    dyn_.reset(new PotsProfileDynamic);
@@ -74,15 +76,12 @@ PotsProfile::~PotsProfile()
    //  Remove the profile from the registry.
    //
    Singleton<PotsProfileRegistry>::Extant()->UnbindProfile(*this);
-}
-
-//------------------------------------------------------------------------------
 
-ptrdiff_t PotsProfile::CellDiff()
-{
-   uintptr_t local;
-   auto fake = reinterpret_cast<const PotsProfile*>(&local);
-   return ptrdiff(&fake->dn_, fake);
+   if(featureTable_ != nullptr)
+   {
+      Memory::Free(featureTable_, MemProtected);
+      featureTable_ = nullptr;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -140,11 +139,10 @@ void PotsProfile::Display(ostream& stream,
 {
    Address::Display(stream, prefix, options);
 
-   stream << prefix << "DN       : " << Address::IndexToDN(GetDN());
-   stream << prefix << "DN id    : " << dn_.to_str() << CRLF;
-   stream << prefix << "state    : " << dyn_->state_ << CRLF;
-   stream << prefix << "objAddr  : " << dyn_->objAddr_.to_str() << CRLF;
-   stream << prefix << "circuit  : ";
+   stream << prefix << "DN           : " << dn_ << CRLF;
+   stream << prefix << "state        : " << dyn_->state_ << CRLF;
+   stream << prefix << "objAddr      : " << dyn_->objAddr_.to_str() << CRLF;
+   stream << prefix << "circuit      : ";
 
    if(options.test(DispVerbose))
    {
@@ -163,8 +161,11 @@ void PotsProfile::Display(ostream& stream,
       stream << strObj(circuit_.get()) << CRLF;
    }
 
-   stream << prefix << "featureq : " << CRLF;
+   stream << prefix << "featureq     : " << CRLF;
    featureq_.Display(stream, prefix + spaces(2), options);
+   stream << prefix << "features     : " << strHex(features_) << CRLF;
+   stream << prefix << "featureTable : " << featureTable_ << CRLF;
+   stream << prefix << "featureCap   : " << featureCap_ << CRLF;
 }
 
 //------------------------------------------------------------------------------
@@ -173,21 +174,43 @@ PotsFeatureProfile* PotsProfile::FindFeature(PotsFeature::Id fid) const
 {
    Debug::ft("PotsProfile.FindFeature");
 
+   if(!HasFeature(fid)) return nullptr;
+   return featureTable_[FeatureRank(features_, fid)];
+}
+
+//------------------------------------------------------------------------------
+
+void PotsProfile::IndexFeatures()
+{
+   Debug::ft("PotsProfile.IndexFeatures");
+
    for(auto f = featureq_.First(); f != nullptr; featureq_.Next(f))
    {
-      if(f->Fid() == fid) return f;
+      featureTable_[FeatureRank(features_, f->Fid())] = f;
    }
-
-   return nullptr;
 }
 
 //------------------------------------------------------------------------------
 
-bool PotsProfile::HasFeature(PotsFeature::Id fid) const
+bool PotsProfile::ReserveFeatures(size_t size)
 {
-   Debug::ft("PotsProfile.HasFeature");
+   Debug::ft("PotsProfile.ReserveFeatures");
+
+   if(size <= featureCap_) return true;
+
+   auto table = (PotsFeatureProfile**) Memory::Alloc
+      (size * sizeof(PotsFeatureProfile*), MemProtected, std::nothrow);
+   if(table == nullptr) return false;
+
+   for(size_t i = 0; i < size; ++i)
+   {
+      table[i] = (i < featureCap_ ? featureTable_[i] : nullptr);
+   }
 
-   return (FindFeature(fid) != nullptr);
+   if(featureTable_ != nullptr) Memory::Free(featureTable_, MemProtected);
+   featureTable_ = table;
+   featureCap_ = size;
+   return true;
 }
 
 //------------------------------------------------------------------------------
@@ -293,11 +316,21 @@ bool PotsProfile::Subscribe(PotsFeature::Id fid, CliThread& cli)
    {
       FunctionGuard guard(Guard_MemUnprotect);
 
+      auto size = std::bitset<64>(features_ | FeatureBit(fid)).count();
+
+      if(!ReserveFeatures(size))
+      {
+         *cli.obuf << spaces(2) << AllocationFailed << CRLF;
+         return false;
+      }
+
       auto fp = ftr->Subscribe(*this, cli);
 
       if(fp != nullptr)
       {
          featureq_.Enq(*fp);
+         features_ |= FeatureBit(fid);
+         IndexFeatures();
          return true;
       }
    }
@@ -322,6 +355,8 @@ bool PotsProfile::Unsubscribe(PotsFeature::Id fid)
 
          if(!fp->Unsubscribe(*this)) return false;
          featureq_.Exq(*fp);
+         features_ &= ~FeatureBit(fid);
+         IndexFeatures();
          delete fp;
          return true;
       }
@@ -24,13 +24,14 @@
 
 #include "BcAddress.h"
 #include "Persistent.h"
+#include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include "LocalAddress.h"
 #include "PotsCircuit.h"
 #include "PotsFeature.h"
 #include "Q1Way.h"
-#include "RegCell.h"
 #include "SbTypes.h"
 
 using namespace NodeBase;
@@ -46,7 +47,7 @@ namespace PotsBase
 //
 class PotsProfile : public Address
 {
-   friend class Registry<PotsProfile>;
+   friend class PotsProfileRegistry;
 public:
    //  Profile states.
    //
@@ -73,7 +74,7 @@ public:
 
    //  Returns the profile's DN.
    //
-   DN GetDN() const { return IndexToDN(dn_.GetId()); }
+   DN GetDN() const { return dn_; }
 
    //  Data that changes too frequently to unprotect and reprotect memory
    //  when it needs to be modified.
@@ -143,19 +144,18 @@ public:
    bool Unsubscribe(PotsFeature::Id fid);
 
    //  Returns true if the profile has been assigned the feature
-   //  identified by FID.
+   //  identified by FID.  Uses a bitmap, so it does not search the
+   //  profile's features.
    //
-   bool HasFeature(PotsFeature::Id fid) const;
+   bool HasFeature(PotsFeature::Id fid) const
+      { return ((features_ & FeatureBit(fid)) != 0); }
 
    //  Returns the profile for the feature identified by FID.
-   //  Returns nullptr if that feature is not subscribed.
+   //  Returns nullptr if that feature is not subscribed.  Uses
+   //  the bitmap to index featureTable_ directly.
    //
    PotsFeatureProfile* FindFeature(PotsFeature::Id fid) const;
 
-   //  Returns the offset to dn_.
-   //
-   static ptrdiff_t CellDiff();
-
    //  Overridden to display member variables.
    //
    void Display(std::ostream& stream,
@@ -176,7 +176,7 @@ protected:
 private:
    //  The profile's directory number.
    //
-   RegCell dn_;
+   const DN dn_;
 
    //  The circuit associated with the profile.
    //
@@ -186,6 +186,40 @@ private:
    //
    Q1Way<PotsFeatureProfile> featureq_;
 
+   //  Returns the bit for FID in features_.
+   //
+   static uint64_t FeatureBit(PotsFeature::Id fid)
+      { return (uint64_t(1) << fid); }
+
+   //  Returns the number of features in FEATURES that precede FID, which
+   //  is the position of FID's feature profile in featureTable_.
+   //
+   static size_t FeatureRank(uint64_t features, PotsFeature::Id fid)
+      { return std::bitset<64>(features & (FeatureBit(fid) - 1)).count(); }
+
+   //  Ensures that featureTable_ can hold SIZE entries.  Returns false if
+   //  memory could not be allocated.
+   //
+   bool ReserveFeatures(size_t size);
+
+   //  Rebuilds featureTable_ from featureq_.
+   //
+   void IndexFeatures();
+
+   //  The features in featureq_, as a bitmap indexed by PotsFeature::Id
+   //  (whose MaxId is 63).
+   //
+   uint64_t features_;
+
+   //  The features in featureq_, in order of PotsFeature::Id.  Allocated
+   //  when the first feature is subscribed.
+   //
+   PotsFeatureProfile** featureTable_;
+
+   //  The number of entries that featureTable_ can hold.
+   //
+   size_t featureCap_;
+
    //  Data that changes too frequently to unprotect and reprotect memory
    //  when it needs to be modified.
    //
@@ -20,13 +20,22 @@
 //  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "PotsProfileRegistry.h"
+#include <cctype>
+#include <cstdio>
+#include <istream>
+#include <memory>
+#include <new>
 #include <ostream>
-#include <string>
 #include "Debug.h"
+#include "Element.h"
+#include "FileSystem.h"
 #include "Formatters.h"
+#include "FunctionGuard.h"
+#include "Memory.h"
+#include "NbCliParms.h"
 #include "PotsCircuit.h"
 #include "PotsProfile.h"
-#include "SysTypes.h"
+#include "ThisThread.h"
 
 using std::ostream;
 using std::string;
@@ -35,12 +44,44 @@ using std::string;
 
 namespace PotsBase
 {
-PotsProfileRegistry::PotsProfileRegistry()
+//  Removes the DN at the front of INPUT and returns it.  Returns NilDN if
+//  INPUT does not start with a DN.
+//
+static Address::DN GetDN(string& input)
+{
+   Debug::ft("PotsBase.GetDN");
+
+   size_t i = 0;
+
+   while((i < input.size()) && (input[i] == SPACE)) ++i;
+
+   uint64_t dn = 0;
+   auto start = i;
+
+   while((i < input.size()) && (isdigit(input[i]) != 0))
+   {
+      dn = (dn * 10) + (input[i] - '0');
+      if(dn > UINT32_MAX) return Address::NilDN;
+      ++i;
+   }
+
+   if(i == start) return Address::NilDN;
+   if((i < input.size()) && (input[i] != SPACE)) return Address::NilDN;
+
+   input.erase(0, i);
+   return Address::DN(dn);
+}
+
+//------------------------------------------------------------------------------
+
+PotsProfileRegistry::PotsProfileRegistry() :
+   leavesInUse_(0),
+   pagesInUse_(0),
+   size_(0)
 {
    Debug::ft("PotsProfileRegistry.ctor");
 
-   auto max = Address::LastDN - Address::FirstDN + 1;
-   profiles_.Init(max, PotsProfile::CellDiff(), MemProtected);
+   for(uint32_t i = 0; i < DirSize; ++i) dir_[i] = nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -52,6 +93,35 @@ PotsProfileRegistry::~PotsProfileRegistry()
    Debug::ftnt(PotsProfileRegistry_dtor);
 
    Debug::SwLog(PotsProfileRegistry_dtor, UnexpectedInvocation, 0);
+
+   for(uint32_t i = 0; i < DirSize; ++i)
+   {
+      auto leaf = dir_[i];
+      if(leaf == nullptr) continue;
+
+      for(uint32_t j = 0; j < LeafSize; ++j)
+      {
+         auto page = leaf->pages[j];
+         if(page == nullptr) continue;
+
+         for(uint32_t k = 0; k < PageSize; ++k)
+         {
+            auto profile = page->profiles[k];
+
+            if(profile != nullptr)
+            {
+               page->profiles[k] = nullptr;
+               delete profile;
+            }
+         }
+
+         Memory::Free(page, MemProtected);
+         leaf->pages[j] = nullptr;
+      }
+
+      Memory::Free(leaf, MemProtected);
+      dir_[i] = nullptr;
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -60,7 +130,19 @@ bool PotsProfileRegistry::BindProfile(PotsProfile& profile)
 {
    Debug::ft("PotsProfileRegistry.BindProfile");
 
-   return profiles_.Insert(profile);
+   auto dn = profile.GetDN();
+   if(!IsValidDN(dn)) return false;
+
+   auto page = Page(dn, true);
+   if(page == nullptr) return false;
+
+   auto& slot = page->profiles[dn & (PageSize - 1)];
+   if(slot != nullptr) return false;
+
+   slot = &profile;
+   ++page->count;
+   ++size_;
+   return true;
 }
 
 //------------------------------------------------------------------------------
@@ -70,8 +152,66 @@ void PotsProfileRegistry::Display(ostream& stream,
 {
    Protected::Display(stream, prefix, options);
 
+   stream << prefix << "leavesInUse : " << leavesInUse_ << CRLF;
+   stream << prefix << "pagesInUse  : " << pagesInUse_ << CRLF;
+   stream << prefix << "size        : " << size_ << CRLF;
+
+   if(!options.test(DispVerbose)) return;
+
    stream << prefix << "profiles [Address::DN]" << CRLF;
-   profiles_.Display(stream, prefix + spaces(2), options);
+
+   auto lead1 = prefix + spaces(2);
+   auto lead2 = prefix + spaces(4);
+   auto time = 5;
+
+   for(auto p = FirstAt(1); p != nullptr; p = NextProfile(*p))
+   {
+      stream << lead1 << strIndex(p->GetDN()) << CRLF;
+      p->Display(stream, lead2, NoFlags);
+
+      if(--time <= 0)
+      {
+         ThisThread::PauseOver(90);
+         time = 5;
+      }
+   }
+}
+
+//------------------------------------------------------------------------------
+
+PotsProfile* PotsProfileRegistry::FirstAt(uint64_t dn) const
+{
+   Debug::ft("PotsProfileRegistry.FirstAt");
+
+   //  DN is 64 bits so that it can advance past the last 32-bit DN.  When
+   //  a leaf or page is missing, skip all of the DNs that it would cover.
+   //
+   const auto LeafBits = PageShift + LeafShift;
+
+   while(dn <= UINT32_MAX)
+   {
+      auto leaf = dir_[dn >> LeafBits];
+
+      if(leaf == nullptr)
+      {
+         dn = ((dn >> LeafBits) + 1) << LeafBits;
+         continue;
+      }
+
+      auto page = leaf->pages[(dn >> PageShift) & (LeafSize - 1)];
+
+      if(page != nullptr)
+      {
+         for(auto i = dn & (PageSize - 1); i < PageSize; ++i)
+         {
+            if(page->profiles[i] != nullptr) return page->profiles[i];
+         }
+      }
+
+      dn = ((dn >> PageShift) + 1) << PageShift;
+   }
+
+   return nullptr;
 }
 
 //------------------------------------------------------------------------------
@@ -80,11 +220,54 @@ PotsProfile* PotsProfileRegistry::FirstProfile(Address::DN dn) const
 {
    Debug::ft("PotsProfileRegistry.FirstProfile");
 
-   if(!PotsProfile::IsValidDN(dn)) return nullptr;
+   if(!IsValidDN(dn)) return nullptr;
+   return FirstAt(dn);
+}
 
-   id_t id = Address::DNToIndex(dn);
+//------------------------------------------------------------------------------
+
+word PotsProfileRegistry::LoadProfiles
+   (const string& name, size_t& count, string& expl)
+{
+   Debug::ft("PotsProfileRegistry.LoadProfiles");
 
-   return profiles_.First(id);
+   count = 0;
+
+   auto path = Element::InputPath() + PATH_SEPARATOR + name + ".txt";
+   auto stream = FileSystem::CreateIstream(path.c_str());
+   if(stream == nullptr)
+   {
+      expl = NoFileExpl;
+      return -2;
+   }
+
+   string input;
+   size_t line = 0;
+
+   while(stream->peek() != EOF)
+   {
+      FileSystem::GetLine(*stream, input);
+      ++line;
+
+      if(input.empty() || (input.front() == '/')) continue;
+
+      auto first = GetDN(input);
+      auto last = first;
+
+      if(input.find_first_not_of(SPACE) != string::npos) last = GetDN(input);
+
+      if((first == Address::NilDN) || (last == Address::NilDN) ||
+         (last < first) || (input.find_first_not_of(SPACE) != string::npos))
+      {
+         expl = "Invalid DN or DN range on line " + std::to_string(line);
+         return -1;
+      }
+
+      count += Provision(first, last);
+   }
+
+   expl = SuccessExpl;
+   return 0;
 }
 
 //------------------------------------------------------------------------------
@@ -94,20 +277,91 @@ PotsProfile* PotsProfileRegistry::NextProfile(const PotsProfile& profile) const
    Debug::ft("PotsProfileRegistry.NextProfile");
 
    auto dn = profile.GetDN();
+   if(!IsValidDN(dn)) return nullptr;
+   return FirstAt(uint64_t(dn) + 1);
+}
+
+//------------------------------------------------------------------------------
+
+PotsProfileRegistry::ProfilePage* PotsProfileRegistry::Page
+   (Address::DN dn, bool alloc)
+{
+   Debug::ft("PotsProfileRegistry.Page");
+
+   auto& leaf = dir_[dn >> (PageShift + LeafShift)];
+
+   if(leaf == nullptr)
+   {
+      if(!alloc) return nullptr;
+
+      leaf = (ProfileLeaf*) Memory::Alloc
+         (sizeof(ProfileLeaf), MemProtected, std::nothrow);
+      if(leaf == nullptr) return nullptr;
 
-   if(!PotsProfile::IsValidDN(dn)) return nullptr;
+      for(uint32_t i = 0; i < LeafSize; ++i) leaf->pages[i] = nullptr;
+      ++leavesInUse_;
+   }
+
+   auto& page = leaf->pages[(dn >> PageShift) & (LeafSize - 1)];
+   if((page != nullptr) || !alloc) return page;
 
-   id_t id = Address::DNToIndex(dn);
+   page = (ProfilePage*) Memory::Alloc
+      (sizeof(ProfilePage), MemProtected, std::nothrow);
+   if(page == nullptr) return nullptr;
 
-   return profiles_.Next(id);
+   page->count = 0;
+   for(uint32_t i = 0; i < PageSize; ++i) page->profiles[i] = nullptr;
+   ++pagesInUse_;
+   return page;
 }
 
 //------------------------------------------------------------------------------
 
 PotsProfile* PotsProfileRegistry::Profile(Address::DN dn) const
 {
-   if(!PotsProfile::IsValidDN(dn)) return nullptr;
-   return profiles_.At(Address::DNToIndex(dn));
+   if(!IsValidDN(dn)) return nullptr;
+
+   auto leaf = dir_[dn >> (PageShift + LeafShift)];
+   if(leaf == nullptr) return nullptr;
+
+   auto page = leaf->pages[(dn >> PageShift) & (LeafSize - 1)];
+   if(page == nullptr) return nullptr;
+   return page->profiles[dn & (PageSize - 1)];
+}
+
+//------------------------------------------------------------------------------
+
+size_t PotsProfileRegistry::Provision(Address::DN first, Address::DN last)
+{
+   Debug::ft("PotsProfileRegistry.Provision");
+
+   if(!IsValidDN(first) || !IsValidDN(last)) return 0;
+
+   FunctionGuard guard(Guard_MemUnprotect);
+   size_t count = 0;
+
+   for(auto dn = first; true; ++dn)
+   {
+      if(Profile(dn) == nullptr)
+      {
+         //  If the profile could not be registered, memory is exhausted.
+         //
+         auto profile = new PotsProfile(dn);
+
+         if(Profile(dn) != profile)
+         {
+            profile->Deregister();
+            return count;
+         }
+
+         ++count;
+      }
+
+      if(dn == last) break;
+      if((dn & 0xff) == 0) ThisThread::PauseOver(90);
+   }
+
+   return count;
 }
 
 //------------------------------------------------------------------------------
@@ -118,9 +372,22 @@ void PotsProfileRegistry::Shutdown(RestartLevel level)
 
    PotsCircuit::ResetStateCounts(level);
 
-   for(auto p = profiles_.Last(); p != nullptr; profiles_.Prev(p))
+   for(auto i = DirSize; i > 0; --i)
    {
-      p->Shutdown(level);
+      auto leaf = dir_[i - 1];
+      if(leaf == nullptr) continue;
+
+      for(auto j = LeafSize; j > 0; --j)
+      {
+         auto page = leaf->pages[j - 1];
+         if(page == nullptr) continue;
+
+         for(auto k = PageSize; k > 0; --k)
+         {
+            auto profile = page->profiles[k - 1];
+            if(profile != nullptr) profile->Shutdown(level);
+         }
+      }
    }
 }
 
@@ -130,7 +397,7 @@ void PotsProfileRegistry::Startup(RestartLevel level)
 {
    Debug::ft("PotsProfileRegistry.Startup");
 
-   for(auto p = profiles_.First(); p != nullptr; profiles_.Next(p))
+   for(auto p = FirstAt(1); p != nullptr; p = NextProfile(*p))
    {
       p->Startup(level);
    }
@@ -142,6 +409,26 @@ void PotsProfileRegistry::UnbindProfile(PotsProfile& profile)
 {
    Debug::ftnt("PotsProfileRegistry.UnbindProfile");
 
-   profiles_.Erase(profile);
+   auto dn = profile.GetDN();
+   if(!IsValidDN(dn)) return;
+
+   auto page = Page(dn, false);
+   if(page == nullptr) return;
+
+   auto& slot = page->profiles[dn & (PageSize - 1)];
+   if(slot != &profile) return;
+
+   slot = nullptr;
+   --size_;
+
+   //  Free the page when it becomes empty.  A leaf is kept once allocated.
+   //
+   if(--page->count == 0)
+   {
+      dir_[dn >> (PageShift + LeafShift)]->pages
+         [(dn >> PageShift) & (LeafSize - 1)] = nullptr;
+      Memory::Free(page, MemProtected);
+      --pagesInUse_;
+   }
 }
 }
@@ -23,9 +23,12 @@
 #define POTSPROFILEREGISTRY_H_INCLUDED
 
 #include "Protected.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include "BcAddress.h"
 #include "NbTypes.h"
-#include "Registry.h"
+#include "SysTypes.h"
 
 namespace PotsBase
 {
@@ -39,7 +42,13 @@ using namespace CallBase;
 
 namespace PotsBase
 {
-//  Registry for POTS profiles.
+//  Registry for POTS profiles.  Profiles are found by DN, using a two-level
+//  directory of pages that each hold the profiles for PageSize consecutive
+//  DNs.  The directory covers every value of Address::DN, not just those in
+//  the numbering plan.  A page, and the part of the directory that finds it,
+//  is only allocated when one of its DNs is registered, so the memory used
+//  by the registry grows with the number of profiles rather than with the
+//  range of DNs.
 //
 class PotsProfileRegistry : public Protected
 {
@@ -67,6 +76,26 @@ public:
    //
    PotsProfile* NextProfile(const PotsProfile& profile) const;
 
+   //  Returns the number of registered profiles.
+   //
+   size_t Size() const { return size_; }
+
+   //  Registers a profile for each DN from FIRST to LAST that does not yet
+   //  have one.  Returns the number of profiles that were created, which
+   //  is less than requested if memory is exhausted.  A DN outside the
+   //  numbering plan (see Address::IsValidDN) can be registered, but it
+   //  cannot be dialed.
+   //
+   size_t Provision(Address::DN first, Address::DN last);
+
+   //  Registers the DNs listed in the file NAME.txt in the input directory.
+   //  Each line contains a DN or a range of DNs ("<first> <last>"), and a
+   //  line that starts with '/' is a comment.  Returns 0 on success, else
+   //  updates EXPL with an explanation of the error.  In both cases, COUNT
+   //  is updated to the number of profiles that were created.
+   //
+   word LoadProfiles(const std::string& name, size_t& count, std::string& expl);
+
    //  Overridden to display member variables.
    //
    void Display(std::ostream& stream,
@@ -96,9 +125,78 @@ private:
    //
    void UnbindProfile(PotsProfile& profile);
 
-   //  The registry of POTS profiles.
+   //  log2(PageSize).
+   //
+   static const uint32_t PageShift = 10;
+
+   //  The number of profiles in a page.
+   //
+   static const uint32_t PageSize = 1 << PageShift;
+
+   //  log2(LeafSize).
+   //
+   static const uint32_t LeafShift = 11;
+
+   //  The number of pages in a leaf of the directory.
+   //
+   static const uint32_t LeafSize = 1 << LeafShift;
+
+   //  The number of leaves in the directory, which covers all 32-bit DNs.
+   //
+   static const uint32_t DirSize = 1 << (32 - PageShift - LeafShift);
+
+   //  The profiles for PageSize consecutive DNs.
+   //
+   struct ProfilePage
+   {
+      //  The number of profiles in the page.
+      //
+      uint32_t count;
+
+      //  The profiles, indexed by the low-order bits of a DN.
+      //
+      PotsProfile* profiles[PageSize];
+   };
+
+   //  A leaf of the directory, which finds the pages for LeafSize * PageSize
+   //  consecutive DNs.
+   //
+   struct ProfileLeaf
+   {
+      //  The pages, indexed by the middle bits of a DN.
+      //
+      ProfilePage* pages[LeafSize];
+   };
+
+   //  Returns true if DN can be registered.
+   //
+   static bool IsValidDN(Address::DN dn) { return (dn != Address::NilDN); }
+
+   //  Returns the page for DN.  If the page does not exist, it is allocated
+   //  if ALLOC is set, else nullptr is returned.  Also returns nullptr if
+   //  memory for the page could not be allocated.
+   //
+   ProfilePage* Page(Address::DN dn, bool alloc);
+
+   //  Returns the profile for the first registered DN at or after DN.
+   //
+   PotsProfile* FirstAt(uint64_t dn) const;
+
+   //  The directory's leaves, indexed by the high-order bits of a DN.
+   //
+   ProfileLeaf* dir_[DirSize];
+
+   //  The number of leaves that are currently allocated.
+   //
+   uint32_t leavesInUse_;
+
+   //  The number of pages that are currently allocated.
+   //
+   uint32_t pagesInUse_;
+
+   //  The number of registered profiles.
    //
-   Registry<PotsProfile> profiles_;
+   size_t size_;
 };
 }
 #endif
@@ -37,7 +37,7 @@ RnModule::RnModule() : Module("rn")
 
    //  Create the modules required by RoutingNode.
    //
-   Singleton<CbModule>::Instance();
+   Requires(*Singleton<CbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
@@ -637,9 +637,12 @@ bool Context::ProcessMsg(Q1Way<Message>& msgq, const InvokerThread* inv)
       return true;
    }
 
-   //  Tell the context to process the current message.
+   //  Tell the context to process the current message, and record how
+   //  long this took.
    //
+   auto start = SteadyTime::Now();
    ProcessIcMsg(*msg);
+   pool_->RecordTransaction(SteadyTime::Now() - start);
 
    //  If the message is still at the head of the queue, delete it
    //  (this has the side effect of clearing the context message).
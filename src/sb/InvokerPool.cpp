@@ -117,6 +117,7 @@ public:
    InvokerPoolStats& operator=(const InvokerPoolStats& that) = delete;
 
    HighWatermarkPtr maxTrans_;
+   HistogramPtr     transTimes_;
    CounterPtr       requeues_;
    CounterPtr       trojans_;
    CounterPtr       lockouts_;
@@ -129,6 +130,7 @@ InvokerPoolStats::InvokerPoolStats()
    Debug::ft("InvokerPoolStats.ctor");
 
    maxTrans_.reset(new HighWatermark("most transactions before yielding"));
+   transTimes_.reset(new Histogram("transaction times in usecs", NS_TO_US));
    requeues_.reset(new Counter("contexts requeued after priority work"));
    trojans_.reset(new Counter("corrupt contexts found on work queue"));
    lockouts_.reset(new Counter("times that all invokers were blocked"));
@@ -187,6 +189,10 @@ public:
    //  The longest time that a context was queued.
    //
    HighWatermarkPtr maxDelay_;
+
+   //  The distribution of the times that contexts were queued.
+   //
+   HistogramPtr delays_;
 };
 
 //------------------------------------------------------------------------------
@@ -200,6 +206,7 @@ InvokerWork::InvokerWork() : length_(0)
    dequeues_.reset(new Counter("contexts dequeued"));
    maxLength_.reset(new HighWatermark("longest length of work queue"));
    maxDelay_.reset(new HighWatermark("longest queue delay in msecs", NS_TO_MS));
+   delays_.reset(new Histogram("queue delays in usecs", NS_TO_US));
 }
 
 //------------------------------------------------------------------------------
@@ -348,14 +355,9 @@ void InvokerPool::Dequeued(MsgPriority prio) const
       return;
    }
 
-   auto log = Log::Create(SessionLogGroup, InvokerWorkQueueCount);
-
-   if(log != nullptr)
-   {
-      *log << Log::Tab << "pool=" << int(GetFaction());
-      *log << " queue=" << prio << " [underflow]";
-      Log::Submit(log);
-   }
+   LogArg args[] = { LogArg("pool", GetFaction()), LogArg("queue", prio),
+      LogArg::Str(nullptr, "[underflow]") };
+   Log::Post(SessionLogGroup, InvokerWorkQueueCount, args, 3);
 
    work->length_ = work->contextq_.Size();
 }
@@ -401,10 +403,12 @@ void InvokerPool::DisplayStats(ostream& stream, const Flags& options) const
       work->dequeues_->DisplayStat(stream, options);
       work->maxLength_->DisplayStat(stream, options);
       work->maxDelay_->DisplayStat(stream, options);
+      work->delays_->DisplayStat(stream, options);
    }
 
    stream << spaces(4) << "pool statistics:" << CRLF;
    stats_->maxTrans_->DisplayStat(stream, options);
+   stats_->transTimes_->DisplayStat(stream, options);
    stats_->requeues_->DisplayStat(stream, options);
    stats_->trojans_->DisplayStat(stream, options);
    stats_->lockouts_->DisplayStat(stream, options);
@@ -442,14 +446,9 @@ Context* InvokerPool::FindWork()
       }
       else if(work->length_ > 0)
       {
-         auto log = Log::Create(SessionLogGroup, InvokerWorkQueueCount);
-
-         if(log != nullptr)
-         {
-            *log << Log::Tab << "pool=" << int(GetFaction());
-            *log << " queue=" << prio << " [zeroed]";
-            Log::Submit(log);
-         }
+         LogArg args[] = { LogArg("pool", GetFaction()),
+            LogArg("queue", prio), LogArg::Str(nullptr, "[zeroed]") };
+         Log::Post(SessionLogGroup, InvokerWorkQueueCount, args, 3);
 
          work->length_ = 0;
       }
@@ -483,10 +482,8 @@ void InvokerPool::KickThread()
    //
    if(Restart::GetStage() == Running)
    {
-      auto log = Log::Create(SessionLogGroup, InvokerPoolBlocked);
-      if(log == nullptr) return;
-      *log << Log::Tab << "pool=" << int(GetFaction());
-      Log::Submit(log);
+      LogArg args[] = { LogArg("pool", GetFaction()) };
+      Log::Post(SessionLogGroup, InvokerPoolBlocked, args, 1);
    }
 }
 
@@ -736,7 +733,16 @@ bool InvokerPool::ReceiveMsg(Message& msg, bool atIoLevel)
 
 void InvokerPool::RecordDelay(MsgPriority prio, const nsecs_t& delay) const
 {
-   work_[prio]->maxDelay_->Update(delay.count());
+   auto work = work_[prio].get();
+   work->maxDelay_->Update(delay.count());
+   work->delays_->Record(delay.count());
+}
+
+//------------------------------------------------------------------------------
+
+void InvokerPool::RecordTransaction(const nsecs_t& time) const
+{
+   stats_->transTimes_->Record(time.count());
 }
 
 //------------------------------------------------------------------------------
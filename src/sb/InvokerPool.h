@@ -126,6 +126,10 @@ protected:
    //
    virtual void RecordDelay
       (MsgPriority prio, const NodeBase::nsecs_t& delay) const;
+
+   //  Records the TIME that a context spent processing a message.
+   //
+   void RecordTransaction(const NodeBase::nsecs_t& time) const;
 private:
    //  Adds THREAD to the set of invokers.
    //
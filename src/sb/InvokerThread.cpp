@@ -34,6 +34,7 @@
 #include "Singleton.h"
 #include "ToolTypes.h"
 
+using namespace NetworkBase;
 using namespace NodeBase;
 using std::ostream;
 using std::string;
@@ -107,6 +108,10 @@ bool InvokerThread::BlockingAllowed(BlockingReason why, fn_name_arg func)
       return false;
    }
 
+   //  Don't hold outgoing messages while blocked.
+   //
+   batch_.Flush();
+
    msg_ = Context::ContextMsg();
    Context::SetContextMsg(nullptr);
    pool_->ScheduledOut();
@@ -137,6 +142,7 @@ void InvokerThread::ClearContext()
 {
    Debug::ft("InvokerThread.ClearContext");
 
+   batch_.Flush();
    ctx_.release();
 }
 
@@ -151,6 +157,7 @@ void InvokerThread::Display(ostream& stream,
    stream << prefix << "ctx   : " << ctx_.get() << CRLF;
    stream << prefix << "msg   : " << msg_ << CRLF;
    stream << prefix << "trans : " << trans_ << CRLF;
+   stream << prefix << "batch : " << batch_.Count() << CRLF;
 }
 
 //------------------------------------------------------------------------------
@@ -193,6 +200,10 @@ bool InvokerThread::Recover()
       return false;
    }
 
+   //  Discard any messages that the failed transaction was sending.
+   //
+   batch_.Purge();
+
    if(ctx_ != nullptr)
    {
       ctx_->Dump();
@@ -217,6 +228,20 @@ bool InvokerThread::Recover()
 
 //------------------------------------------------------------------------------
 
+UdpSendBatch* InvokerThread::RunningBatch()
+{
+   Debug::ft("InvokerThread.RunningBatch");
+
+   auto ctx = Context::RunningContext();
+   if(ctx == nullptr) return nullptr;
+
+   auto inv = ctx->thread_;
+   if(inv == nullptr) return nullptr;
+   return &inv->batch_;
+}
+
+//------------------------------------------------------------------------------
+
 void InvokerThread::ScheduledIn(fn_name_arg func)
 {
    Debug::ft("InvokerThread.ScheduledIn");
@@ -258,6 +283,7 @@ void InvokerThread::Shutdown(RestartLevel level)
    //
    if(level == RestartNone) return;
 
+   batch_.Purge();
    Restart::Release(ctx_);
    if(ctx_ == nullptr) return;
 
@@ -31,6 +31,7 @@
 #include "SbTypes.h"
 #include "SteadyTime.h"
 #include "SysTypes.h"
+#include "UdpSendBatch.h"
 
 //------------------------------------------------------------------------------
 
@@ -56,6 +57,12 @@ public:
    //
    static NodeBase::word RtcYieldPercent() { return RtcYieldPercent_; }
 
+   //  Returns the batch that holds the running invoker's outgoing UDP
+   //  messages until its current transaction ends.  Returns nullptr if
+   //  an invoker is not running.
+   //
+   static NetworkBase::UdpSendBatch* RunningBatch();
+
    //  Returns the time when the current transaction started.
    //
    NodeBase::SteadyTime::Point Time0() const { return time0_; }
@@ -83,7 +90,8 @@ private:
    //
    void SetContext(Context* ctx);
 
-   //  Clears the context after a transaction is completed.
+   //  Clears the context after a transaction is completed, after sending
+   //  any UDP messages that it left in batch_.
    //
    void ClearContext();
 
@@ -152,6 +160,10 @@ private:
    //
    NodeBase::SteadyTime::Point time0_;
 
+   //  The UDP messages sent during the current transaction.
+   //
+   NetworkBase::UdpSendBatch batch_;
+
    //  Percentage of run-to-completion timeout that must remain for invoker
    //  to begin another transaction instead of yielding.
    //
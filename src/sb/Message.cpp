@@ -30,6 +30,7 @@
 #include "GlobalAddress.h"
 #include "InvokerPool.h"
 #include "InvokerPoolRegistry.h"
+#include "InvokerThread.h"
 #include "IpPortRegistry.h"
 #include "LocalAddress.h"
 #include "MsgHeader.h"
@@ -46,6 +47,7 @@
 #include "SteadyTime.h"
 #include "ToolTypes.h"
 #include "TraceBuffer.h"
+#include "UdpSendBatch.h"
 
 using namespace NetworkBase;
 using namespace NodeBase;
@@ -60,6 +62,7 @@ Message::Message(SbIpBufferPtr& buff) :
    buff_(buff.release()),
    bt_(nullptr),
    handled_(false),
+   deferred_(false),
    saves_(0),
    psm_(nullptr),
    whichq_(nullptr)
@@ -73,6 +76,7 @@ Message::Message(ProtocolSM* psm, size_t size) :
    buff_(nullptr),
    bt_(nullptr),
    handled_(false),
+   deferred_(false),
    saves_(0),
    psm_(psm),
    whichq_(nullptr)
@@ -138,6 +142,15 @@ Message::~Message()
    //
    Exqueue();
    ClearContext();
+
+   //  If the message's buffer was deferred when the message was sent, the
+   //  running invoker's batch now takes it over and will send it.
+   //
+   if(deferred_)
+   {
+      auto batch = InvokerThread::RunningBatch();
+      if(batch != nullptr) batch->Add(buff_.release());
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -246,12 +259,13 @@ void Message::Display(ostream& stream,
 {
    Pooled::Display(stream, prefix, options);
 
-   stream << prefix << "buff    : " << buff_.get() << CRLF;
-   stream << prefix << "bt      : " << bt_ << CRLF;
-   stream << prefix << "handled : " << handled_ << CRLF;
-   stream << prefix << "saves   : " << int(saves_) << CRLF;
-   stream << prefix << "psm     : " << psm_ << CRLF;
-   stream << prefix << "whichq  : " << whichq_ << CRLF;
+   stream << prefix << "buff     : " << buff_.get() << CRLF;
+   stream << prefix << "bt       : " << bt_ << CRLF;
+   stream << prefix << "handled  : " << handled_ << CRLF;
+   stream << prefix << "deferred : " << deferred_ << CRLF;
+   stream << prefix << "saves    : " << int(saves_) << CRLF;
+   stream << prefix << "psm      : " << psm_ << CRLF;
+   stream << prefix << "whichq   : " << whichq_ << CRLF;
 }
 
 //------------------------------------------------------------------------------
@@ -764,10 +778,20 @@ bool Message::Send(Route route)
    //  has been saved, clone and deliver its buffer so that the sender will
    //  still be able to access the original message.
    //    If the receiver is not located on this processor, send the message
-   //  via the IP stack.
+   //  via the IP stack.  If the message uses UDP, is being sent by an
+   //  invoker thread, and has not been saved, its buffer is held until the
+   //  end of the transaction so that it can be sent together with other
+   //  messages on the same socket.  The buffer is passed to the invoker's
+   //  batch when the message is deleted, below.  Any other message is sent
+   //  after flushing the batch, so that it cannot overtake messages that
+   //  were sent earlier.
    //
+   auto batch = InvokerThread::RunningBatch();
+
    if(local)
    {
+      if(batch != nullptr) batch->Flush();
+
       auto fac = facreg->Factories().At(header->rxAddr.fid);
 
       if(fac == nullptr)
@@ -803,7 +827,18 @@ bool Message::Send(Route route)
    {
       if(route == Internal) route = IpStack;
       header->route = route;
-      sent = buff_->Send(route == External);
+
+      if((batch != nullptr) && (saves_ == 0) &&
+         buff_->Defer(route == External))
+      {
+         deferred_ = true;
+         sent = true;
+      }
+      else
+      {
+         if(batch != nullptr) batch->Flush();
+         sent = buff_->Send(route == External);
+      }
    }
 
    //  If the message was successfully sent, then
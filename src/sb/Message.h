@@ -385,6 +385,11 @@ private:
    //
    bool handled_;
 
+   //  Set if the message's buffer is to be added to the running invoker's
+   //  UdpSendBatch when the message is deleted.
+   //
+   bool deferred_;
+
    //  The net number of requests to save the message.
    //
    uint8_t saves_;
@@ -589,6 +589,16 @@ void ProtocolSM::SetState(StateId stid)
 fn_name ProtocolSM_StartTimer = "ProtocolSM.StartTimer";
 
 bool ProtocolSM::StartTimer(int secs, Base& owner, TimerId tid, bool repeat)
+{
+   Debug::ft("ProtocolSM.StartTimer(secs)");
+
+   return StartTimer(msecs_t(int64_t(secs) * SECS_TO_MS), owner, tid, repeat);
+}
+
+//------------------------------------------------------------------------------
+
+bool ProtocolSM::StartTimer
+   (const msecs_t& msecs, Base& owner, TimerId tid, bool repeat)
 {
    Debug::ft(ProtocolSM_StartTimer);
 
@@ -601,7 +611,13 @@ bool ProtocolSM::StartTimer(int secs, Base& owner, TimerId tid, bool repeat)
       return false;
    }
 
-   new Timer(*this, owner, tid, secs, repeat);
+   //  Timers are limited to UINT32_MAX msecs (over 49 days).
+   //
+   auto count = msecs.count();
+   if(count < 0) count = 0;
+   if(count > UINT32_MAX) count = UINT32_MAX;
+
+   new Timer(*this, owner, tid, count, repeat);
    return true;
 }
 
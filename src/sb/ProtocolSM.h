@@ -25,6 +25,7 @@
 #include "ProtocolLayer.h"
 #include <cstddef>
 #include <cstdint>
+#include "Duration.h"
 #include "Message.h"
 #include "Q1Way.h"
 #include "SbTypes.h"
@@ -100,7 +101,7 @@ public:
       Timeout            // expected message not received
    };
 
-   //  Starts a timer that expires after SECS +/- 0.5 seconds.  If the timer
+   //  Starts a timer that expires after SECS seconds.  If the timer
    //  expires, the PSM receives a message with a signal of Signal::Timeout,
    //  followed by a parameter that contains OWNER and TID, which are echoed
    //  so that the application that started the timer can identify it (using
@@ -111,6 +112,12 @@ public:
    //
    bool StartTimer(int secs, Base& owner, TimerId tid, bool repeat = false);
 
+   //  The same as the above, but for a timer that expires after MSECS,
+   //  which is rounded up to the timewheel's tick (TimerRegistry::TickMsecs).
+   //
+   bool StartTimer(const NodeBase::msecs_t& msecs,
+      Base& owner, TimerId tid, bool repeat = false);
+
    //  Stops the timer identified by OWNER and TID.
    //
    void StopTimer(const Base& owner, TimerId tid);
@@ -50,7 +50,7 @@ SbModule::SbModule() : Module()
 
    //  Create the modules required by SessionBase.
    //
-   Singleton<NwModule>::Instance();
+   Requires(*Singleton<NwModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
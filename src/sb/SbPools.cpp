@@ -571,6 +571,10 @@ TimerPool::TimerPool() :
    Debug::ft("TimerPool.ctor");
 
    timeouts_.reset(new Counter("timeout messages sent"));
+   ticks_.reset(new Counter("timewheel ticks serviced"));
+   cascades_.reset(new Accumulator("timers cascaded in timewheel"));
+   maxCascades_.reset(new HighWatermark("most timers cascaded in one tick"));
+   lateness_.reset(new Histogram("timer lateness in usecs", NS_TO_US));
 }
 
 //------------------------------------------------------------------------------
@@ -598,6 +602,10 @@ void TimerPool::DisplayStats(ostream& stream, const Flags& options) const
    ObjectPool::DisplayStats(stream, options);
 
    timeouts_->DisplayStat(stream, options);
+   ticks_->DisplayStat(stream, options);
+   cascades_->DisplayStat(stream, options);
+   maxCascades_->DisplayStat(stream, options);
+   lateness_->DisplayStat(stream, options);
 }
 
 //------------------------------------------------------------------------------
@@ -616,12 +624,36 @@ void TimerPool::Patch(sel_t selector, void* arguments)
 
 //------------------------------------------------------------------------------
 
+void TimerPool::RecordLateness(const nsecs_t& late) const
+{
+   lateness_->Record(late.count() > 0 ? late.count() : 0);
+}
+
+//------------------------------------------------------------------------------
+
+void TimerPool::RecordTick(size_t count) const
+{
+   ticks_->Incr();
+
+   if(count > 0)
+   {
+      cascades_->Add(count);
+      maxCascades_->Update(count);
+   }
+}
+
+//------------------------------------------------------------------------------
+
 void TimerPool::Shutdown(RestartLevel level)
 {
    Debug::ft("TimerPool.Shutdown");
 
    FunctionGuard guard(Guard_MemUnprotect);
    Restart::Release(timeouts_);
+   Restart::Release(ticks_);
+   Restart::Release(cascades_);
+   Restart::Release(maxCascades_);
+   Restart::Release(lateness_);
 
    ObjectPool::Shutdown(level);
 }
@@ -638,6 +670,11 @@ void TimerPool::Startup(RestartLevel level)
    {
       FunctionGuard guard(Guard_MemUnprotect);
       timeouts_.reset(new Counter("timeout messages sent"));
+      ticks_.reset(new Counter("timewheel ticks serviced"));
+      cascades_.reset(new Accumulator("timers cascaded in timewheel"));
+      maxCascades_.reset
+         (new HighWatermark("most timers cascaded in one tick"));
+      lateness_.reset(new Histogram("timer lateness in usecs", NS_TO_US));
    }
 }
 
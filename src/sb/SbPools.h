@@ -23,6 +23,7 @@
 #define SBPOOLS_H_INCLUDED
 
 #include "ObjectPool.h"
+#include "Duration.h"
 #include "NbTypes.h"
 
 namespace SessionBase
@@ -188,6 +189,16 @@ public:
    //
    void IncrTimeouts() const;
 
+   //  Records that a timewheel tick was serviced, during which COUNT timers
+   //  were cascaded to lower levels of the timewheel.
+   //
+   void RecordTick(size_t count) const;
+
+   //  Records that a timer expired LATE after the time when its timeout
+   //  was due.
+   //
+   void RecordLateness(const NodeBase::nsecs_t& late) const;
+
    //  Overridden to claim blocks in the TimerRegistry.
    //
    void ClaimBlocks() override;
@@ -224,6 +235,22 @@ private:
    //  The number of timeouts sent.
    //
    NodeBase::CounterPtr timeouts_;
+
+   //  The number of timewheel ticks serviced.
+   //
+   NodeBase::CounterPtr ticks_;
+
+   //  The number of timers cascaded to lower levels of the timewheel.
+   //
+   NodeBase::AccumulatorPtr cascades_;
+
+   //  The most timers cascaded during a single tick.
+   //
+   NodeBase::HighWatermarkPtr maxCascades_;
+
+   //  The distribution of how late timers were in expiring.
+   //
+   NodeBase::HistogramPtr lateness_;
 };
 
 //------------------------------------------------------------------------------
@@ -720,7 +720,7 @@ c_string MsgTrace::EventString() const
 TimerTrace::TimerTrace(Id rid, const Timer& tmr) :
    SboTrace(tmr),
    tid_(tmr.Tid()),
-   secs_(tmr.secs_),
+   msecs_(tmr.msecs_),
    psm_(tmr.Psm())
 {
    rid_ = rid;
@@ -733,7 +733,7 @@ bool TimerTrace::Display(ostream& stream, const string& opts)
    if(!SboTrace::Display(stream, opts)) return false;
 
    stream << OutputId("id=", tid_);
-   stream << "secs=" << secs_ << " psm=" << psm_;
+   stream << "msecs=" << msecs_ << " psm=" << psm_;
    return true;
 }
 
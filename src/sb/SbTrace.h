@@ -432,9 +432,9 @@ private:
    //
    const TimerId tid_;
 
-   //  The timer's duration.
+   //  The timer's duration, in milliseconds.
    //
-   const uint32_t secs_;
+   const uint32_t msecs_;
 
    //  The PSM associated with the timer.
    //
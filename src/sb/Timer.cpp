@@ -53,20 +53,18 @@ using std::string;
 namespace SessionBase
 {
 Timer::Timer
-   (ProtocolSM& psm, Base& owner, TimerId tid, uint32_t secs, bool repeat) :
+   (ProtocolSM& psm, Base& owner, TimerId tid, uint32_t msecs, bool repeat) :
    psm_(&psm),
    owner_(&owner),
    tid_(tid),
    repeat_(repeat),
    qid_(NilQId),
-   secs_(secs),
-   remaining_(secs)
+   msecs_(msecs),
+   expiry_(0)
 {
    Debug::ft("Timer.ctor");
 
-   auto reg = Singleton<TimerRegistry>::Instance();
-   qid_ = reg->CalcQId(secs_);
-   reg->timerq_[qid_].Henq(*this);
+   Singleton<TimerRegistry>::Instance()->Register(*this);
    psm_->timerq_.Henq(*this);
 
    //  Record the timer's creation if this context is traced.
@@ -158,8 +156,8 @@ void Timer::Display(ostream& stream,
    stream << prefix << "qid       : " << qid_ << CRLF;
    stream << prefix << "link      : " << CRLF;
    link_.Display(stream, prefix + spaces(2));
-   stream << prefix << "secs      : " << secs_ << CRLF;
-   stream << prefix << "remaining : " << remaining_ << CRLF;
+   stream << prefix << "msecs     : " << msecs_ << CRLF;
+   stream << prefix << "expiry    : " << expiry_ << CRLF;
 }
 
 //------------------------------------------------------------------------------
@@ -218,27 +216,11 @@ void Timer::Restart()
 {
    Debug::ft("Timer.Restart");
 
-   auto reg = Singleton<TimerRegistry>::Instance();
-
-   if(qid_ < MaxQId)
-   {
-      //  Move this timer to the queue that will be reached in secs_
-      //  seconds.
-      //
-      auto secs = (secs_ == 0 ? 1 : secs_);
-      auto nextq = reg->CalcQId(secs);
-      Deregister();
-
-      qid_ = nextq;
-      reg->timerq_[qid_].Henq(*this);
-   }
-   else
-   {
-      //  This timer is MaxQId seconds or more, so it never moves.
-      //  Just reset its countdown value.
-      //
-      remaining_ = secs_;
-   }
+   //  Move this timer to the timewheel slot that will be reached
+   //  msecs_ after it last expired.
+   //
+   Deregister();
+   Singleton<TimerRegistry>::Instance()->Reregister(*this);
 }
 
 //------------------------------------------------------------------------------
@@ -65,10 +65,11 @@ public:
    void Patch(sel_t selector, void* arguments) override;
 private:
    //  Starts a timer on PSM, owned by OWNER, identified by TID, that will
-   //  expire in SECS, and repeatedly if REPEAT is true.  Private because
+   //  expire in MSECS, and repeatedly if REPEAT is true.  Private because
    //  applications create timers via ProtocolSM::StartTimer.
    //
-   Timer(ProtocolSM& psm, Base& owner, TimerId tid, uint32_t secs, bool repeat);
+   Timer(ProtocolSM& psm,
+      Base& owner, TimerId tid, uint32_t msecs, bool repeat);
 
    //  Private because applications delete timers via ProtocolSM::StopTimer.
    //  Not subclassed.
@@ -117,13 +118,6 @@ private:
    //
    static const QId NilQId = -1;
 
-   //  Maximum timer queue identifier (3600 seconds = 1 hour).  The first
-   //  3601 slots in the timewheel are for timers expiring in 0 to 3600
-   //  seconds, and the final slot is for long duration timers (over 3600
-   //  seconds).
-   //
-   static const QId MaxQId = 3601;
-
    //  The PSM on which the timer is running.
    //
    ProtocolSM* psm_;
@@ -136,7 +130,7 @@ private:
    //
    TimerId tid_;
 
-   //  Set if the timer should repeatedly expire every duration_ seconds.
+   //  Set if the timer should repeatedly expire every msecs_ milliseconds.
    //
    const bool repeat_;
 
@@ -148,13 +142,13 @@ private:
    //
    NodeBase::Q2Link link_;
 
-   //  The length of the timer in seconds.
+   //  The length of the timer in milliseconds.
    //
-   const uint32_t secs_;
+   const uint32_t msecs_;
 
-   //  How long until the timer expires (only used for long timers).
+   //  The timewheel tick at which the timer expires.
    //
-   uint32_t remaining_;
+   uint64_t expiry_;
 };
 }
 #endif
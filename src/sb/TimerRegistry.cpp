@@ -29,8 +29,10 @@
 #include "Restart.h"
 #include "SbPools.h"
 #include "Singleton.h"
+#include "SteadyTime.h"
 #include "SysTypes.h"
 #include "ThisThread.h"
+#include "Thread.h"
 #include "TimerThread.h"
 
 using namespace NodeBase;
@@ -41,14 +43,22 @@ using std::string;
 
 namespace SessionBase
 {
+const Timer::QId TimerRegistry::Slots[Levels] = { 100, 60, 60, 24 };
+const uint64_t TimerRegistry::Ticks[Levels] = { 1, 100, 6000, 360000 };
+const Timer::QId TimerRegistry::FirstQId[Levels] = { 0, 100, 160, 220 };
+
+//------------------------------------------------------------------------------
+
 TimerRegistry::TimerRegistry() :
-   nextQid_(0),
+   nextTick_(CurrTick()),
+   wakeTick_(nextTick_),
+   servicing_(false),
    currTimer_(nullptr),
    corrupt_(false)
 {
    Debug::ft("TimerRegistry.ctor");
 
-   for(auto i = 0; i <= Timer::MaxQId; ++i)
+   for(auto i = 0; i <= OverflowQId; ++i)
    {
       timerq_[i].Init(Timer::LinkDiff());
    }
@@ -64,7 +74,7 @@ TimerRegistry::~TimerRegistry()
 
    Debug::SwLog(TimerRegistry_dtor, UnexpectedInvocation, 0);
 
-   for(auto i = 0; i <= Timer::MaxQId; ++i)
+   for(auto i = 0; i <= OverflowQId; ++i)
    {
       timerq_[i].Purge();
       ThisThread::PauseOver(95);
@@ -73,25 +83,26 @@ TimerRegistry::~TimerRegistry()
 
 //------------------------------------------------------------------------------
 
-Timer::QId TimerRegistry::CalcQId(uint32_t secs) const
+size_t TimerRegistry::Cascade(Timer::QId qid)
 {
-   Debug::ft("TimerRegistry.CalcQId");
+   Debug::ft("TimerRegistry.Cascade");
 
-   //  The timer thread wakes up ~1000 msecs after it last began to run.
-   //  If it last began to run over 500 msecs ago, the next timer queue
-   //  will be served in less than half a second, so increment SECS.
+   //  A timer that is reinserted can return to the overflow queue, so stop
+   //  after moving the timer that was originally last.
    //
-   auto thr = Singleton<TimerThread>::Instance();
-   auto incr = (thr->CurrTimeRunning().count() >= 500 ? 1 : 0);
+   auto tq = &timerq_[qid];
+   auto last = tq->Last();
+   size_t count = 0;
 
-   secs += incr;
-   if(secs >= Timer::MaxQId) return Timer::MaxQId;
-
-   auto qid = nextQid_ + secs - 1;
-
-   if(qid >= Timer::MaxQId) qid = qid - Timer::MaxQId;
+   for(Timer* curr = tq->First(), *next; curr != nullptr; curr = next)
+   {
+      next = (curr == last ? nullptr : tq->Next(*curr));
+      tq->Exq(*curr);
+      Insert(*curr);
+      ++count;
+   }
 
-   return qid;
+   return count;
 }
 
 //------------------------------------------------------------------------------
@@ -112,7 +123,7 @@ void TimerRegistry::ClaimBlocks()
 
    corrupt_ = true;
 
-   for(auto i = 0; i <= Timer::MaxQId; ++i)
+   for(auto i = 0; i <= OverflowQId; ++i)
    {
       for(auto t = timerq_[i].First(); t != nullptr; timerq_[i].Next(t));
    }
@@ -122,41 +133,79 @@ void TimerRegistry::ClaimBlocks()
 
 //------------------------------------------------------------------------------
 
+uint64_t TimerRegistry::CurrTick()
+{
+   nsecs_t elapsed = SteadyTime::Now() - SteadyTime::TimeZero();
+   return elapsed.count() / (uint64_t(NS_TO_MS) * TickMsecs);
+}
+
+//------------------------------------------------------------------------------
+
 void TimerRegistry::Display(ostream& stream,
    const string& prefix, const Flags& options) const
 {
    Dynamic::Display(stream, prefix, options);
 
-   stream << prefix << "nextQid : " << nextQid_ << CRLF;
-   stream << prefix << "corrupt : " << corrupt_ << CRLF;
+   stream << prefix << "nextTick  : " << nextTick_ << CRLF;
+   stream << prefix << "wakeTick  : " << wakeTick_ << CRLF;
+   stream << prefix << "servicing : " << servicing_ << CRLF;
+   stream << prefix << "corrupt   : " << corrupt_ << CRLF;
 
    auto lead = prefix + spaces(2);
 
    stream << prefix << "timerq [Timer::QId] (first entry only)" << CRLF;
 
-   for(auto i = nextQid_; i <= Timer::MaxQId; ++i)
+   auto found = false;
+
+   for(auto i = 0; i <= OverflowQId; ++i)
    {
       auto t = timerq_[i].First();
 
       if(t != nullptr)
       {
          stream << lead << strIndex(i) << strObj(t->Psm()) << CRLF;
-         return;
+         found = true;
       }
    }
 
-   for(auto i = 0; i < nextQid_; ++i)
+   if(!found && options.test(DispVerbose))
    {
-      auto t = timerq_[i].First();
+      stream << lead << "No timers." << CRLF;
+   }
+}
 
-      if(t != nullptr)
+//------------------------------------------------------------------------------
+
+void TimerRegistry::Insert(Timer& tmr)
+{
+   Debug::ft("TimerRegistry.Insert");
+
+   //  Find the lowest level that covers the timer's expiry.  Its slot
+   //  will be reached (and cascaded) on or before that tick.
+   //
+   auto delta = tmr.expiry_ - nextTick_;
+   auto qid = OverflowQId;
+
+   for(size_t i = 0; i < Levels; ++i)
+   {
+      if(delta < Ticks[i] * Slots[i])
       {
-         stream << lead << strIndex(i) << strObj(t->Psm()) << CRLF;
-         return;
+         qid = FirstQId[i] + ((tmr.expiry_ / Ticks[i]) % Slots[i]);
+         break;
       }
    }
 
-   if(options.test(DispVerbose)) stream << lead << "No timers." << CRLF;
+   tmr.qid_ = qid;
+   timerq_[qid].Enq(tmr);
+
+   //  If the timer thread is sleeping past this timer's expiry, wake it.
+   //
+   if(tmr.expiry_ < wakeTick_)
+   {
+      wakeTick_ = tmr.expiry_;
+      auto thr = Singleton<TimerThread>::Extant();
+      if(thr != nullptr) thr->Interrupt(Thread::WorkAvailable);
+   }
 }
 
 //------------------------------------------------------------------------------
@@ -172,28 +221,77 @@ void TimerRegistry::ProcessWork()
 {
    Debug::ft("TimerRegistry.ProcessWork");
 
-   //  Service the next timer queue.
+   //  If a timer trapped while the previous tick was being serviced,
+   //  finish servicing that tick.
    //
-   auto tq = &timerq_[nextQid_];
+   if(servicing_) ServiceTick(nextTick_ - 1);
+
+   auto pool = Singleton<TimerPool>::Instance();
+
+   auto last = CurrTick();
 
-   for(auto t = tq->First(); t != nullptr; t = tq->First())
+   while(nextTick_ <= last)
    {
-      SendTimeout(t);
+      //  When a level wraps, cascade the next slot in the level above it.
+      //  When the last level wraps, cascade the overflow queue.
+      //
+      auto tick = nextTick_;
+      size_t count = 0;
+      size_t i = 1;
+
+      while((i < Levels) && ((tick % Ticks[i]) == 0))
+      {
+         count += Cascade(FirstQId[i] + ((tick / Ticks[i]) % Slots[i]));
+         ++i;
+      }
+
+      if((i == Levels) && ((tick % (Ticks[i - 1] * Slots[i - 1])) == 0))
+      {
+         count += Cascade(OverflowQId);
+      }
+
+      //  Advance nextTick_ before servicing the tick so that a repetitive
+      //  timer is restarted relative to the following tick.
+      //
+      ++nextTick_;
+      ServiceTick(tick);
+      pool->RecordTick(count);
+      ThisThread::PauseOver(90);
    }
+}
 
-   //  Advance to the next queue.
+//------------------------------------------------------------------------------
+
+void TimerRegistry::Register(Timer& tmr)
+{
+   Debug::ft("TimerRegistry.Register");
+
+   //  The timer expires at the first tick that begins at least msecs_
+   //  from now.
    //
-   if(++nextQid_ >= Timer::MaxQId) nextQid_ = 0;
+   uint64_t tickNsecs = uint64_t(NS_TO_MS) * TickMsecs;
+   nsecs_t elapsed = SteadyTime::Now() - SteadyTime::TimeZero();
+   uint64_t nsecs = elapsed.count() + (uint64_t(tmr.msecs_) * NS_TO_MS);
+
+   tmr.expiry_ = (nsecs + tickNsecs - 1) / tickNsecs;
+   if(tmr.expiry_ < nextTick_) tmr.expiry_ = nextTick_;
+   Insert(tmr);
+}
 
-   //  Service the queue of long timers.
+//------------------------------------------------------------------------------
+
+void TimerRegistry::Reregister(Timer& tmr)
+{
+   Debug::ft("TimerRegistry.Reregister");
+
+   //  Schedule the timer relative to when it last expired, so that it
+   //  doesn't drift, but run it at least one tick later.
    //
-   tq = &timerq_[Timer::MaxQId];
+   uint64_t ticks = (tmr.msecs_ + TickMsecs - 1) / TickMsecs;
 
-   for(Timer* curr = tq->First(), *next; curr != nullptr; curr = next)
-   {
-      next = tq->Next(*curr);
-      if(--curr->remaining_ <= 0) SendTimeout(curr);
-   }
+   tmr.expiry_ += (ticks == 0 ? 1 : ticks);
+   if(tmr.expiry_ < nextTick_) tmr.expiry_ = nextTick_;
+   Insert(tmr);
 }
 
 //------------------------------------------------------------------------------
@@ -218,4 +316,61 @@ void TimerRegistry::SendTimeout(Timer* tmr)
 
    currTimer_ = nullptr;
 }
+
+//------------------------------------------------------------------------------
+
+void TimerRegistry::ServiceTick(uint64_t tick)
+{
+   Debug::ft("TimerRegistry.ServiceTick");
+
+   //  The queue can also contain a repetitive timer that was restarted
+   //  while servicing this tick, so only send timeouts for timers that
+   //  have expired.
+   //
+   auto tq = &timerq_[FirstQId[0] + (tick % Slots[0])];
+   if(tq->Empty()) return;
+
+   auto pool = Singleton<TimerPool>::Instance();
+   uint64_t tickNsecs = uint64_t(NS_TO_MS) * TickMsecs;
+   nsecs_t now = SteadyTime::Now() - SteadyTime::TimeZero();
+
+   servicing_ = true;
+
+   for(Timer* curr = tq->First(), *next; curr != nullptr; curr = next)
+   {
+      next = tq->Next(*curr);
+
+      if(curr->expiry_ <= tick)
+      {
+         pool->RecordLateness(now - nsecs_t(curr->expiry_ * tickNsecs));
+         SendTimeout(curr);
+      }
+   }
+
+   servicing_ = false;
+}
+
+//------------------------------------------------------------------------------
+
+msecs_t TimerRegistry::TimeToNextWork()
+{
+   Debug::ft("TimerRegistry.TimeToNextWork");
+
+   //  Find the next tick whose level 0 slot contains a timer, stopping
+   //  at the next tick where level 0 wraps and must cascade.
+   //
+   auto tick = nextTick_;
+
+   while(((tick % Slots[0]) != 0) && timerq_[tick % Slots[0]].Empty())
+   {
+      ++tick;
+   }
+
+   wakeTick_ = tick;
+
+   nsecs_t due(tick * uint64_t(NS_TO_MS) * TickMsecs);
+   nsecs_t wait = due - (SteadyTime::Now() - SteadyTime::TimeZero());
+   if(wait.count() <= 0) return TIMEOUT_IMMED;
+   return msecs_t((wait.count() + NS_TO_MS - 1) / NS_TO_MS);
+}
 }
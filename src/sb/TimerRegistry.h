@@ -23,7 +23,9 @@
 #define TIMERREGISTRY_H_INCLUDED
 
 #include "Dynamic.h"
+#include <cstddef>
 #include <cstdint>
+#include "Duration.h"
 #include "NbTypes.h"
 #include "Q2Way.h"
 #include "SbTypes.h"
@@ -33,7 +35,15 @@
 
 namespace SessionBase
 {
-//  Global registry for timers.
+//  Global registry for timers, implemented as a hierarchical timewheel.  The
+//  wheel advances in ticks of TickMsecs.  Its first level has a slot for each
+//  tick in the next second, its second level a slot for each second in the
+//  next minute, its third level a slot for each minute in the next hour, and
+//  its fourth level a slot for each hour in the next day.  Timers that expire
+//  after more than a day reside in an overflow queue.  When a level wraps, the
+//  next slot in the level above it is cascaded: its timers move down to the
+//  level that now covers their expiry.  Each timer is therefore only touched
+//  a few times before it expires, regardless of its duration.
 //
 class TimerRegistry : public NodeBase::Dynamic
 {
@@ -52,6 +62,16 @@ public:
    //
    void ProcessWork();
 
+   //  Returns the time until the next tick at which ProcessWork has work
+   //  to do.  The timer thread is interrupted if a timer is added that
+   //  expires before then.
+   //
+   NodeBase::msecs_t TimeToNextWork();
+
+   //  The duration of one timewheel tick.
+   //
+   static const uint32_t TickMsecs = 10;
+
    //  Overridden to traverse all timer queues in the registry.
    //
    void ClaimBlocks() override;
@@ -73,23 +93,71 @@ private:
    //
    ~TimerRegistry();
 
-   //  Determines the queue where a timer that will expire in SECS
-   //  should be placed.
+   //  Adds TMR, which has just been created, to the timewheel.
+   //
+   void Register(Timer& tmr);
+
+   //  Adds TMR, which is repetitive and has just expired, to the timewheel.
+   //
+   void Reregister(Timer& tmr);
+
+   //  Adds TMR to the queue that will be reached at its expiry_ tick.
+   //
+   void Insert(Timer& tmr);
+
+   //  Moves the timers in QID to the queues that now cover their expiry
+   //  ticks.  Returns the number of timers moved.
+   //
+   size_t Cascade(Timer::QId qid);
+
+   //  Invokes SendTimeout on each timer in the level 0 queue for TICK.
+   //
+   void ServiceTick(uint64_t tick);
+
+   //  Returns the tick that has most recently begun.
    //
-   Timer::QId CalcQId(uint32_t secs) const;
+   static uint64_t CurrTick();
 
    //  Sends a timeout on behalf of TMR.
    //
    void SendTimeout(Timer* tmr);
 
-   //  timerq_[s] contains timers expiring in (s - nextQid_) seconds; the
-   //  last queue is for timers of Timer::MaxQId seconds or more.
+   //  The number of levels in the timewheel.
+   //
+   static const size_t Levels = 4;
+
+   //  The number of slots in each level.
+   //
+   static const Timer::QId Slots[Levels];
+
+   //  The number of ticks covered by a slot in each level.
+   //
+   static const uint64_t Ticks[Levels];
+
+   //  The index of the first slot of each level in timerq_.
+   //
+   static const Timer::QId FirstQId[Levels];
+
+   //  The queue for timers that expire after the last level wraps.
+   //
+   static const Timer::QId OverflowQId = 100 + 60 + 60 + 24;
+
+   //  The timewheel's slots (see FirstQId), followed by its overflow queue.
+   //
+   NodeBase::Q2Way<Timer> timerq_[OverflowQId + 1];
+
+   //  The next tick to be serviced.
+   //
+   uint64_t nextTick_;
+
+   //  The tick at which the timer thread will next run.  A timer that
+   //  expires before this tick interrupts the timer thread.
    //
-   NodeBase::Q2Way<Timer> timerq_[Timer::MaxQId + 1];
+   uint64_t wakeTick_;
 
-   //  The timer queue that will be serviced next.
+   //  Set while a tick's timers are being serviced.
    //
-   Timer::QId nextQid_;
+   bool servicing_;
 
    //  The timer currently being processed.  If this timer is encountered
    //  again, it must have previously caused a trap, so it is deleted.
@@ -20,9 +20,7 @@
 //  along with RSC.  If not, see <http://www.gnu.org/licenses/>.
 //
 #include "TimerThread.h"
-#include <ratio>
 #include "Debug.h"
-#include "Duration.h"
 #include "SbDaemons.h"
 #include "SbTracer.h"
 #include "Singleton.h"
@@ -92,20 +90,15 @@ void TimerThread::Enter()
 {
    Debug::ft("TimerThread.Enter");
 
-   //  Every second, tell our registry to process the next timer queue.
+   //  Tell our registry to service the timewheel, and then sleep until
+   //  it next has work to do.
    //
    auto reg = Singleton<TimerRegistry>::Instance();
-   msecs_t sleep(ONE_SEC);
 
    while(true)
    {
-      Pause(sleep);
       reg->ProcessWork();
-
-      //  Sleep for one second, minus the amount of time that we just ran.
-      //
-      auto runTime = CurrTimeRunning();
-      sleep = (runTime > ONE_SEC ? TIMEOUT_IMMED : ONE_SEC - runTime);
+      Pause(reg->TimeToNextWork());
    }
 }
 
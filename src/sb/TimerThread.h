@@ -60,8 +60,8 @@ private:
    //
    void Destroy() override;
 
-   //  Overridden to enter a loop that tells the timer registry, once per
-   //  second, to send timeout messages on behalf of expired timers.
+   //  Overridden to enter a loop that tells the timer registry to send
+   //  timeout messages on behalf of expired timers.
    //
    void Enter() override;
 };
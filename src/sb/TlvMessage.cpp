@@ -32,7 +32,10 @@ using namespace NodeBase;
 
 namespace SessionBase
 {
-TlvMessage::TlvMessage(SbIpBufferPtr& buff) : Message(buff)
+TlvMessage::TlvMessage(SbIpBufferPtr& buff) :
+   Message(buff),
+   indexLength_(0),
+   indexValid_(false)
 {
    Debug::ft("TlvMessage.ctor(i/c)");
 }
@@ -40,7 +43,9 @@ TlvMessage::TlvMessage(SbIpBufferPtr& buff) : Message(buff)
 //------------------------------------------------------------------------------
 
 TlvMessage::TlvMessage(ProtocolSM* psm, size_t size) :
-   Message(psm, Pad(size) + FenceSize)
+   Message(psm, Pad(size) + FenceSize),
+   indexLength_(0),
+   indexValid_(false)
 {
    Debug::ft("TlvMessage.ctor(o/g)");
 
@@ -52,7 +57,9 @@ TlvMessage::TlvMessage(ProtocolSM* psm, size_t size) :
 //------------------------------------------------------------------------------
 
 TlvMessage::TlvMessage(const TlvParm& parm, ProtocolSM* psm) :
-   Message(psm, parm.header.plen)
+   Message(psm, parm.header.plen),
+   indexLength_(0),
+   indexValid_(false)
 {
    Debug::ft("TlvMessage.ctor(unwrap)");
 
@@ -75,7 +82,9 @@ TlvMessage::TlvMessage(const TlvParm& parm, ProtocolSM* psm) :
 //------------------------------------------------------------------------------
 
 TlvMessage::TlvMessage(const Message& msg, ProtocolSM* psm) :
-   Message(psm, msg.Header()->length + FenceSize)
+   Message(psm, msg.Header()->length + FenceSize),
+   indexLength_(0),
+   indexValid_(false)
 {
    Debug::ft("TlvMessage.ctor(copy)");
 
@@ -168,6 +177,7 @@ TlvParm* TlvMessage::AddParm(ParameterId pid, size_t plen)
    pptr->header.plen = plen;
    layout->header.length += sizeof(TlvParmHeader) + Pad(plen);
    *FencePtr() = ParmFencePattern;
+   InvalidateIndex();
    return pptr;
 }
 
@@ -237,6 +247,7 @@ void TlvMessage::DeleteParm(TlvParm& parm)
    Debug::ft("TlvMessage.DeleteParm");
 
    parm.header.pid = NIL_ID;
+   InvalidateIndex();
 }
 
 //------------------------------------------------------------------------------
@@ -274,14 +285,32 @@ TlvParm* TlvMessage::FindParm(ParameterId pid) const
 {
    Debug::ft("TlvMessage.FindParm");
 
+   auto pindex = FindParmOffset(pid);
+   if(pindex == SIZE_MAX) return nullptr;
+   return (TlvParm*) &TlvLayout()->bytes[pindex];
+}
+
+//------------------------------------------------------------------------------
+
+size_t TlvMessage::FindParmOffset(ParameterId pid) const
+{
+   Debug::ft("TlvMessage.FindParmOffset");
+
+   if(pid <= MaxIndexedId)
+   {
+      IndexParms();
+      auto pindex = parmIndex_[pid];
+      return (pindex == NilParmOffset ? SIZE_MAX : pindex);
+   }
+
    ParmIterator pit;
 
    for(auto pptr = FirstParm(pit); pptr != nullptr; pptr = NextParm(pit))
    {
-      if(pptr->header.pid == pid) return pptr;
+      if(pptr->header.pid == pid) return pit.pindex;
    }
 
-   return nullptr;
+   return SIZE_MAX;
 }
 
 //------------------------------------------------------------------------------
@@ -291,15 +320,21 @@ size_t TlvMessage::FindParms
 {
    Debug::ft("TlvMessage.FindParms");
 
+   //  Start at the first parameter that matches PID.
+   //
+   auto pindex = FindParmOffset(pid);
+   if(pindex == SIZE_MAX) return 0;
+
    size_t count = 0;
    ParmIterator pit;
+   pit.mptr = TlvLayout();
+   pit.pindex = pindex;
+   pit.pptr = (TlvParm*) &pit.mptr->bytes[pindex];
 
-   for(auto pptr = FirstParm(pit); pptr != nullptr; pptr = NextParm(pit))
+   for(auto pptr = pit.pptr;
+      (pptr != nullptr) && (count < size); pptr = NextParm(pit))
    {
-      if((pptr->header.pid == pid) && (count < size))
-      {
-         ptab[count++] = pptr;
-      }
+      if(pptr->header.pid == pid) ptab[count++] = pptr;
    }
 
    return count;
@@ -329,6 +364,39 @@ TlvParm* TlvMessage::FirstParm(ParmIterator& pit) const
 
 //------------------------------------------------------------------------------
 
+void TlvMessage::IndexParms() const
+{
+   Debug::ft("TlvMessage.IndexParms");
+
+   //  The index is rebuilt if a parameter was added or deleted, or if the
+   //  message's length changed without using AddParm.
+   //
+   auto length = TlvLayout()->header.length;
+   if(indexValid_ && (indexLength_ == length)) return;
+
+   for(size_t i = 0; i <= MaxIndexedId; ++i)
+   {
+      parmIndex_[i] = NilParmOffset;
+   }
+
+   ParmIterator pit;
+
+   for(auto pptr = FirstParm(pit); pptr != nullptr; pptr = NextParm(pit))
+   {
+      auto pid = pptr->header.pid;
+
+      if((pid <= MaxIndexedId) && (parmIndex_[pid] == NilParmOffset))
+      {
+         parmIndex_[pid] = pit.pindex;
+      }
+   }
+
+   indexLength_ = length;
+   indexValid_ = true;
+}
+
+//------------------------------------------------------------------------------
+
 Message::InspectRc TlvMessage::InspectMsg(debug64_t& errval) const
 {
    Debug::ft("TlvMessage.InspectMsg");
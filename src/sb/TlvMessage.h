@@ -317,6 +317,45 @@ private:
    //  Overridden to change the message's direction.
    //
    void ChangeDir(NodeBase::MsgDirection nextDir) override;
+
+   //  Ensures that parmIndex_ is current.
+   //
+   void IndexParms() const;
+
+   //  Returns the offset of the first parameter that matches PID, using
+   //  parmIndex_ if possible.  Returns SIZE_MAX if there is no such
+   //  parameter.
+   //
+   size_t FindParmOffset(ParameterId pid) const;
+
+   //  Marks parmIndex_ as stale after a parameter is added or deleted.
+   //
+   void InvalidateIndex() const { indexValid_ = false; }
+
+   //  The highest parameter identifier that parmIndex_ covers.  This is
+   //  the same as Parameter::MaxId, which is not a compile-time constant.
+   //  A parameter with a larger identifier is found by scanning.
+   //
+   static const ParameterId MaxIndexedId = 63;
+
+   //  The value in parmIndex_ for a parameter that is not in the message.
+   //
+   static const uint16_t NilParmOffset = UINT16_MAX;
+
+   //  Maps each parameter identifier directly to the offset of the first
+   //  parameter with that identifier, or to NilParmOffset.  Built when a
+   //  parameter is first looked up.
+   //
+   mutable uint16_t parmIndex_[MaxIndexedId + 1];
+
+   //  The message's length when parmIndex_ was built.  If it has changed,
+   //  the index is rebuilt.
+   //
+   mutable uint16_t indexLength_;
+
+   //  Set if parmIndex_ is current.
+   //
+   mutable bool indexValid_;
 };
 }
 #endif
@@ -58,7 +58,7 @@ SnModule::SnModule() : Module("sn")
 
    //  Create the modules required by ServiceNode.
    //
-   Singleton<PbModule>::Instance();
+   Requires(*Singleton<PbModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
@@ -43,8 +43,8 @@ StModule::StModule() : Module()
 
    //  Create the modules required by SessionTools.
    //
-   Singleton<SbModule>::Instance();
-   Singleton<NtModule>::Instance();
+   Requires(*Singleton<SbModule>::Instance());
+   Requires(*Singleton<NtModule>::Instance());
    Singleton<ModuleRegistry>::Instance()->BindModule(*this);
 }
 
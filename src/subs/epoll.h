@@ -0,0 +1,44 @@
+//==============================================================================
+//
+//  epoll.h
+//
+#ifdef OS_LINUX
+#ifndef EPOLL_H_INCLUDED
+#define EPOLL_H_INCLUDED
+
+#include "cstdint"
+
+struct epoll_data
+{
+   void* ptr;
+   int fd;
+   uint32_t u32;
+   uint64_t u64;
+};
+
+typedef epoll_data epoll_data_t;
+
+struct epoll_event
+{
+   uint32_t events;
+   epoll_data_t data;
+};
+
+constexpr uint32_t EPOLLIN = 0x001;
+constexpr uint32_t EPOLLPRI = 0x002;
+constexpr uint32_t EPOLLOUT = 0x004;
+constexpr uint32_t EPOLLERR = 0x008;
+constexpr uint32_t EPOLLHUP = 0x010;
+
+constexpr int EPOLL_CLOEXEC = 02000000;
+
+constexpr int EPOLL_CTL_ADD = 1;
+constexpr int EPOLL_CTL_DEL = 2;
+constexpr int EPOLL_CTL_MOD = 3;
+
+int epoll_create1(int flags);
+int epoll_ctl(int epfd, int op, int fd, epoll_event* event);
+int epoll_wait(int epfd, epoll_event* events, int maxevents, int timeout);
+
+#endif
+#endif
@@ -9,6 +9,7 @@
 extern int errno;
 
 constexpr int EPERM = 1;
+constexpr int ENOENT = 2;
 constexpr int EINTR = 4;
 constexpr int EWOULDBLOCK = 11;
 constexpr int EACCES = 13;
@@ -13,6 +13,7 @@ typedef unsigned int socklen_t;
 typedef long ssize_t;
 
 constexpr uint16_t AF_UNSPEC = 0;
+constexpr uint16_t AF_UNIX = 1;
 constexpr uint16_t AF_INET = 2;
 constexpr uint16_t AF_INET6 = 10;
 constexpr int      SOCK_STREAM = 1;
@@ -43,6 +44,28 @@ constexpr int SHUT_RDWR = 2;
 
 constexpr int SOMAXCONN = 4096;
 
+constexpr int MSG_WAITFORONE = 0x10000;
+
+struct iovec;
+struct timespec;
+
+struct msghdr
+{
+   void* msg_name;
+   socklen_t msg_namelen;
+   iovec* msg_iov;
+   size_t msg_iovlen;
+   void* msg_control;
+   size_t msg_controllen;
+   int msg_flags;
+};
+
+struct mmsghdr
+{
+   msghdr msg_hdr;
+   unsigned int msg_len;
+};
+
 int socket(int domain, int type, int protocol);
 int getsockname(int fd, sockaddr* addr, socklen_t* len);
 int getpeername(int fd, sockaddr* addr, socklen_t* len);
@@ -57,6 +80,9 @@ ssize_t send(int fd, const void* buf, size_t n, int flags);
 ssize_t recvfrom(int fd, void* buf, size_t n, int flags, sockaddr* addr, socklen_t* addr_len);
 ssize_t sendto(int fd, const void* buf, size_t n, int flags, const sockaddr* addr, socklen_t addr_len);
 int shutdown(int fd, int how);
+int socketpair(int domain, int type, int protocol, int* fds);
+int recvmmsg(int fd, mmsghdr* vmessages, unsigned int vlen, int flags, timespec* tmo);
+int sendmmsg(int fd, mmsghdr* vmessages, unsigned int vlen, int flags);
 
 #endif
 #endif
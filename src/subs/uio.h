@@ -0,0 +1,18 @@
+//==============================================================================
+//
+//  uio.h
+//
+#ifdef OS_LINUX
+#ifndef UIO_H_INCLUDED
+#define UIO_H_INCLUDED
+
+#include "cstddef"
+
+struct iovec
+{
+   void* iov_base;
+   size_t iov_len;
+};
+
+#endif
+#endif
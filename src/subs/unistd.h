@@ -8,8 +8,11 @@
 
 #include "cstddef"
 
+constexpr int _SC_PAGESIZE = 30;
+
 int gethostname(char* name, size_t len);
 int close(int fd);
+long sysconf(int name);
 
 #endif
 #endif
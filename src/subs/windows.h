@@ -72,6 +72,13 @@ bool VirtualLock(void* addr, SIZE_T size);
 bool VirtualUnlock(void* addr, SIZE_T size);
 bool VirtualProtect(void* addr, SIZE_T size, DWORD newProt, DWORD* oldProt);
 
+struct SYSTEM_INFO
+{
+   DWORD dwPageSize;
+};
+
+void GetSystemInfo(SYSTEM_INFO* info);
+
 //------------------------------------------------------------------------------
 //
 //  Windows heaps